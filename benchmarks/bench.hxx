@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+// Prevents the optimizer from discarding a value that is computed but otherwise unused.
+template <typename T>
+inline void do_not_optimize(T const& value) {
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*)) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    } else {
+        asm volatile("" : : "m"(value) : "memory");
+    }
+}
+
+// Forces pending writes to memory to be treated as observable.
+inline void clobber() { asm volatile("" : : : "memory"); }
+
+// Calls to operator new, counted by the replacement in bench_assignment.cpp
+inline std::atomic<std::size_t> allocations{0};
+
+class State {
+public:
+    explicit State(std::size_t iterations) : iterations_(iterations) {}
+
+    [[nodiscard]] std::size_t iterations() const { return iterations_; }
+
+    // Reports an additional per run counter, e.g. allocations, alongside the timing.
+    void counter(std::string name, double value) { counters_.emplace_back(std::move(name), value); }
+
+    [[nodiscard]] const std::vector<std::pair<std::string, double>>& counters() const { return counters_; }
+
+private:
+    std::size_t iterations_;
+    std::vector<std::pair<std::string, double>> counters_;
+};
+
+using BenchFunc = std::function<void(State&)>;
+
+struct Case {
+    std::string group;
+    std::string name;
+    BenchFunc func;
+};
+
+struct Measurement {
+    std::string group;
+    std::string name;
+    std::size_t iterations;
+    double ns_per_op;
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+class Registry {
+public:
+    static Registry& instance() {
+        static Registry registry{};
+        return registry;
+    }
+
+    void add(std::string group, std::string name, BenchFunc func) {
+        cases_.push_back(Case{std::move(group), std::move(name), std::move(func)});
+    }
+
+    [[nodiscard]] const std::vector<Case>& cases() const { return cases_; }
+
+private:
+    std::vector<Case> cases_;
+};
+
+// Registers a benchmark at static initialization time:
+// static bench::Registrar reg{"group", "name", [](bench::State& state) { ... }};
+struct Registrar {
+    Registrar(std::string group, std::string name, BenchFunc func) {
+        Registry::instance().add(std::move(group), std::move(name), std::move(func));
+    }
+};
+
+struct RunOptions {
+    std::chrono::nanoseconds min_time = std::chrono::milliseconds(20);
+    std::size_t repetitions           = 5;
+};
+
+// Doubles the iteration count until a single run takes at least min_time and reports the fastest of the
+// repetitions.
+inline Measurement run(const Case& c, const RunOptions& opts) {
+    using clock = std::chrono::steady_clock;
+
+    std::size_t iterations = 1;
+    clock::duration elapsed{};
+    std::vector<std::pair<std::string, double>> counters;
+
+    for (;;) {
+        State state{iterations};
+        const auto start = clock::now();
+        c.func(state);
+        elapsed = clock::now() - start;
+
+        if (elapsed >= opts.min_time || iterations >= (std::size_t{1} << 40)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    auto best = elapsed;
+    for (std::size_t rep = 0; rep < opts.repetitions; ++rep) {
+        State state{iterations};
+        const auto start = clock::now();
+        c.func(state);
+        best     = std::min(best, clock::now() - start);
+        counters = state.counters();
+    }
+
+    const auto ns = std::chrono::duration<double, std::nano>(best).count();
+    return Measurement{c.group, c.name, iterations, ns / static_cast<double>(iterations), std::move(counters)};
+}
+
+inline void print_json(std::ostream& os, const std::vector<Measurement>& results) {
+    os << "[\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& m = results[i];
+        os << "  {\"group\": \"" << m.group << "\", \"name\": \"" << m.name << "\", \"iterations\": " << m.iterations
+           << ", \"ns_per_op\": " << m.ns_per_op;
+        for (const auto& [key, value] : m.counters) {
+            os << ", \"" << key << "\": " << value;
+        }
+        os << "}" << (i + 1 == results.size() ? "\n" : ",\n");
+    }
+    os << "]" << std::endl;
+}
+
+inline void print_csv(std::ostream& os, const std::vector<Measurement>& results) {
+    os << "group,name,iterations,ns_per_op,counters" << std::endl;
+    for (const auto& m : results) {
+        os << m.group << "," << m.name << "," << m.iterations << "," << m.ns_per_op << ",";
+        for (std::size_t i = 0; i < m.counters.size(); ++i) {
+            os << (i == 0 ? "" : ";") << m.counters[i].first << "=" << m.counters[i].second;
+        }
+        os << std::endl;
+    }
+}
+
+}  // namespace bench
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include <cstddef>
+#include <cstdint>
+#include <utils/algorithm.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+#include "bench.hxx"
+
+// Validating a batch of samples with try_transform, and splitting a batch of Results with partition, sequentially and
+// with par. The parallel try_transform also shows how much of the batch is skipped once an early error is known.
+
+namespace {
+
+using namespace cogle::utils::result;
+namespace algorithm = cogle::utils::algorithm;
+
+struct Invalid {
+    std::size_t sample;
+    int code;
+};
+
+constexpr std::size_t SAMPLES = 1 << 20;
+
+// A few dozen cycles of work per sample, rejects the ones marked bad
+Result<std::uint64_t, Invalid> validate(const std::uint64_t sample) {
+    std::uint64_t hash = sample;
+    for (int round = 0; round < 16; ++round) {
+        hash = (hash ^ (hash >> 29)) * 0xbf58476d1ce4e5b9ULL;
+    }
+    UNLIKELY_IF(sample == ~std::uint64_t{0}) { return Result<std::uint64_t, Invalid>{in_place_err, Invalid{0, 1}}; }
+    return Result<std::uint64_t, Invalid>{in_place_ok, hash};
+}
+
+std::vector<std::uint64_t> make_samples(const std::size_t bad) {
+    std::vector<std::uint64_t> samples(SAMPLES);
+    for (std::size_t i = 0; i < SAMPLES; ++i) {
+        samples[i] = i == bad ? ~std::uint64_t{0} : i;
+    }
+    return samples;
+}
+
+std::vector<Result<std::uint64_t, Invalid>> make_results() {
+    std::vector<Result<std::uint64_t, Invalid>> results;
+    results.reserve(SAMPLES);
+    for (std::size_t i = 0; i < SAMPLES; ++i) {
+        if (i % 100 == 42) {
+            results.emplace_back(in_place_err, Invalid{i, 2});
+        } else {
+            results.emplace_back(in_place_ok, i);
+        }
+    }
+    return results;
+}
+
+template <typename... Policy>
+void transform_all(bench::State& state, const Policy&... policy) {
+    const auto samples = make_samples(SAMPLES);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        bench::do_not_optimize(algorithm::try_transform(policy..., samples, validate));
+    }
+}
+
+// The only bad sample is at a tenth of the batch
+template <typename... Policy>
+void transform_early_error(bench::State& state, const Policy&... policy) {
+    const auto samples = make_samples(SAMPLES / 10);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        bench::do_not_optimize(algorithm::try_transform(policy..., samples, validate));
+    }
+}
+
+template <typename... Policy>
+void partition(bench::State& state, const Policy&... policy) {
+    const auto results = make_results();
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        bench::do_not_optimize(algorithm::partition(policy..., results));
+    }
+}
+
+[[maybe_unused]] const bool registered = [] {
+    auto& registry = bench::Registry::instance();
+
+    registry.add("algorithm/try_transform", "sequential", [](bench::State& s) { transform_all(s); });
+    registry.add("algorithm/try_transform", "par", [](bench::State& s) { transform_all(s, algorithm::par); });
+    registry.add("algorithm/try_transform_early_error", "sequential",
+                 [](bench::State& s) { transform_early_error(s); });
+    registry.add("algorithm/try_transform_early_error", "par",
+                 [](bench::State& s) { transform_early_error(s, algorithm::par); });
+    registry.add("algorithm/partition", "sequential", [](bench::State& s) { partition(s); });
+    registry.add("algorithm/partition", "par", [](bench::State& s) { partition(s, algorithm::par); });
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
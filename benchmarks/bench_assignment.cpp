@@ -0,0 +1,115 @@
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utils/result.hxx>
+#include <vector>
+
+#include "bench.hxx"
+
+// Allocations caused by reusing a Result across loop iterations. assign copies into a Result that already holds the
+// same alternative and can reuse its buffer, destroy_construct is what assignment used to do: destroy the held value
+// and copy construct the new one in place.
+
+void* operator new(std::size_t size) {
+    bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+using namespace cogle::utils::result;
+
+template <typename R, typename E>
+struct Sources {
+    static std::vector<Result<R, E>> make();
+};
+
+template <>
+struct Sources<std::vector<int>, int> {
+    static std::vector<Result<std::vector<int>, int>> make() {
+        std::vector<Result<std::vector<int>, int>> sources;
+        for (std::size_t i = 1; i <= 8; ++i) {
+            sources.emplace_back(Ok<std::vector<int>>{std::vector<int>(i * 16, static_cast<int>(i))});
+        }
+        return sources;
+    }
+};
+
+template <>
+struct Sources<std::string, int> {
+    static std::vector<Result<std::string, int>> make() {
+        std::vector<Result<std::string, int>> sources;
+        for (std::size_t i = 1; i <= 8; ++i) {
+            sources.emplace_back(Ok<std::string>{std::string(i * 16, 'a')});
+        }
+        return sources;
+    }
+};
+
+template <>
+struct Sources<int, std::string> {
+    static std::vector<Result<int, std::string>> make() {
+        std::vector<Result<int, std::string>> sources;
+        for (std::size_t i = 1; i <= 8; ++i) {
+            sources.emplace_back(Err<std::string>{std::string(i * 16, 'e')});
+        }
+        return sources;
+    }
+};
+
+void report(bench::State& state, const std::size_t before) {
+    const auto count = bench::allocations.load(std::memory_order_relaxed) - before;
+    state.counter("allocs_per_op", static_cast<double>(count) / static_cast<double>(state.iterations()));
+}
+
+template <typename R, typename E>
+void assign(bench::State& state) {
+    const auto sources = Sources<R, E>::make();
+    Result<R, E> dst{sources.back()};
+
+    const auto before = bench::allocations.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        dst = sources[i % sources.size()];
+        bench::do_not_optimize(dst);
+    }
+    report(state, before);
+}
+
+template <typename R, typename E>
+void destroy_construct(bench::State& state) {
+    const auto sources = Sources<R, E>::make();
+    Result<R, E> dst{sources.back()};
+
+    const auto before = bench::allocations.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        dst.~Result<R, E>();
+        new (&dst) Result<R, E>(sources[i % sources.size()]);
+        bench::do_not_optimize(dst);
+    }
+    report(state, before);
+}
+
+template <typename R, typename E>
+void register_assignment(const std::string& group) {
+    auto& registry = bench::Registry::instance();
+
+    registry.add(group, "assign", assign<R, E>);
+    registry.add(group, "destroy_construct", destroy_construct<R, E>);
+}
+
+[[maybe_unused]] const bool registered = [] {
+    register_assignment<std::vector<int>, int>("assignment/ok<vector<int>,int>");
+    register_assignment<std::string, int>("assignment/ok<string,int>");
+    register_assignment<int, std::string>("assignment/err<int,string>");
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
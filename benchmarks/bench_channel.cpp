@@ -0,0 +1,179 @@
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utils/channel.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+#include "bench.hxx"
+
+// Passing Results from producer to consumer threads, measured per message: a Channel sending and receiving one message
+// at a time and in batches of 64, against a deque guarded by a mutex and condition variables, bounded alike.
+
+namespace {
+
+using namespace cogle::utils::result;
+using namespace cogle::utils::channel;
+
+struct Invalid {
+    std::uint64_t value;
+};
+
+using Message = Result<std::uint64_t, Invalid>;
+
+constexpr std::size_t CAPACITY = 1024;
+constexpr std::size_t BATCH    = 64;
+
+Message make(const std::uint64_t value) {
+    UNLIKELY_IF(value % 1000 == 999) { return Message{in_place_err, Invalid{value}}; }
+    return Message{in_place_ok, value};
+}
+
+class LockedQueue {
+public:
+    void push(Message message) {
+        std::unique_lock<std::mutex> lock{mutex_};
+        not_full_.wait(lock, [this] { return messages_.size() < CAPACITY; });
+        messages_.push_back(std::move(message));
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+    // False once closed and empty
+    bool pop(Message& message) {
+        std::unique_lock<std::mutex> lock{mutex_};
+        not_empty_.wait(lock, [this] { return !messages_.empty() || closed_; });
+        if (messages_.empty()) {
+            return false;
+        }
+        message = std::move(messages_.front());
+        messages_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            closed_ = true;
+        }
+        not_empty_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<Message> messages_;
+    bool closed_ = false;
+};
+
+// Runs producers sending state.iterations() messages in total and consumers summing them
+template <typename Produce, typename Consume, typename Close>
+void run(bench::State& state, const int threads, const Produce& produce, const Consume& consume, const Close& close) {
+    const std::size_t per_producer = state.iterations() / static_cast<std::size_t>(threads) + 1;
+    std::vector<std::uint64_t> sums(static_cast<std::size_t>(threads));
+    std::vector<std::thread> consumers;
+    for (auto& sum : sums) {
+        consumers.emplace_back([&consume, &sum] { sum = consume(); });
+    }
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < threads; ++producer) {
+        producers.emplace_back([&produce, per_producer] { produce(per_producer); });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    close();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    bench::do_not_optimize(sums);
+}
+
+void channel_single(bench::State& state, const int threads) {
+    Channel<std::uint64_t, Invalid> channel{CAPACITY};
+    run(
+        state, threads,
+        [&channel](const std::size_t count) {
+            for (std::uint64_t i = 0; i < count; ++i) {
+                static_cast<void>(channel.send(make(i)));
+            }
+        },
+        [&channel] {
+            std::uint64_t sum = 0;
+            for (auto next = channel.recv(); !(next.is_err() && next.error().closed()); next = channel.recv()) {
+                sum += next.unwrap_or(0);
+            }
+            return sum;
+        },
+        [&channel] { channel.close(); });
+}
+
+void channel_batch(bench::State& state, const int threads) {
+    Channel<std::uint64_t, Invalid> channel{CAPACITY};
+    run(
+        state, threads,
+        [&channel](const std::size_t count) {
+            std::vector<Message> batch;
+            batch.reserve(BATCH);
+            for (std::uint64_t i = 0; i < count; ++i) {
+                batch.push_back(make(i));
+                if (batch.size() == BATCH) {
+                    static_cast<void>(channel.send_batch(batch));
+                }
+            }
+            static_cast<void>(channel.send_batch(batch));
+        },
+        [&channel] {
+            std::uint64_t sum = 0;
+            std::vector<Message> batch;
+            batch.reserve(BATCH);
+            while (channel.recv_batch(batch, BATCH).is_ok()) {
+                for (const auto& message : batch) {
+                    sum += message.unwrap_or(0);
+                }
+                batch.clear();
+            }
+            return sum;
+        },
+        [&channel] { channel.close(); });
+}
+
+void locked(bench::State& state, const int threads) {
+    LockedQueue queue;
+    run(
+        state, threads,
+        [&queue](const std::size_t count) {
+            for (std::uint64_t i = 0; i < count; ++i) {
+                queue.push(make(i));
+            }
+        },
+        [&queue] {
+            std::uint64_t sum = 0;
+            Message message{in_place_ok, 0};
+            while (queue.pop(message)) {
+                sum += message.unwrap_or(0);
+            }
+            return sum;
+        },
+        [&queue] { queue.close(); });
+}
+
+[[maybe_unused]] const bool registered = [] {
+    auto& registry = bench::Registry::instance();
+
+    registry.add("channel/1_to_1", "Channel", [](bench::State& state) { channel_single(state, 1); });
+    registry.add("channel/1_to_1", "Channel batch 64", [](bench::State& state) { channel_batch(state, 1); });
+    registry.add("channel/1_to_1", "mutex deque", [](bench::State& state) { locked(state, 1); });
+    registry.add("channel/4_to_4", "Channel", [](bench::State& state) { channel_single(state, 4); });
+    registry.add("channel/4_to_4", "Channel batch 64", [](bench::State& state) { channel_batch(state, 4); });
+    registry.add("channel/4_to_4", "mutex deque", [](bench::State& state) { locked(state, 4); });
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
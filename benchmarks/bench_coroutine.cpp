@@ -0,0 +1,98 @@
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <utils/coroutine.hxx>
+#include <utils/result.hxx>
+
+#include "bench.hxx"
+
+// Propagating errors through three non-inlined calls by hand written early returns against a coroutine that co_awaits
+// each call, with its frame taken from the heap and from a FrameArena. Each variant fails for error_rate out of every
+// 1000 calls.
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+namespace {
+
+using namespace cogle::utils::result;
+using cogle::utils::coroutine::ArenaScope;
+using cogle::utils::coroutine::FrameArena;
+
+constexpr std::size_t RATE_DENOMINATOR = 1000;
+
+inline bool should_fail(std::size_t i, std::size_t error_rate) { return (i % RATE_DENOMINATOR) < error_rate; }
+
+[[gnu::noinline]] Result<int, int> step(std::size_t i, std::size_t error_rate) {
+    if (should_fail(i, error_rate)) {
+        return Err<int>{EINVAL};
+    }
+    return Ok<int>{static_cast<int>(i & 0xFFFF)};
+}
+
+[[gnu::noinline]] Result<int, int> early_return(std::size_t i, std::size_t error_rate) {
+    auto a = step(i, error_rate);
+    if (!a) {
+        return Err<int>{a.error()};
+    }
+    auto b = step(i + 1, error_rate);
+    if (!b) {
+        return Err<int>{b.error()};
+    }
+    auto c = step(i + 2, error_rate);
+    if (!c) {
+        return Err<int>{c.error()};
+    }
+    return Ok<int>{a.result() + b.result() + c.result()};
+}
+
+[[gnu::noinline]] Result<int, int> awaiting(std::size_t i, std::size_t error_rate) {
+    const int a = co_await step(i, error_rate);
+    const int b = co_await step(i + 1, error_rate);
+    const int c = co_await step(i + 2, error_rate);
+    co_return a + b + c;
+}
+
+template <typename Func>
+void run(bench::State& state, std::size_t error_rate, Func&& func) {
+    long sum = 0;
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto r = func(i, error_rate);
+        if (r) {
+            sum += r.result();
+        } else {
+            --sum;
+        }
+    }
+    bench::do_not_optimize(sum);
+}
+
+void register_rate(std::size_t error_rate) {
+    auto& registry    = bench::Registry::instance();
+    const auto suffix = "/rate_" + std::to_string(error_rate) + "_per_" + std::to_string(RATE_DENOMINATOR);
+
+    registry.add("coroutine", "early_return" + suffix,
+                 [error_rate](bench::State& state) { run(state, error_rate, early_return); });
+
+    registry.add("coroutine", "co_await_heap" + suffix,
+                 [error_rate](bench::State& state) { run(state, error_rate, awaiting); });
+
+    registry.add("coroutine", "co_await_arena" + suffix, [error_rate](bench::State& state) {
+        alignas(std::max_align_t) std::byte buffer[4096];
+        FrameArena arena{buffer, sizeof(buffer)};
+        ArenaScope scope{arena};
+
+        run(state, error_rate, awaiting);
+    });
+}
+
+[[maybe_unused]] const bool registered = [] {
+    // 0%, 1% and 10% of calls fail
+    for (const std::size_t rate : {0, 10, 100}) {
+        register_rate(rate);
+    }
+    return true;
+}();
+
+}  // namespace
+
+#endif
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include <cerrno>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utils/result.hxx>
+#include <version>
+
+#if defined(__cpp_lib_expected)
+#include <expected>
+#endif
+
+#include "bench.hxx"
+
+// Compares the cost of reporting a failure from a non-inlined call using Result against hand written error codes,
+// exceptions, std::optional and std::expected. Each variant fails for error_rate out of every 1000 calls.
+
+namespace {
+
+using namespace cogle::utils::result;
+using cogle::utils::niche::Errno;
+
+constexpr std::size_t RATE_DENOMINATOR = 1000;
+
+struct ParseError {
+    int code;
+};
+
+inline bool should_fail(std::size_t i, std::size_t error_rate) { return (i % RATE_DENOMINATOR) < error_rate; }
+
+[[gnu::noinline]] int parse_error_code(std::size_t i, std::size_t error_rate, int& out) {
+    if (should_fail(i, error_rate)) {
+        return EINVAL;
+    }
+    out = static_cast<int>(i & 0xFFFF);
+    return 0;
+}
+
+[[gnu::noinline]] Result<int, int> parse_result(std::size_t i, std::size_t error_rate) {
+    if (should_fail(i, error_rate)) {
+        return Err<int>{EINVAL};
+    }
+    return Ok<int>{static_cast<int>(i & 0xFFFF)};
+}
+
+[[gnu::noinline]] Result<int, Errno> parse_result_niche(std::size_t i, std::size_t error_rate) {
+    if (should_fail(i, error_rate)) {
+        return Err<Errno>{Errno{EINVAL}};
+    }
+    return Ok<int>{static_cast<int>(i & 0xFFFF)};
+}
+
+[[gnu::noinline]] Result<std::string, std::string> parse_result_string(std::size_t i, std::size_t error_rate) {
+    if (should_fail(i, error_rate)) {
+        return Err<std::string>{std::string{"invalid"}};
+    }
+    return Ok<std::string>{std::string{"valid"}};
+}
+
+[[gnu::noinline]] int parse_throw(std::size_t i, std::size_t error_rate) {
+    if (should_fail(i, error_rate)) {
+        throw ParseError{EINVAL};
+    }
+    return static_cast<int>(i & 0xFFFF);
+}
+
+[[gnu::noinline]] std::optional<int> parse_optional(std::size_t i, std::size_t error_rate) {
+    if (should_fail(i, error_rate)) {
+        return std::nullopt;
+    }
+    return static_cast<int>(i & 0xFFFF);
+}
+
+#if defined(__cpp_lib_expected)
+[[gnu::noinline]] std::expected<int, int> parse_expected(std::size_t i, std::size_t error_rate) {
+    if (should_fail(i, error_rate)) {
+        return std::unexpected<int>{EINVAL};
+    }
+    return static_cast<int>(i & 0xFFFF);
+}
+#endif
+
+void register_rate(std::size_t error_rate) {
+    auto& registry    = bench::Registry::instance();
+    const auto suffix = "/rate_" + std::to_string(error_rate) + "_per_" + std::to_string(RATE_DENOMINATOR);
+
+    registry.add("error_handling", "error_code" + suffix, [error_rate](bench::State& state) {
+        long sum = 0;
+        for (std::size_t i = 0; i < state.iterations(); ++i) {
+            int out = 0;
+            if (parse_error_code(i, error_rate, out) == 0) {
+                sum += out;
+            } else {
+                --sum;
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    registry.add("error_handling", "result<int,int>" + suffix, [error_rate](bench::State& state) {
+        long sum = 0;
+        for (std::size_t i = 0; i < state.iterations(); ++i) {
+            auto r = parse_result(i, error_rate);
+            if (r) {
+                sum += r.result();
+            } else {
+                --sum;
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    registry.add("error_handling", "result<int,Errno>" + suffix, [error_rate](bench::State& state) {
+        long sum = 0;
+        for (std::size_t i = 0; i < state.iterations(); ++i) {
+            auto r = parse_result_niche(i, error_rate);
+            if (r) {
+                sum += r.result();
+            } else {
+                --sum;
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    registry.add("error_handling", "result<string,string>" + suffix, [error_rate](bench::State& state) {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < state.iterations(); ++i) {
+            auto r = parse_result_string(i, error_rate);
+            if (r) {
+                sum += r.result().size();
+            } else {
+                sum -= r.error().size();
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    registry.add("error_handling", "exception" + suffix, [error_rate](bench::State& state) {
+        long sum = 0;
+        for (std::size_t i = 0; i < state.iterations(); ++i) {
+            try {
+                sum += parse_throw(i, error_rate);
+            } catch (const ParseError&) {
+                --sum;
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    registry.add("error_handling", "optional<int>" + suffix, [error_rate](bench::State& state) {
+        long sum = 0;
+        for (std::size_t i = 0; i < state.iterations(); ++i) {
+            auto r = parse_optional(i, error_rate);
+            if (r) {
+                sum += *r;
+            } else {
+                --sum;
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+
+#if defined(__cpp_lib_expected)
+    registry.add("error_handling", "expected<int,int>" + suffix, [error_rate](bench::State& state) {
+        long sum = 0;
+        for (std::size_t i = 0; i < state.iterations(); ++i) {
+            auto r = parse_expected(i, error_rate);
+            if (r) {
+                sum += *r;
+            } else {
+                --sum;
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+#endif
+}
+
+[[maybe_unused]] const bool registered = [] {
+    // 0%, 0.1%, 1% and 10% of calls fail
+    for (const std::size_t rate : {0, 1, 10, 100}) {
+        register_rate(rate);
+    }
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
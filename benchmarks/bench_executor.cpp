@@ -0,0 +1,99 @@
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <utils/executor.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+#include "bench.hxx"
+
+// Fanning out a batch of small Result returning tasks and joining them, and a task followed by a chain of
+// continuations, on a ThreadPool against std::async. std::async starts a thread per task and has no continuations, the
+// chain runs on the caller once the future is ready.
+
+namespace {
+
+using namespace cogle::utils::result;
+using namespace cogle::utils::executor;
+
+struct Invalid {
+    int code;
+};
+
+constexpr int TASKS = 64;
+
+// A few hundred cycles of work, fails for one input
+Result<std::uint64_t, Invalid> work(const int input) {
+    std::uint64_t hash = static_cast<std::uint64_t>(input);
+    for (int round = 0; round < 64; ++round) {
+        hash = (hash ^ (hash >> 31)) * 0x94d049bb133111ebULL;
+    }
+    UNLIKELY_IF(input == -1) { return Result<std::uint64_t, Invalid>{in_place_err, Invalid{input}}; }
+    return Result<std::uint64_t, Invalid>{in_place_ok, hash};
+}
+
+void fan_out_pool(bench::State& state) {
+    ThreadPool pool;
+    std::vector<Future<std::uint64_t, Invalid>> futures;
+    futures.reserve(TASKS);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        for (int task = 0; task < TASKS; ++task) {
+            futures.push_back(pool.submit([task] { return work(task); }));
+        }
+        std::uint64_t sum = 0;
+        for (auto& future : futures) {
+            sum += std::move(future).get().unwrap_or(0);
+        }
+        futures.clear();
+        bench::do_not_optimize(sum);
+    }
+}
+
+void fan_out_async(bench::State& state) {
+    std::vector<std::future<Result<std::uint64_t, Invalid>>> futures;
+    futures.reserve(TASKS);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        for (int task = 0; task < TASKS; ++task) {
+            futures.push_back(std::async(std::launch::async, [task] { return work(task); }));
+        }
+        std::uint64_t sum = 0;
+        for (auto& future : futures) {
+            sum += future.get().unwrap_or(0);
+        }
+        futures.clear();
+        bench::do_not_optimize(sum);
+    }
+}
+
+std::uint64_t twice(const std::uint64_t value) { return value * 2; }
+
+Result<std::uint64_t, Invalid> checked(const std::uint64_t value) {
+    return Result<std::uint64_t, Invalid>{in_place_ok, value | 1};
+}
+
+void chain_pool(bench::State& state) {
+    ThreadPool pool;
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto future = pool.submit([] { return work(7); }).map(twice).and_then(checked).map(twice);
+        bench::do_not_optimize(std::move(future).get());
+    }
+}
+
+void chain_async(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto future = std::async(std::launch::async, [] { return work(7); });
+        bench::do_not_optimize(future.get().map(twice).and_then(checked).map(twice));
+    }
+}
+
+[[maybe_unused]] const bool registered = [] {
+    auto& registry = bench::Registry::instance();
+
+    registry.add("executor/fan_out_64", "ThreadPool", fan_out_pool);
+    registry.add("executor/fan_out_64", "std::async", fan_out_async);
+    registry.add("executor/chain", "ThreadPool", chain_pool);
+    registry.add("executor/chain", "std::async", chain_async);
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
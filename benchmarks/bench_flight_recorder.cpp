@@ -0,0 +1,69 @@
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <utils/flight_recorder.hxx>
+
+#include "bench.hxx"
+
+// Cost of logging an error to the flight recorder, the budget is a few ns per Err. Each run opens a fresh recorder
+// file and opening it is part of the measurement, the doubling in bench::run amortizes it away.
+
+namespace {
+
+using namespace cogle::utils::recorder;
+using cogle::utils::location::SourceLocation;
+
+const std::string RECORDER_PATH = (std::filesystem::temp_directory_path() / "cogle_flight_recorder_bench.bin").native();
+
+struct ParseError {
+    explicit ParseError(int c) : code(c), offset(c * 2) {}
+
+    int code;
+    int offset;
+};
+
+void record_closed(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        record_err(static_cast<int>(i), SourceLocation::current());
+        bench::clobber();
+    }
+}
+
+template <typename E>
+void record_open(bench::State& state) {
+    if (FlightRecorder::open(RECORDER_PATH.c_str()) != 0) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        record_err(E{static_cast<int>(i & 0xFFFF)}, SourceLocation::current());
+        bench::clobber();
+    }
+
+    FlightRecorder::close();
+}
+
+void record_assert_open(bench::State& state) {
+    if (FlightRecorder::open(RECORDER_PATH.c_str()) != 0) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        record_assert("Expected OK tag to be valid", SourceLocation::current());
+        bench::clobber();
+    }
+
+    FlightRecorder::close();
+}
+
+[[maybe_unused]] const bool registered = [] {
+    auto& registry = bench::Registry::instance();
+
+    registry.add("flight_recorder", "record_err<int>/closed", record_closed);
+    registry.add("flight_recorder", "record_err<int>/open", record_open<int>);
+    registry.add("flight_recorder", "record_err<ParseError>/open", record_open<ParseError>);
+    registry.add("flight_recorder", "record_assert/open", record_assert_open);
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
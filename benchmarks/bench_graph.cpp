@@ -0,0 +1,82 @@
+#include <cstddef>
+#include <cstdint>
+#include <utils/executor.hxx>
+#include <utils/graph.hxx>
+#include <utils/result.hxx>
+
+#include "bench.hxx"
+
+// A request handler fanning out into a dependency graph: fetch A and B, combine them into C, render D from C. The
+// graph is built once and run for every request, against submitting the same shape as Futures per request.
+// allocs_per_op counts the heap allocations of a request.
+
+namespace {
+
+using namespace cogle::utils::result;
+using namespace cogle::utils::executor;
+
+struct Failed {
+    int code;
+};
+
+using Res = Result<std::uint64_t, Failed>;
+
+Res fetch(const std::uint64_t key) {
+    std::uint64_t hash = key;
+    for (int round = 0; round < 32; ++round) {
+        hash = (hash ^ (hash >> 27)) * 0x3c79ac492ba7b653ULL;
+    }
+    return Res{in_place_ok, hash};
+}
+
+Res combine(const std::uint64_t a, const std::uint64_t b) { return fetch(a ^ b); }
+
+void report(bench::State& state, const std::size_t before) {
+    const auto count = bench::allocations.load(std::memory_order_relaxed) - before;
+    state.counter("allocs_per_op", static_cast<double>(count) / static_cast<double>(state.iterations()));
+}
+
+void request_graph(bench::State& state) {
+    ThreadPool pool;
+    Graph<Failed> graph;
+    auto a = graph.add([] { return fetch(1); });
+    auto b = graph.add([] { return fetch(2); });
+    auto c = graph.add(combine, a, b);
+    auto d = graph.add([](const std::uint64_t value) { return fetch(value); }, c);
+    // The first run sizes the pool's queues
+    static_cast<void>(graph.run(pool));
+
+    const auto before = bench::allocations.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        bench::do_not_optimize(graph.run(pool));
+        bench::do_not_optimize(d.value());
+    }
+    report(state, before);
+}
+
+void request_futures(bench::State& state) {
+    ThreadPool pool;
+    const auto before = bench::allocations.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto a = pool.submit([] { return fetch(1); });
+        auto b = pool.submit([] { return fetch(2); });
+        auto d = std::move(a)
+                     .and_then([&b](const std::uint64_t value) {
+                         return std::move(b).get().and_then(
+                             [value](const std::uint64_t other) { return combine(value, other); });
+                     })
+                     .and_then(fetch);
+        bench::do_not_optimize(std::move(d).get());
+    }
+    report(state, before);
+}
+
+[[maybe_unused]] const bool registered = [] {
+    auto& registry = bench::Registry::instance();
+
+    registry.add("graph/request", "Graph", request_graph);
+    registry.add("graph/request", "Future", request_futures);
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench.hxx"
+
+namespace main_return_codes {
+constexpr auto SUCCESS = 0;
+constexpr auto FAILURE = -1;
+}  // namespace main_return_codes
+
+namespace {
+constexpr std::string_view FORMAT_FLAG   = "--format=";
+constexpr std::string_view FILTER_FLAG   = "--filter=";
+constexpr std::string_view MIN_TIME_FLAG = "--min_time_ms=";
+
+void print_usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--format=json|csv] [--filter=<substring>] [--min_time_ms=<ms>]" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char const* argv[]) {
+    std::string format = "json";
+    std::string filter{};
+    bench::RunOptions opts{};
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+
+        if (arg.substr(0, FORMAT_FLAG.size()) == FORMAT_FLAG) {
+            format = std::string{arg.substr(FORMAT_FLAG.size())};
+        } else if (arg.substr(0, FILTER_FLAG.size()) == FILTER_FLAG) {
+            filter = std::string{arg.substr(FILTER_FLAG.size())};
+        } else if (arg.substr(0, MIN_TIME_FLAG.size()) == MIN_TIME_FLAG) {
+            opts.min_time = std::chrono::milliseconds(std::atoi(argv[i] + MIN_TIME_FLAG.size()));
+        } else {
+            print_usage(argv[0]);
+            return main_return_codes::FAILURE;
+        }
+    }
+
+    if (format != "json" && format != "csv") {
+        print_usage(argv[0]);
+        return main_return_codes::FAILURE;
+    }
+
+    std::vector<bench::Measurement> results;
+    for (const auto& c : bench::Registry::instance().cases()) {
+        const auto full_name = c.group + "/" + c.name;
+        if (!filter.empty() && full_name.find(filter) == std::string::npos) {
+            continue;
+        }
+        results.push_back(bench::run(c, opts));
+    }
+
+    if (format == "json") {
+        bench::print_json(std::cout, results);
+    } else {
+        bench::print_csv(std::cout, results);
+    }
+
+    return main_return_codes::SUCCESS;
+}
\ No newline at end of file
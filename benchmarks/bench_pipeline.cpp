@@ -0,0 +1,65 @@
+#include <cstddef>
+#include <string>
+#include <utils/pipeline.hxx>
+#include <utils/result.hxx>
+
+#include "bench.hxx"
+
+// Six stage and_then/map chains, chained through the members of Result against a fused pipeline. The members
+// materialize a Result per stage, the pipeline constructs the final Result once.
+
+namespace {
+
+using namespace cogle::utils::result;
+namespace pipeline = cogle::utils::pipeline;
+
+// Heavy enough that every move of the error shows
+struct Failure {
+    explicit Failure(std::size_t c) : code(c), context(64, 'x'), detail(64, 'y') {}
+
+    std::size_t code;
+    std::string context;
+    std::string detail;
+};
+
+using Step = Result<std::size_t, Failure>;
+
+Step source(std::size_t i, bool fail) {
+    if (fail) {
+        return EmplaceErr{i};
+    }
+    return Ok{i};
+}
+
+Step check(std::size_t v) { return Ok{v + 1}; }
+
+std::size_t scale(std::size_t v) { return v * 3; }
+
+template <bool Fail>
+void members(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto out = source(i, Fail).and_then(check).map(scale).and_then(check).map(scale).and_then(check).map(scale);
+        bench::do_not_optimize(out);
+    }
+}
+
+template <bool Fail>
+void fused(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        Step out = source(i, Fail) | pipeline::then(check) | pipeline::map(scale) | pipeline::then(check) |
+                   pipeline::map(scale) | pipeline::then(check) | pipeline::map(scale);
+        bench::do_not_optimize(out);
+    }
+}
+
+[[maybe_unused]] const bool registered = [] {
+    auto& registry = bench::Registry::instance();
+
+    registry.add("pipeline/ok", "Result members", members<false>);
+    registry.add("pipeline/ok", "pipeline", fused<false>);
+    registry.add("pipeline/err", "Result members", members<true>);
+    registry.add("pipeline/err", "pipeline", fused<true>);
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
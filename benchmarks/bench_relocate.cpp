@@ -0,0 +1,75 @@
+#include <cstddef>
+#include <memory>
+#include <utils/relocate.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+#include "bench.hxx"
+
+// Growing and erasing from large containers of Results whose payload owns memory. std::vector moves and destroys every
+// element on reallocation, relocate::Buffer moves the whole range with memmove.
+
+namespace {
+
+// Owns a buffer like a completion payload would, relocatable but not trivially copyable
+struct Payload {
+    explicit Payload(std::size_t v) : data(std::make_unique<std::size_t>(v)) {}
+
+    std::unique_ptr<std::size_t> data;
+};
+
+}  // namespace
+
+template <>
+struct cogle::utils::traits::is_trivially_relocatable<Payload> : std::true_type {};
+
+namespace {
+
+using namespace cogle::utils::result;
+using cogle::utils::relocate::Buffer;
+
+using Completion = Result<Payload, int>;
+
+constexpr std::size_t ELEMENTS = 4096;
+
+// Mostly failed completions, so that allocating payloads does not hide the cost of reallocating the container
+template <typename Container>
+void grow(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        Container container;
+        for (std::size_t j = 0; j < ELEMENTS; ++j) {
+            if (j % 64 == 0) {
+                container.emplace_back(in_place_ok, j);
+            } else {
+                container.emplace_back(in_place_err, static_cast<int>(j));
+            }
+        }
+        bench::do_not_optimize(container.data());
+    }
+}
+
+template <typename Container>
+void erase_front(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        Container container;
+        for (std::size_t j = 0; j < ELEMENTS; ++j) {
+            container.emplace_back(in_place_err, static_cast<int>(j));
+        }
+        while (container.size() > ELEMENTS / 2) {
+            container.erase(container.begin(), container.begin() + 64);
+        }
+        bench::do_not_optimize(container.data());
+    }
+}
+
+[[maybe_unused]] const bool registered = [] {
+    auto& registry = bench::Registry::instance();
+
+    registry.add("relocate/grow", "std::vector", grow<std::vector<Completion>>);
+    registry.add("relocate/grow", "relocate::Buffer", grow<Buffer<Completion>>);
+    registry.add("relocate/erase_front", "std::vector", erase_front<std::vector<Completion>>);
+    registry.add("relocate/erase_front", "relocate::Buffer", erase_front<Buffer<Completion>>);
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <utils/result.hxx>
+
+#include "bench.hxx"
+
+// Construction, move, combinator and error path costs for every ResultStorage specialization.
+
+namespace {
+
+using namespace cogle::utils::result;
+using cogle::utils::niche::Errno;
+
+// Trivially destructible but not trivially copyable, selects the primary ResultStorage template.
+struct Point {
+    Point(int x_val, int y_val) : x(x_val), y(y_val) {}
+    Point(const Point& o) : x(o.x), y(o.y) {}
+    Point& operator=(const Point& o) = default;
+
+    int x;
+    int y;
+};
+
+struct Empty {};
+
+template <typename T>
+struct Payload;
+
+template <>
+struct Payload<int> {
+    static int make(std::size_t i) { return static_cast<int>(i & 0xFFFF); }
+};
+
+template <>
+struct Payload<Point> {
+    static Point make(std::size_t i) { return Point{static_cast<int>(i & 0xFFFF), 1}; }
+};
+
+template <>
+struct Payload<std::string> {
+    static std::string make(std::size_t) { return std::string{"payload"}; }
+};
+
+template <>
+struct Payload<Errno> {
+    static Errno make(std::size_t i) { return Errno{static_cast<int>(i % 100) + 1}; }
+};
+
+template <>
+struct Payload<Empty> {
+    static Empty make(std::size_t) { return Empty{}; }
+};
+
+template <typename R, typename E>
+Result<R, E> make_ok(std::size_t i) {
+    if constexpr (std::is_void_v<R>) {
+        (void)i;
+        return Ok<void>{};
+    } else {
+        return Ok<R>{Payload<R>::make(i)};
+    }
+}
+
+template <typename R, typename E>
+Result<R, E> make_err(std::size_t i) {
+    return Err<E>{Payload<E>::make(i)};
+}
+
+template <typename R, typename E>
+void construct_ok(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto r = make_ok<R, E>(i);
+        bench::do_not_optimize(r);
+    }
+}
+
+template <typename R, typename E>
+void construct_err(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto r = make_err<R, E>(i);
+        bench::do_not_optimize(r);
+    }
+}
+
+template <typename R, typename E>
+void move_assign(bench::State& state) {
+    auto src = make_ok<R, E>(0);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        Result<R, E> dst{std::move(src)};
+        bench::do_not_optimize(dst);
+        src = std::move(dst);
+        bench::clobber();
+    }
+}
+
+template <typename R, typename E>
+int chain(Result<R, E>& r) {
+    if constexpr (std::is_void_v<R>) {
+        return r.map([]() { return 1; })
+            .and_then([](int v) { return Result<int, E>{Ok<int>{v + 1}}; })
+            .match([](int v) { return v; }, [](E) { return -1; });
+    } else {
+        return r.map([](R v) { return v; })
+            .and_then([](R v) { return Result<R, E>{Ok<R>{std::move(v)}}; })
+            .match([](R) { return 1; }, [](E) { return -1; });
+    }
+}
+
+template <typename R, typename E>
+void combinators_ok(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto r = make_ok<R, E>(i);
+        bench::do_not_optimize(chain(r));
+    }
+}
+
+template <typename R, typename E>
+void combinators_err(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto r = make_err<R, E>(i);
+        bench::do_not_optimize(chain(r));
+    }
+}
+
+template <typename R, typename E>
+void shift_operator(bench::State& state) {
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        auto r = make_ok<R, E>(i);
+        if constexpr (std::is_void_v<R>) {
+            r >> []() { bench::clobber(); };
+        } else {
+            r >> [](const R& v) { bench::do_not_optimize(v); };
+        }
+    }
+}
+
+template <typename R, typename E>
+void register_storage(const std::string& group) {
+    auto& registry = bench::Registry::instance();
+
+    registry.add(group, "construct_ok", construct_ok<R, E>);
+    registry.add(group, "construct_err", construct_err<R, E>);
+    registry.add(group, "move", move_assign<R, E>);
+    registry.add(group, "combinators_ok", combinators_ok<R, E>);
+    registry.add(group, "combinators_err", combinators_err<R, E>);
+    registry.add(group, "shift_operator", shift_operator<R, E>);
+}
+
+[[maybe_unused]] const bool registered = [] {
+    register_storage<int, int>("storage/trivial<int,int>");
+    register_storage<Point, int>("storage/trivially_destructible<Point,int>");
+    register_storage<std::string, int>("storage/non_trivial<string,int>");
+    register_storage<void, int>("storage/void_trivial<void,int>");
+    register_storage<void, std::string>("storage/void_non_trivial<void,string>");
+    register_storage<int, Errno>("storage/niche<int,Errno>");
+    register_storage<void, Empty>("storage/empty<void,Empty>");
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
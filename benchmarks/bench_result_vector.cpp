@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utils/result.hxx>
+#include <utils/result_vector.hxx>
+#include <vector>
+
+#include "bench.hxx"
+
+// Scanning a batch of validated records for failures, std::vector<Result<R, E>> against ResultVector<R, E>. The vector
+// of Results reads every element to look at its tag, ResultVector only reads its bitmap and the dense errors.
+
+namespace {
+
+using namespace cogle::utils::result;
+
+struct Record {
+    std::uint64_t id;
+    double values[3];
+};
+
+struct Invalid {
+    int code;
+    int field;
+};
+
+constexpr std::size_t RECORDS = 100000;
+
+// 1% of the records fail, spread over the batch
+bool fails(const std::size_t i) { return i % 100 == 42; }
+
+// A single failure close to the end of the batch
+bool fails_late(const std::size_t i) { return i == RECORDS - 10; }
+
+Record make_record(const std::size_t i) {
+    const auto v = static_cast<double>(i);
+    return Record{i, {v, v * 2, v * 3}};
+}
+
+template <typename Fails>
+std::vector<Result<Record, Invalid>> make_vector(Fails&& failing) {
+    std::vector<Result<Record, Invalid>> records;
+    records.reserve(RECORDS);
+    for (std::size_t i = 0; i < RECORDS; ++i) {
+        if (failing(i)) {
+            records.emplace_back(in_place_err, Invalid{static_cast<int>(i), 1});
+        } else {
+            records.emplace_back(in_place_ok, make_record(i));
+        }
+    }
+    return records;
+}
+
+template <typename Fails>
+ResultVector<Record, Invalid> make_result_vector(Fails&& failing) {
+    ResultVector<Record, Invalid> records;
+    records.reserve(RECORDS, RECORDS / 100);
+    for (std::size_t i = 0; i < RECORDS; ++i) {
+        if (failing(i)) {
+            records.emplace_err(Invalid{static_cast<int>(i), 1});
+        } else {
+            records.emplace_ok(make_record(i));
+        }
+    }
+    return records;
+}
+
+void sum_errors_vector(bench::State& state) {
+    const auto records = make_vector(fails);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        long sum = 0;
+        for (const auto& record : records) {
+            if (record.is_err()) {
+                sum += record.error_unchecked().code;
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+void sum_errors_result_vector(bench::State& state) {
+    const auto records = make_result_vector(fails);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        long sum = 0;
+        records.for_each_err([&sum](std::size_t, const Invalid& invalid) { sum += invalid.code; });
+        bench::do_not_optimize(sum);
+    }
+}
+
+void first_err_vector(bench::State& state) {
+    const auto records = make_vector(fails_late);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        const auto it = std::find_if(records.begin(), records.end(), [](const auto& r) { return r.is_err(); });
+        bench::do_not_optimize(it);
+    }
+}
+
+void first_err_result_vector(bench::State& state) {
+    const auto records = make_result_vector(fails_late);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        bench::do_not_optimize(records.first_err());
+    }
+}
+
+void count_err_range_vector(bench::State& state) {
+    const auto records = make_vector(fails);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        const auto count = std::count_if(records.begin() + 1000, records.end() - 1000,
+                                         [](const auto& r) { return r.is_err(); });
+        bench::do_not_optimize(count);
+    }
+}
+
+void count_err_range_result_vector(bench::State& state) {
+    const auto records = make_result_vector(fails);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        bench::do_not_optimize(records.count_err(1000, RECORDS - 1000));
+    }
+}
+
+[[maybe_unused]] const bool registered = [] {
+    auto& registry = bench::Registry::instance();
+
+    registry.add("result_vector/sum_errors", "std::vector<Result>", sum_errors_vector);
+    registry.add("result_vector/sum_errors", "ResultVector", sum_errors_result_vector);
+    registry.add("result_vector/first_err", "std::vector<Result>", first_err_vector);
+    registry.add("result_vector/first_err", "ResultVector", first_err_result_vector);
+    registry.add("result_vector/count_err_range", "std::vector<Result>", count_err_range_vector);
+    registry.add("result_vector/count_err_range", "ResultVector", count_err_range_result_vector);
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
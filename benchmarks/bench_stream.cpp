@@ -0,0 +1,133 @@
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utils/result.hxx>
+#include <utils/stream.hxx>
+#include <vector>
+
+#include "bench.hxx"
+
+// Streaming items through parse, validate and write stages, one thread per stage, measured per item. A Stream passing
+// batches of 64 and of 1 item, against the same stages connected by mutex and condition variable guarded deques.
+
+namespace {
+
+using namespace cogle::utils::result;
+using namespace cogle::utils::stream;
+
+struct Invalid {
+    std::uint64_t value;
+};
+
+constexpr std::size_t CHUNK = 256;
+
+Result<std::uint64_t, Invalid> parse(const std::uint64_t raw) {
+    return Result<std::uint64_t, Invalid>{in_place_ok, (raw ^ (raw >> 29)) * 0xbf58476d1ce4e5b9ULL};
+}
+
+// Never fails, the inputs are too small
+Result<std::uint64_t, Invalid> validate(const std::uint64_t value) {
+    UNLIKELY_IF(value == 1) { return Result<std::uint64_t, Invalid>{in_place_err, Invalid{value}}; }
+    return Result<std::uint64_t, Invalid>{in_place_ok, value >> 1};
+}
+
+void run_stream(bench::State& state, const std::size_t batch) {
+    StreamOptions options;
+    options.batch = batch;
+
+    std::uint64_t sum = 0;
+    auto stream       = make_stream<std::uint64_t>(options, parse, validate, [&sum](const std::uint64_t value) {
+        sum += value;
+        return Result<void, Invalid>{in_place_ok};
+    });
+
+    std::vector<std::uint64_t> items;
+    items.reserve(CHUNK);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        items.push_back(i + 2);
+        if (items.size() == CHUNK) {
+            static_cast<void>(stream.push_batch(items));
+        }
+    }
+    static_cast<void>(stream.push_batch(items));
+    static_cast<void>(stream.finish());
+    bench::do_not_optimize(sum);
+}
+
+void stream_batch_64(bench::State& state) { run_stream(state, 64); }
+
+void stream_batch_1(bench::State& state) { run_stream(state, 1); }
+
+// Unbounded, as such queues usually are, an empty optional ends the stream
+class LockedQueue {
+public:
+    void push(std::optional<std::uint64_t> item) {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            items_.push_back(item);
+        }
+        ready_.notify_one();
+    }
+
+    std::optional<std::uint64_t> pop() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        ready_.wait(lock, [this] { return !items_.empty(); });
+        const auto item = items_.front();
+        items_.pop_front();
+        return item;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::optional<std::uint64_t>> items_;
+};
+
+void locked_queues(bench::State& state) {
+    LockedQueue parsed;
+    LockedQueue validated;
+    LockedQueue raw;
+    std::uint64_t sum = 0;
+
+    std::thread parser{[&] {
+        while (const auto item = raw.pop()) {
+            parse(*item).match([&](const std::uint64_t value) { parsed.push(value); }, [](const Invalid&) {});
+        }
+        parsed.push(std::nullopt);
+    }};
+    std::thread validator{[&] {
+        while (const auto item = parsed.pop()) {
+            validate(*item).match([&](const std::uint64_t value) { validated.push(value); }, [](const Invalid&) {});
+        }
+        validated.push(std::nullopt);
+    }};
+    std::thread writer{[&] {
+        while (const auto item = validated.pop()) {
+            sum += *item;
+        }
+    }};
+
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        raw.push(i + 2);
+    }
+    raw.push(std::nullopt);
+    parser.join();
+    validator.join();
+    writer.join();
+    bench::do_not_optimize(sum);
+}
+
+[[maybe_unused]] const bool registered = [] {
+    auto& registry = bench::Registry::instance();
+
+    registry.add("stream/3_stages", "Stream batch 64", stream_batch_64);
+    registry.add("stream/3_stages", "Stream batch 1", stream_batch_1);
+    registry.add("stream/3_stages", "mutex deque", locked_queues);
+    return true;
+}();
+
+}  // namespace
\ No newline at end of file
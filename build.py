@@ -22,6 +22,9 @@ COMPILER_FLAG_KEY = "compiler"
 WIPE_FLAG_KEY = "wipe"
 GCOV_FLAG_KEY = "gcov"
 EXAMPLES_FLAG_KEY = "examples"
+BENCHMARKS_FLAG_KEY = "benchmarks"
+CODEGEN_FLAG_KEY = "codegen"
+TOOLS_FLAG_KEY = "tools"
 CMAKE_USER_DEFINITIONS = "user_args"
 
 # Key Pairs
@@ -38,7 +41,8 @@ BUILD_DIR_CMAKE_FLAG_KEY = "cmake_build_dir_flag"
 # TODO MAKE SOURCE DIR CONFIGURABLE
 
 CMAKE_BUILD_ARGS_KEYS_SET = {CMAKE_BUILD_FLAG_KEY, TESTS_FLAG_KEY, CMAKE_USER_DEFINITIONS,
-                             SANITIZER_FLAG_KEY, BUILD_DIR_CMAKE_FLAG_KEY, GCOV_FLAG_KEY, EXAMPLES_FLAG_KEY}
+                             SANITIZER_FLAG_KEY, BUILD_DIR_CMAKE_FLAG_KEY, GCOV_FLAG_KEY, EXAMPLES_FLAG_KEY,
+                             BENCHMARKS_FLAG_KEY, CODEGEN_FLAG_KEY, TOOLS_FLAG_KEY}
 BUILD_ENV_KEYS_SET = {COMPILER_FLAG_KEY}
 
 REQUIRED_KEYS = {BUILD_FLAG_KEY, BUILD_DIR_FLAG_KEY, COMPILER_FLAG_KEY}
@@ -48,6 +52,9 @@ GCOV_BUILD = "-DWITH_GCOV=true"
 
 UNIT_TESTS_BUILD = "-DWITH_TESTS=true"
 EXAMPLES_BUILD = "-DWITH_EXAMPLES=true"
+BENCHMARKS_BUILD = "-DWITH_BENCHMARKS=true"
+CODEGEN_BUILD = "-DWITH_CODEGEN_TESTS=true"
+TOOLS_BUILD = "-DWITH_TOOLS=true"
 
 EXIT_CODE_FAIL = -1
 
@@ -302,6 +309,12 @@ def parse_args():
         "--tests", help="Build with unit tests", action="store_true")
     parser.add_argument(
         "--examples", help="Build with examples", action="store_true")
+    parser.add_argument(
+        "--benchmarks", help="Build with benchmarks", action="store_true")
+    parser.add_argument(
+        "--codegen", help="Build with codegen regression tests", action="store_true")
+    parser.add_argument(
+        "--tools", help="Build with tools", action="store_true")
     parser.add_argument("--clean", help="Build clean", action="store_true")
     parser.add_argument(
         "--wipe", help="Wipes the build directory by removing it", action="store_true")
@@ -362,6 +375,18 @@ def parse_args():
     if args.examples:
         ret[EXAMPLES_FLAG_KEY] = EXAMPLES_BUILD
 
+    # benchmarks
+    if args.benchmarks:
+        ret[BENCHMARKS_FLAG_KEY] = BENCHMARKS_BUILD
+
+    # codegen regression tests
+    if args.codegen:
+        ret[CODEGEN_FLAG_KEY] = CODEGEN_BUILD
+
+    # tools
+    if args.tools:
+        ret[TOOLS_FLAG_KEY] = TOOLS_BUILD
+
     # build dir
     if args.dir:
         if not os.path.exists(args.dir):
@@ -24,7 +24,7 @@ Result<fs::path, std::error_code> create_temp_file() {
         return Err<std::error_code>(ec);
     }
 
-    return Ok<fs::path>{std::move(dir_path)};
+    return EmplaceOk{std::move(dir_path)};
 }
 
 int main(int argc, char const* argv[]) {
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace examples {
+namespace directory {
+constexpr auto EXAMPLES_DIR_PATH = "/root/repo/_gate_build/examples/files";
+}
+}  // namespace examples
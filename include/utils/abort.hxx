@@ -2,19 +2,74 @@
 
 #include <exception>
 #include <iostream>
+#include <type_traits>
 #include <utils/compatibility.hxx>
+#include <utils/location.hxx>
+
+#if defined(COGLE_FLIGHT_RECORDER)
+#include <utils/flight_recorder.hxx>
+#endif
+
+// Checks expect and aborts with message on failure. The message and the call site are packed into a static
+// AbortRecord in .rodata so the check site only passes its address. Not usable inside constexpr functions, see
+// COGLE_CURRENT_LOCATION.
+#define COGLE_ASSERT(expect, message)                                                                                \
+    ::cogle::utils::abort::cogle_assert((expect), *({                                                                \
+        static constexpr ::cogle::utils::abort::AbortRecord cogle_abort_record_{                                     \
+            message, ::cogle::utils::location::SourceLocation::current(__builtin_FILE(), __func__, __builtin_LINE(), \
+                                                                       COGLE_BUILTIN_COLUMN())};                     \
+        &cogle_abort_record_;                                                                                        \
+    }))
 
 namespace cogle {
 namespace utils {
 namespace abort {
 
+// Everything that is reported when a check fails. Check sites only hand a record to the out of line abort path below,
+// so the formatting code is emitted once instead of at every check.
+struct AbortRecord {
+    const char* message;
+    location::SourceLocation location;
+};
+
+namespace detail {
+// The variadic overloads below must not hijack a lone AbortRecord
 template <typename... Args>
-[[noreturn]] void abort(Args&&... args) {
+constexpr bool is_record_v = (std::is_same_v<std::decay_t<Args>, AbortRecord> || ...);
+}  // namespace detail
+
+// The single failure path shared by all checks, kept cold and out of line so that a check site is a compare and a
+// jump into the .text.unlikely section.
+[[noreturn, gnu::cold, gnu::noinline]] inline void abort(const AbortRecord& record) {
+#if defined(COGLE_FLIGHT_RECORDER)
+    recorder::record_assert(record.message, record.location);
+#endif
+    std::cout << record.message << " " << record.location << std::endl << std::flush;
+    std::terminate();
+}
+
+template <typename... Args, typename = std::enable_if_t<!detail::is_record_v<Args...>>>
+[[noreturn, gnu::cold, gnu::noinline]] void abort(Args&&... args) {
+#if defined(COGLE_FLIGHT_RECORDER)
+    recorder::record_assert("abort", location::SourceLocation{});
+#endif
     ((std::cout << args << " "), ...) << std::endl << std::flush;
     std::terminate();
 }
 
-template <typename... Args>
+constexpr void cogle_assert(bool expect, const AbortRecord& record) {
+    LIKELY_IF(expect) { return; }
+    abort(record);
+}
+
+// The location is taken by value, once inlined it is only materialized on the failure path.
+constexpr void cogle_assert(bool expect, const char* message,
+                            const location::SourceLocation sl = location::SourceLocation::current()) {
+    LIKELY_IF(expect) { return; }
+    abort(AbortRecord{message, sl});
+}
+
+template <typename... Args, typename = std::enable_if_t<!detail::is_record_v<Args...>>>
 constexpr void cogle_assert(bool expect, Args&&... args) {
     LIKELY_IF(expect) { return; }
     abort(std::forward<Args>(args)...);
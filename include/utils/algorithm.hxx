@@ -0,0 +1,382 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <utils/compatibility.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+namespace cogle {
+namespace utils {
+namespace algorithm {
+
+// Algorithms turning ranges of Results into a single Result:
+//
+//     collect(results)            -> Result<std::vector<R>, E>, the results or the first error
+//     partition(results)          -> Partition<R, E>, the results and the errors
+//     try_transform(range, func)  -> Result<std::vector<U>, E>, with func(element) -> Result<U, E>
+//
+// The payloads are moved out of an rvalue range and copied out of an lvalue range. The first error is the one at the
+// lowest position, as it would be for a loop over the range.
+//
+// Passing par (or a Parallel with its own settings) as the first argument splits a random access range into chunks
+// that are worked off by several threads. The output is allocated up front and written in place, each chunk covers
+// whole cache lines of it. collect and try_transform stop handing out chunks past the first error as soon as it is
+// known, elements before it are still visited since they may hold an earlier error. The parallel algorithms need
+// default constructible results and errors as their output is allocated before it is written.
+
+// How the parallel algorithms split their work
+struct Parallel {
+    // Number of threads including the calling one, 0 for std::thread::hardware_concurrency()
+    std::size_t threads = 0;
+    // Minimum number of elements per chunk
+    std::size_t grain = 2048;
+};
+
+inline constexpr Parallel par{};
+
+template <typename R, typename E>
+struct Partition {
+    std::vector<R> oks;
+    std::vector<E> errs;
+};
+
+namespace detail {
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+// The element type of a range, and the element forwarded like the range
+template <typename Range>
+using element_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<Range&>()))>>;
+
+template <typename Range, typename Element>
+constexpr decltype(auto) forward_element(Element& element) noexcept {
+    if constexpr (std::is_lvalue_reference_v<Range>) {
+        return static_cast<const Element&>(element);
+    } else {
+        return std::move(element);
+    }
+}
+
+// Result type of try_transform, Res is what func returns
+template <typename Res, typename R = typename std::remove_reference_t<Res>::result_type>
+using collected_t = result::Result<std::conditional_t<std::is_void_v<R>, void, std::vector<R>>,
+                                   typename std::remove_reference_t<Res>::error_type>;
+
+template <typename Res>
+using collected_error_t = typename std::remove_reference_t<Res>::error_type;
+
+// The parallel algorithms write their output from several threads. std::vector<bool> packs its elements so chunks
+// would share words, bools are written to bytes and packed once the threads are done.
+template <typename T>
+using unpacked_t = std::conditional_t<std::is_same_v<T, bool>, unsigned char, T>;
+
+template <typename T>
+std::vector<T> pack(std::vector<unpacked_t<T>>&& values) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return std::vector<bool>(values.begin(), values.end());
+    } else {
+        return std::move(values);
+    }
+}
+
+// Chunk size for an output of Out, the grain rounded up to whole cache lines of it
+template <typename Out>
+constexpr std::size_t chunk_size(const Parallel& policy) noexcept {
+    constexpr std::size_t OUT_SIZE = sizeof(std::conditional_t<std::is_void_v<Out>, char, Out>);
+    constexpr std::size_t PER_LINE = OUT_SIZE >= CACHE_LINE ? 1 : CACHE_LINE / OUT_SIZE;
+    return (std::max<std::size_t>(policy.grain, 1) + PER_LINE - 1) / PER_LINE * PER_LINE;
+}
+
+constexpr std::size_t chunk_count(const std::size_t n, const std::size_t chunk) noexcept {
+    return (n + chunk - 1) / chunk;
+}
+
+// Number of threads worth starting for n elements, the calling thread included
+inline std::size_t thread_count(const Parallel& policy, const std::size_t n, const std::size_t chunk) noexcept {
+    const std::size_t hw = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+    return std::min(std::max<std::size_t>(hw, 1), chunk_count(n, chunk));
+}
+
+// Runs work(idx, begin, end) for the chunks of [0, n) on up to policy.threads threads, the calling thread included.
+// Chunks are handed out in order, work returns false to stop its thread from taking more. The first exception thrown
+// by work is rethrown on the calling thread once every thread has stopped.
+template <typename Work>
+void run_chunks(const Parallel& policy, const std::size_t n, const std::size_t chunk, Work&& work) {
+    const std::size_t chunks = chunk_count(n, chunk);
+    const std::size_t count  = thread_count(policy, n, chunk);
+
+    struct alignas(CACHE_LINE) Shared {
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> stop{false};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+    } shared;
+
+    auto worker = [&]() noexcept {
+        try {
+            while (!shared.stop.load(std::memory_order_relaxed)) {
+                const std::size_t idx = shared.next.fetch_add(1, std::memory_order_relaxed);
+                if (idx >= chunks || !work(idx, idx * chunk, std::min(n, (idx + 1) * chunk))) {
+                    break;
+                }
+            }
+        } catch (...) {
+            if (!shared.failed.exchange(true)) {
+                shared.error = std::current_exception();
+            }
+            shared.stop.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    if (count > 1) {
+        threads.reserve(count - 1);
+        for (std::size_t i = 1; i < count; ++i) {
+            threads.emplace_back(worker);
+        }
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (shared.error) {
+        std::rethrow_exception(shared.error);
+    }
+}
+
+template <typename It, typename F>
+auto try_transform_seq(It first, It last, F&& func) -> collected_t<decltype(func(*first))> {
+    using Res = decltype(func(*first));
+    using Out = collected_t<Res>;
+    using R   = typename std::remove_reference_t<Res>::result_type;
+
+    if constexpr (std::is_void_v<R>) {
+        for (; first != last; ++first) {
+            auto&& res = func(*first);
+            UNLIKELY_IF(res.is_err()) { return Out{result::in_place_err, std::forward<Res>(res).error_unchecked()}; }
+        }
+        return Out{result::in_place_ok};
+    } else {
+        std::vector<R> values;
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                        typename std::iterator_traits<It>::iterator_category>) {
+            values.reserve(static_cast<std::size_t>(last - first));
+        }
+        for (; first != last; ++first) {
+            auto&& res = func(*first);
+            UNLIKELY_IF(res.is_err()) { return Out{result::in_place_err, std::forward<Res>(res).error_unchecked()}; }
+            values.emplace_back(std::forward<Res>(res).unwrap_unchecked());
+        }
+        return Out{result::in_place_ok, std::move(values)};
+    }
+}
+
+template <typename It, typename F>
+auto try_transform_par(const Parallel& policy, It first, It last, F&& func) -> collected_t<decltype(func(*first))> {
+    using Res = decltype(func(*first));
+    using Out = collected_t<Res>;
+    using R   = typename std::remove_reference_t<Res>::result_type;
+    using E   = collected_error_t<Res>;
+    static_assert(std::is_void_v<R> || std::is_default_constructible_v<R>,
+                  "the parallel algorithms write into preallocated output and need a default constructible result");
+
+    // A single thread is better off without the preallocated output
+    const auto n            = static_cast<std::size_t>(last - first);
+    const std::size_t chunk = chunk_size<R>(policy);
+    if (thread_count(policy, n, chunk) <= 1) {
+        return try_transform_seq(first, last, std::forward<F>(func));
+    }
+
+    std::conditional_t<std::is_void_v<R>, char, std::vector<unpacked_t<R>>> values{};
+    if constexpr (!std::is_void_v<R>) {
+        values.resize(n);
+    }
+
+    // The lowest position of an error seen so far, chunks past it are skipped. Each chunk keeps the first error it
+    // meets, once the threads are done the lowest one is the error of the whole range.
+    struct alignas(CACHE_LINE) FirstErr {
+        std::atomic<std::size_t> idx{npos};
+    } first_err;
+
+    struct alignas(CACHE_LINE) ChunkErr {
+        std::optional<E> error;
+    };
+    std::vector<ChunkErr> errors(chunk_count(n, chunk));
+
+    run_chunks(policy, n, chunk, [&](const std::size_t idx, const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            // Another thread found an earlier error, nothing after it is needed
+            if ((i - begin) % CACHE_LINE == 0 && i > first_err.idx.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            auto&& res = func(first[static_cast<typename std::iterator_traits<It>::difference_type>(i)]);
+            UNLIKELY_IF(res.is_err()) {
+                errors[idx].error.emplace(std::forward<Res>(res).error_unchecked());
+                std::size_t seen = first_err.idx.load(std::memory_order_relaxed);
+                while (i < seen && !first_err.idx.compare_exchange_weak(seen, i, std::memory_order_relaxed)) {
+                }
+                return false;
+            }
+            if constexpr (!std::is_void_v<R>) {
+                values[i] = std::forward<Res>(res).unwrap_unchecked();
+            }
+        }
+        return true;
+    });
+
+    // Chunks before the first error ran to their end, so the first chunk holding an error holds the first error
+    for (auto& slot : errors) {
+        if (slot.error) {
+            return Out{result::in_place_err, std::move(*slot.error)};
+        }
+    }
+    if constexpr (std::is_void_v<R>) {
+        return Out{result::in_place_ok};
+    } else {
+        return Out{result::in_place_ok, pack<R>(std::move(values))};
+    }
+}
+
+template <typename Range>
+constexpr bool is_random_access_v = std::is_base_of_v<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<decltype(std::begin(std::declval<Range&>()))>::iterator_category>;
+}  // namespace detail
+
+// try_transform<Range, Func>(Range&& range, Func&& f) -> Result<std::vector<U>, E>
+// where f(element) -> Result<U, E>
+// The values f returns in order, or the first error it returns. Elements after it are not visited.
+template <typename Range, typename F>
+[[nodiscard]] auto try_transform(Range&& range, F&& func) {
+    return detail::try_transform_seq(std::begin(range), std::end(range), [&func](auto& element) -> decltype(auto) {
+        return func(detail::forward_element<Range>(element));
+    });
+}
+
+template <typename Range, typename F>
+[[nodiscard]] auto try_transform(const Parallel& policy, Range&& range, F&& func) {
+    static_assert(detail::is_random_access_v<Range>, "the parallel algorithms need a random access range");
+    return detail::try_transform_par(policy, std::begin(range), std::end(range),
+                                     [&func](auto& element) -> decltype(auto) {
+                                         return func(detail::forward_element<Range>(element));
+                                     });
+}
+
+// collect<Range>(Range&& range) -> Result<std::vector<R>, E>
+// The results of a range of Result<R, E>, or its first error. A void R gives a Result<void, E>.
+template <typename Range>
+[[nodiscard]] auto collect(Range&& range) {
+    return detail::try_transform_seq(std::begin(range), std::end(range), [](auto& element) -> decltype(auto) {
+        return detail::forward_element<Range>(element);
+    });
+}
+
+template <typename Range>
+[[nodiscard]] auto collect(const Parallel& policy, Range&& range) {
+    static_assert(detail::is_random_access_v<Range>, "the parallel algorithms need a random access range");
+    return detail::try_transform_par(policy, std::begin(range), std::end(range), [](auto& element) -> decltype(auto) {
+        return detail::forward_element<Range>(element);
+    });
+}
+
+// partition<Range>(Range&& range) -> Partition<R, E>
+// Splits a range of Result<R, E> into its results and its errors, both in the order of the range.
+template <typename Range, typename Res = detail::element_t<Range>>
+[[nodiscard]] Partition<typename Res::result_type, typename Res::error_type> partition(Range&& range) {
+    static_assert(!std::is_void_v<typename Res::result_type>, "partition needs a non-void result, see collect");
+
+    std::size_t errs = 0;
+    for (const auto& element : range) {
+        errs += element.is_err() ? 1 : 0;
+    }
+
+    Partition<typename Res::result_type, typename Res::error_type> out;
+    out.errs.reserve(errs);
+    if constexpr (detail::is_random_access_v<Range>) {
+        out.oks.reserve(static_cast<std::size_t>(std::end(range) - std::begin(range)) - errs);
+    }
+    for (auto& element : range) {
+        if (element.is_err()) {
+            out.errs.emplace_back(detail::forward_element<Range>(element).error_unchecked());
+        } else {
+            out.oks.emplace_back(detail::forward_element<Range>(element).unwrap_unchecked());
+        }
+    }
+    return out;
+}
+
+// Counts the errors of every chunk, sizes the output and then moves each chunk to its offsets
+template <typename Range, typename Res = detail::element_t<Range>>
+[[nodiscard]] Partition<typename Res::result_type, typename Res::error_type> partition(const Parallel& policy,
+                                                                                     Range&& range) {
+    using R = typename Res::result_type;
+    using E = typename Res::error_type;
+    static_assert(!std::is_void_v<R>, "partition needs a non-void result, see collect");
+    static_assert(detail::is_random_access_v<Range>, "the parallel algorithms need a random access range");
+    static_assert(std::is_default_constructible_v<R> && std::is_default_constructible_v<E>,
+                  "the parallel algorithms write into preallocated output and need default constructible payloads");
+
+    auto first   = std::begin(range);
+    const auto n = static_cast<std::size_t>(std::end(range) - first);
+    auto at      = [&first](const std::size_t i) -> decltype(auto) {
+        return first[static_cast<typename std::iterator_traits<decltype(first)>::difference_type>(i)];
+    };
+
+    const std::size_t chunk = detail::chunk_size<R>(policy);
+    if (detail::thread_count(policy, n, chunk) <= 1) {
+        return partition(std::forward<Range>(range));
+    }
+
+    struct alignas(CACHE_LINE) Block {
+        std::size_t errs       = 0;
+        std::size_t ok_offset  = 0;
+        std::size_t err_offset = 0;
+    };
+    std::vector<Block> blocks(detail::chunk_count(n, chunk));
+
+    detail::run_chunks(policy, n, chunk, [&](const std::size_t idx, const std::size_t begin, const std::size_t end) {
+        std::size_t errs = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            errs += at(i).is_err() ? 1 : 0;
+        }
+        blocks[idx].errs = errs;
+        return true;
+    });
+
+    std::size_t total_errs = 0;
+    for (std::size_t idx = 0; idx < blocks.size(); ++idx) {
+        blocks[idx].err_offset = total_errs;
+        blocks[idx].ok_offset  = idx * chunk - total_errs;
+        total_errs += blocks[idx].errs;
+    }
+
+    std::vector<detail::unpacked_t<R>> oks(n - total_errs);
+    std::vector<detail::unpacked_t<E>> errs(total_errs);
+
+    detail::run_chunks(policy, n, chunk, [&](const std::size_t idx, const std::size_t begin, const std::size_t end) {
+        std::size_t ok  = blocks[idx].ok_offset;
+        std::size_t err = blocks[idx].err_offset;
+        for (std::size_t i = begin; i < end; ++i) {
+            auto& element = at(i);
+            if (element.is_err()) {
+                errs[err++] = detail::forward_element<Range>(element).error_unchecked();
+            } else {
+                oks[ok++] = detail::forward_element<Range>(element).unwrap_unchecked();
+            }
+        }
+        return true;
+    });
+    return Partition<R, E>{detail::pack<R>(std::move(oks)), detail::pack<E>(std::move(errs))};
+}
+
+}  // namespace algorithm
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
@@ -0,0 +1,331 @@
+#pragma once
+
+// Bounded multi producer multi consumer channel of Result.
+//
+//     Channel<Order, std::string> orders{1024};
+//     // Producers
+//     orders.send(Result<Order, std::string>{in_place_ok, order});
+//     orders.send_batch(parsed);
+//     orders.close();
+//     // Consumers
+//     for (auto order = orders.recv(); !(order.is_err() && order.error().closed()); order = orders.recv()) {
+//         ...
+//     }
+//
+// Producers send values and errors alike, consumers receive them in the order the producers claimed their slots. Once
+// closed, sends fail with Closed and receives drain what was sent before, then fail with a ChannelError that is
+// closed(). The channel being closed is an error of the Result rather than a flag to check next to it.
+//
+// The ring is the bounded queue of Dmitry Vyukov: every slot, alone on its cache line, carries a sequence number
+// telling whose turn it is, producers and consumers claim slots with a compare and swap on their own position and only
+// contend with each other when the channel is full or empty. send_batch and recv_batch claim as many consecutive slots
+// as are ready with a single compare and swap. A full or empty channel makes its callers spin for a while, then sleep
+// on a futex that the other side only wakes after seeing a sleeper.
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <utils/abort.hxx>
+#include <utils/compatibility.hxx>
+#include <utils/futex.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+namespace cogle {
+namespace utils {
+namespace channel {
+
+// Sending on a closed channel
+struct Closed {};
+
+// Error of a receive: an error sent through the channel, or the channel being closed with nothing left to receive
+template <typename E>
+class ChannelError {
+public:
+    ChannelError(Closed) noexcept {}
+
+    explicit ChannelError(E error) noexcept(std::is_nothrow_move_constructible_v<E>) : error_(std::move(error)) {}
+
+    [[nodiscard]] bool closed() const noexcept { return !error_.has_value(); }
+
+    // The error that was sent, the channel must not be closed()
+    [[nodiscard]] const E& error() const& {
+        COGLE_ASSERT(!closed(), "ChannelError::error() of a closed channel");
+        return *error_;
+    }
+
+    [[nodiscard]] E&& error() && {
+        COGLE_ASSERT(!closed(), "ChannelError::error() of a closed channel");
+        return std::move(*error_);
+    }
+
+private:
+    std::optional<E> error_;
+};
+
+namespace detail {
+// Callers sleeping on one side of the channel, and the word they sleep on
+struct alignas(CACHE_LINE) Sleepers {
+    std::atomic<std::uint32_t> epoch{0};
+    std::atomic<std::uint32_t> count{0};
+
+    // Sleeps unless ready() holds once this side is seen as sleeping
+    template <typename Ready>
+    void sleep(const Ready& ready) noexcept {
+        const std::uint32_t seen = epoch.load(std::memory_order_acquire);
+        count.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence of wake, either the waker sees count or ready() sees its progress
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ready()) {
+            futex::wait(epoch, seen);
+        }
+        count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void wake(const std::size_t waiters) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        UNLIKELY_IF(count.load(std::memory_order_relaxed) != 0) {
+            epoch.fetch_add(1, std::memory_order_release);
+            futex::wake(epoch, waiters);
+        }
+    }
+};
+}  // namespace detail
+
+template <typename R, typename E>
+class Channel {
+public:
+    using item_type = result::Result<R, E>;
+
+    // Items are moved in and out of slots that are already claimed, a throwing move would leave them claimed for good
+    static_assert(std::is_nothrow_move_constructible_v<item_type>, "Channel items must be nothrow move constructible");
+
+    // Holds at least capacity items, rounded up to a power of two
+    explicit Channel(const std::size_t capacity) : mask_(round_up(capacity) - 1), slots_(new Slot[mask_ + 1]) {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    Channel(const Channel&)            = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    ~Channel() {
+        const std::size_t end = enqueue_.load() & ~CLOSED;
+        for (std::size_t position = dequeue_.load(); position != end; ++position) {
+            stored(slot(position))->~item_type();
+        }
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    // Sends a value or an error, waiting while the channel is full
+    result::Result<void, Closed> send(item_type item) {
+        return send_some(&item, 1) == 1 ? result::Result<void, Closed>{result::in_place_ok}
+                                        : result::Result<void, Closed>{result::in_place_err, Closed{}};
+    }
+
+    // Sends all of items, waiting while the channel is full, and leaves items empty. Fails with the items not sent
+    // left in items if the channel is closed meanwhile.
+    result::Result<void, Closed> send_batch(std::vector<item_type>& items) {
+        const std::size_t sent = send_some(items.data(), items.size());
+        items.erase(items.begin(), items.begin() + static_cast<std::ptrdiff_t>(sent));
+        UNLIKELY_IF(!items.empty()) { return result::Result<void, Closed>{result::in_place_err, Closed{}}; }
+        return result::Result<void, Closed>{result::in_place_ok};
+    }
+
+    // Receives the next value or error, waiting while the channel is empty
+    [[nodiscard]] result::Result<R, ChannelError<E>> recv() {
+        using Out = result::Result<R, ChannelError<E>>;
+        std::optional<item_type> received;
+        UNLIKELY_IF(!recv_some(1, [&received](item_type&& next) { received.emplace(std::move(next)); })) {
+            return Out{result::in_place_err, Closed{}};
+        }
+        UNLIKELY_IF(received->is_err()) {
+            return Out{result::in_place_err, ChannelError<E>{std::move(*received).error_unchecked()}};
+        }
+        if constexpr (std::is_void_v<R>) {
+            return Out{result::in_place_ok};
+        } else {
+            return Out{result::in_place_ok, std::move(*received).unwrap_unchecked()};
+        }
+    }
+
+    // Appends between 1 and max items to out, waiting while the channel is empty, returns how many
+    [[nodiscard]] result::Result<std::size_t, Closed> recv_batch(std::vector<item_type>& out, const std::size_t max) {
+        COGLE_ASSERT(max > 0, "Channel::recv_batch() of no items");
+        const std::size_t before = out.size();
+        // Claimed slots are moved out without allocating
+        out.reserve(before + std::min(max, capacity()));
+        UNLIKELY_IF(!recv_some(max, [&out](item_type&& next) { out.push_back(std::move(next)); })) {
+            return result::Result<std::size_t, Closed>{result::in_place_err, Closed{}};
+        }
+        return result::Result<std::size_t, Closed>{result::in_place_ok, out.size() - before};
+    }
+
+    // Sends fail from now on, receives fail once the items sent before are received
+    void close() noexcept {
+        enqueue_.fetch_or(CLOSED, std::memory_order_acq_rel);
+        senders_.wake(INT_MAX);
+        receivers_.wake(INT_MAX);
+    }
+
+private:
+    struct alignas(CACHE_LINE) Slot {
+        // position when free for the producer of position, position + 1 when holding its item
+        std::atomic<std::size_t> sequence;
+        alignas(item_type) std::byte storage[sizeof(item_type)];
+    };
+
+    // Set in enqueue_ by close, positions never get there
+    static constexpr std::size_t CLOSED = std::size_t{1} << (sizeof(std::size_t) * CHAR_BIT - 1);
+    static constexpr int SPINS          = 64;
+
+    static std::size_t round_up(const std::size_t capacity) noexcept {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    [[nodiscard]] Slot& slot(const std::size_t position) const noexcept { return slots_[position & mask_]; }
+
+    [[nodiscard]] static item_type* stored(Slot& slot) noexcept {
+        return std::launder(reinterpret_cast<item_type*>(slot.storage));
+    }
+
+    // Moves up to count items into consecutive free slots, 0 if the channel is full, CLOSED if it is closed
+    std::size_t try_send(item_type* items, const std::size_t count) noexcept {
+        std::size_t position = enqueue_.load(std::memory_order_relaxed);
+        std::size_t claimed  = 0;
+        for (;;) {
+            UNLIKELY_IF(position & CLOSED) { return CLOSED; }
+            claimed = 0;
+            while (claimed < count &&
+                   slot(position + claimed).sequence.load(std::memory_order_acquire) == position + claimed) {
+                ++claimed;
+            }
+            if (claimed == 0) {
+                const std::size_t sequence = slot(position).sequence.load(std::memory_order_acquire);
+                // The consumer of the previous lap did not release the slot yet
+                if (static_cast<std::ptrdiff_t>(sequence - position) < 0) {
+                    return 0;
+                }
+                position = enqueue_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (enqueue_.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        for (std::size_t i = 0; i < claimed; ++i) {
+            Slot& claimed_slot = slot(position + i);
+            new (claimed_slot.storage) item_type(std::move(items[i]));
+            claimed_slot.sequence.store(position + i + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    // Passes up to max items from consecutive filled slots to consume, 0 if the channel is empty, CLOSED if it is
+    // closed and drained
+    template <typename Consume>
+    std::size_t try_recv(const std::size_t max, const Consume& consume) {
+        std::size_t position = dequeue_.load(std::memory_order_relaxed);
+        std::size_t claimed  = 0;
+        for (;;) {
+            claimed = 0;
+            while (claimed < max &&
+                   slot(position + claimed).sequence.load(std::memory_order_acquire) == position + claimed + 1) {
+                ++claimed;
+            }
+            if (claimed == 0) {
+                const std::size_t sequence = slot(position).sequence.load(std::memory_order_acquire);
+                // No producer claimed the slot yet, or its item is still being written
+                if (static_cast<std::ptrdiff_t>(sequence - (position + 1)) < 0) {
+                    const std::size_t end = enqueue_.load(std::memory_order_acquire);
+                    return end == (position | CLOSED) ? CLOSED : 0;
+                }
+                position = dequeue_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeue_.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        for (std::size_t i = 0; i < claimed; ++i) {
+            Slot& claimed_slot = slot(position + i);
+            item_type* next    = stored(claimed_slot);
+            consume(std::move(*next));
+            next->~item_type();
+            claimed_slot.sequence.store(position + i + mask_ + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    // Sends items until all are sent or the channel is closed, returns how many were sent
+    std::size_t send_some(item_type* items, const std::size_t count) {
+        std::size_t sent = 0;
+        for (int idle = 0; sent < count; ++idle) {
+            const std::size_t claimed = try_send(items + sent, count - sent);
+            UNLIKELY_IF(claimed == CLOSED) { break; }
+            if (claimed != 0) {
+                sent += claimed;
+                idle = 0;
+                receivers_.wake(claimed);
+                continue;
+            }
+            if (idle < SPINS) {
+                std::this_thread::yield();
+                continue;
+            }
+            senders_.sleep([this] {
+                const std::size_t position = enqueue_.load(std::memory_order_relaxed);
+                return (position & CLOSED) || slot(position).sequence.load(std::memory_order_acquire) == position;
+            });
+        }
+        return sent;
+    }
+
+    // Receives between 1 and max items, false once the channel is closed and drained
+    template <typename Consume>
+    bool recv_some(const std::size_t max, const Consume& consume) {
+        for (int idle = 0;; ++idle) {
+            const std::size_t claimed = try_recv(max, consume);
+            UNLIKELY_IF(claimed == CLOSED) { return false; }
+            if (claimed != 0) {
+                senders_.wake(claimed);
+                return true;
+            }
+            if (idle < SPINS) {
+                std::this_thread::yield();
+                continue;
+            }
+            receivers_.sleep([this] {
+                const std::size_t position = dequeue_.load(std::memory_order_relaxed);
+                return (enqueue_.load(std::memory_order_relaxed) & CLOSED) ||
+                       slot(position).sequence.load(std::memory_order_acquire) == position + 1;
+            });
+        }
+    }
+
+    const std::size_t mask_;
+    const std::unique_ptr<Slot[]> slots_;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueue_{0};
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeue_{0};
+    detail::Sleepers senders_;
+    detail::Sleepers receivers_;
+};
+
+}  // namespace channel
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
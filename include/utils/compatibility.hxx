@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace cogle {
 namespace utils {
 
@@ -16,5 +18,19 @@ namespace utils {
 #define UNLIKELY_IF(x) if (UNLIKELY(x))
 #endif
 
+// ASSUME(x) tells the optimizer that x holds, if x is false the behaviour is undefined. Clang's __builtin_assume is not
+// used, it drops the assumption with -Wassume when x calls a function it cannot prove free of side effects, such as
+// Result::is_ok.
+#define ASSUME(x)                    \
+    do {                             \
+        if (!(x)) {                  \
+            __builtin_unreachable(); \
+        }                            \
+    } while (0)
+
+// Fields written by different threads are aligned to this to keep them off each other's cache lines. A constant rather
+// than std::hardware_destructive_interference_size, whose value may change with compiler flags and breaks layouts.
+inline constexpr std::size_t CACHE_LINE = 64;
+
 }  // namespace utils
 }  // namespace cogle
\ No newline at end of file
@@ -0,0 +1,318 @@
+#pragma once
+
+// C++20 coroutine support for Result. A function returning Result<R, E> may be written as a coroutine that co_awaits
+// other Results: an Ok is unwrapped and execution continues, an Err ends the coroutine and becomes its return value.
+//
+//     Result<Config, std::string> load(const char* path) {
+//         auto text   = co_await read_file(path);
+//         auto parsed = co_await parse(text);
+//         co_return Ok{validate(std::move(parsed))};
+//     }
+//
+// co_return takes anything a Result<R, E> can be built from (Ok, Err, EmplaceOk, EmplaceErr, another Result) or a
+// value for the result. Coroutines returning Result<void, E> end with a plain co_return and return an error through
+// co_await Err{...}, which is also available to any other Result coroutine.
+//
+// These coroutines never suspend, they run to completion before returning. Compilers that cannot elide the frame
+// allocate it with the promise's operator new, which takes the frame from the FrameArena installed for the calling
+// thread (see ArenaScope) and falls back to the heap.
+//
+// get_return_object hands out a ReturnObject that is only converted to the Result once the coroutine returns to its
+// caller. The standard leaves open when that conversion happens (CWG2563), GCC and Clang convert late as required here.
+// MSVC converts before the coroutine body runs and is not supported, the conversion aborts if it ever happens early.
+
+#include <utils/abort.hxx>
+#include <utils/compatibility.hxx>
+#include <utils/result.hxx>
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cogle {
+namespace utils {
+namespace coroutine {
+
+// Bump allocator for coroutine frames over a caller supplied buffer. Frames of Result coroutines are released in the
+// reverse order of their allocation, as a coroutine completes before its caller continues, so the arena releases
+// memory like a stack. A frame that does not fit is allocated on the heap instead.
+class FrameArena {
+public:
+    FrameArena(void* buffer, std::size_t size) noexcept
+        : begin_(static_cast<std::byte*>(buffer)), top_(begin_), end_(begin_ + size) {}
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // nullptr if the arena is exhausted
+    [[nodiscard]] void* allocate(std::size_t size) noexcept {
+        size = align_up(size);
+        UNLIKELY_IF(static_cast<std::size_t>(end_ - top_) < size) { return nullptr; }
+
+        void* frame = top_;
+        top_ += size;
+        return frame;
+    }
+
+    // Only the most recent allocation is released, anything else is reclaimed once the frames above it are
+    void deallocate(void* frame, std::size_t size) noexcept {
+        auto* bytes = static_cast<std::byte*>(frame);
+        if (bytes + align_up(size) == top_) {
+            top_ = bytes;
+        }
+    }
+
+    [[nodiscard]] std::size_t used() const noexcept { return static_cast<std::size_t>(top_ - begin_); }
+    [[nodiscard]] std::size_t capacity() const noexcept { return static_cast<std::size_t>(end_ - begin_); }
+
+    // The arena the calling thread allocates frames from, nullptr for the heap
+    [[nodiscard]] static FrameArena* current() noexcept { return current_; }
+
+private:
+    static constexpr std::size_t ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    static constexpr std::size_t align_up(std::size_t size) noexcept {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    std::byte* begin_;
+    std::byte* top_;
+    std::byte* end_;
+
+    static inline thread_local FrameArena* current_ = nullptr;
+
+    friend class ArenaScope;
+};
+
+// Installs an arena for the calling thread for as long as the scope lives, scopes nest.
+class ArenaScope {
+public:
+    explicit ArenaScope(FrameArena& arena) noexcept : previous_(FrameArena::current_) { FrameArena::current_ = &arena; }
+    ~ArenaScope() { FrameArena::current_ = previous_; }
+
+    ArenaScope(const ArenaScope&)            = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    FrameArena* previous_;
+};
+
+namespace detail {
+// Every frame is preceded by the arena it was taken from, nullptr for the heap, so that it is released to the right
+// place whichever arena is installed at that point.
+struct FrameHeader {
+    FrameArena* arena;
+};
+
+constexpr std::size_t FRAME_HEADER_SIZE = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+static_assert(sizeof(FrameHeader) <= FRAME_HEADER_SIZE);
+
+inline void* allocate_frame(std::size_t size) {
+    FrameArena* arena = FrameArena::current();
+    void* block       = arena != nullptr ? arena->allocate(size + FRAME_HEADER_SIZE) : nullptr;
+    if (block == nullptr) {
+        arena = nullptr;
+        block = ::operator new(size + FRAME_HEADER_SIZE);
+    }
+
+    ::new (block) FrameHeader{arena};
+    return static_cast<std::byte*>(block) + FRAME_HEADER_SIZE;
+}
+
+inline void deallocate_frame(void* frame, std::size_t size) noexcept {
+    void* block       = static_cast<std::byte*>(frame) - FRAME_HEADER_SIZE;
+    FrameArena* arena = static_cast<FrameHeader*>(block)->arena;
+    if (arena != nullptr) {
+        arena->deallocate(block, size + FRAME_HEADER_SIZE);
+    } else {
+        ::operator delete(block, size + FRAME_HEADER_SIZE);
+    }
+}
+
+template <typename R, typename E>
+class PromiseBase;
+
+template <typename R, typename E>
+class Promise;
+
+// What get_return_object hands out. The Result is only constructed once the coroutine has produced it, the promise
+// writes it straight into this object which is then converted to the Result the caller receives.
+template <typename R, typename E>
+class ReturnObject {
+public:
+    explicit ReturnObject(Promise<R, E>& promise) noexcept : promise_(&promise) { promise.slot_ = this; }
+
+    // The compiler may move the return object before the coroutine runs, the promise follows it
+    ReturnObject(ReturnObject&& o) noexcept : promise_(o.promise_) {
+        if (o.engaged_) {
+            ::new (&storage_) result::Result<R, E>(std::move(o.get()));
+            engaged_ = true;
+        } else {
+            promise_->slot_ = this;
+        }
+    }
+
+    ReturnObject(const ReturnObject&)            = delete;
+    ReturnObject& operator=(const ReturnObject&) = delete;
+    ReturnObject& operator=(ReturnObject&&)      = delete;
+
+    ~ReturnObject() {
+        if (engaged_) {
+            get().~Result();
+        }
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator result::Result<R, E>() && {
+        COGLE_ASSERT(engaged_, "ReturnObject converted before the coroutine produced its Result, see CWG2563");
+        return std::move(get());
+    }
+
+private:
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        ::new (&storage_) result::Result<R, E>(std::forward<Args>(args)...);
+        engaged_ = true;
+    }
+
+    result::Result<R, E>& get() noexcept { return *std::launder(reinterpret_cast<result::Result<R, E>*>(&storage_)); }
+
+    Promise<R, E>* promise_;
+    alignas(result::Result<R, E>) std::byte storage_[sizeof(result::Result<R, E>)];
+    bool engaged_ = false;
+
+    friend class PromiseBase<R, E>;
+    friend class Promise<R, E>;
+};
+
+// co_await on a Result, Res is the Result qualified as it was awaited
+template <typename Res, typename R, typename E>
+class ResultAwaiter {
+    using Awaited = std::remove_reference_t<Res>;
+
+public:
+    explicit ResultAwaiter(Res&& awaited) noexcept : awaited_(std::forward<Res>(awaited)) {}
+
+    [[nodiscard]] bool await_ready() const noexcept { return awaited_.is_ok(); }
+
+    // The error becomes the Result of the coroutine, which ends here
+    void await_suspend(std::coroutine_handle<Promise<R, E>> handle) {
+        handle.promise().return_error(std::forward<Res>(awaited_).error());
+        handle.destroy();
+    }
+
+    // An rvalue Result hands out its result by value, it does not outlive the full expression of the co_await
+    decltype(auto) await_resume() {
+        if constexpr (std::is_void_v<typename Awaited::result_type>) {
+            return;
+        } else if constexpr (std::is_lvalue_reference_v<Res> || std::is_reference_v<typename Awaited::result_type>) {
+            return awaited_.result();
+        } else {
+            return static_cast<typename Awaited::result_type>(std::move(awaited_).result());
+        }
+    }
+
+private:
+    Res&& awaited_;
+};
+
+// co_await on an Err always ends the coroutine
+template <typename Res, typename R, typename E>
+class ErrAwaiter {
+public:
+    explicit ErrAwaiter(Res&& err) noexcept : err_(std::forward<Res>(err)) {}
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<Promise<R, E>> handle) {
+        handle.promise().return_error(std::forward<Res>(err_).get_error());
+        handle.destroy();
+    }
+
+    [[noreturn]] void await_resume() noexcept { __builtin_unreachable(); }
+
+private:
+    Res&& err_;
+};
+
+template <typename T>
+struct is_err : std::false_type {};
+
+template <typename Ev>
+struct is_err<result::Err<Ev>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_err_v = is_err<std::remove_cvref_t<T>>::value;
+
+// Results of void and non-void coroutines only differ in how they end
+template <typename R, typename E>
+class PromiseBase {
+public:
+    ReturnObject<R, E> get_return_object() noexcept { return ReturnObject<R, E>{static_cast<Promise<R, E>&>(*this)}; }
+
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() const { throw; }
+
+    template <typename Res, typename = std::enable_if_t<traits::is_result_v<Res>>>
+    ResultAwaiter<Res, R, E> await_transform(Res&& awaited) noexcept {
+        static_assert(std::is_constructible_v<E, decltype(std::forward<Res>(awaited).error())>,
+                      "co_await requires a Result whose error converts to the error of the coroutine");
+        return ResultAwaiter<Res, R, E>{std::forward<Res>(awaited)};
+    }
+
+    template <typename Res, typename = std::enable_if_t<is_err_v<Res>>, typename = void>
+    ErrAwaiter<Res, R, E> await_transform(Res&& err) noexcept {
+        return ErrAwaiter<Res, R, E>{std::forward<Res>(err)};
+    }
+
+    static void* operator new(std::size_t size) { return allocate_frame(size); }
+    static void operator delete(void* frame, std::size_t size) noexcept { deallocate_frame(frame, size); }
+
+    template <typename V>
+    void return_error(V&& error) {
+        slot_->emplace(result::in_place_err, std::forward<V>(error));
+    }
+
+protected:
+    ReturnObject<R, E>* slot_ = nullptr;
+
+    friend class ReturnObject<R, E>;
+};
+
+template <typename R, typename E>
+class Promise : public PromiseBase<R, E> {
+public:
+    template <typename U = R, typename = std::enable_if_t<std::is_constructible_v<result::Result<R, E>, U&&> ||
+                                                          std::is_constructible_v<R, U&&>>>
+    void return_value(U&& value) {
+        if constexpr (std::is_constructible_v<result::Result<R, E>, U&&>) {
+            this->slot_->emplace(std::forward<U>(value));
+        } else {
+            this->slot_->emplace(result::in_place_ok, std::forward<U>(value));
+        }
+    }
+};
+
+template <typename E>
+class Promise<void, E> : public PromiseBase<void, E> {
+public:
+    void return_void() { this->slot_->emplace(result::in_place_ok); }
+};
+}  // namespace detail
+
+}  // namespace coroutine
+}  // namespace utils
+}  // namespace cogle
+
+template <typename R, typename E, typename... Args>
+struct std::coroutine_traits<cogle::utils::result::Result<R, E>, Args...> {
+    using promise_type = cogle::utils::coroutine::detail::Promise<R, E>;
+};
+
+#endif
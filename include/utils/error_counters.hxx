@@ -0,0 +1,222 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utils/compatibility.hxx>
+#include <utils/location.hxx>
+
+namespace cogle {
+namespace utils {
+namespace counters {
+
+// Counts how often errors are created and propagated per call site. It is opt in, define COGLE_ERROR_COUNTERS in every
+// translation unit to count each user constructed Err<E> at the location it was built and each and_then/map on an
+// error at the location it was called. Without the define none of this is compiled in.
+//
+// Sites live in a fixed size open addressing table and their counters in SHARDS copies, every thread adds to the copy
+// picked by its shard so that threads reporting the same site rarely share a cache line. Sites are keyed on the
+// contents of their location, every thread remembers the slots of the sites it has seen by the addresses of their
+// strings so that only its first count of a site hashes and compares them. Everything is zero initialized static or
+// thread local storage, there is no static initialization and nothing is allocated.
+
+static constexpr std::size_t MAX_SITES = 4096;
+static constexpr std::size_t SHARDS    = 16;
+
+static_assert((MAX_SITES & (MAX_SITES - 1)) == 0, "MAX_SITES must be a power of two");
+
+// Aggregated counts of a single site as returned by ErrorCounters::snapshot
+struct SiteCount {
+    location::SourceLocation location;
+    std::uint64_t errors;
+    std::uint64_t propagations;
+};
+
+class ErrorCounters {
+    static constexpr std::size_t NO_SITE = MAX_SITES;
+
+public:
+    static void count_err(const location::SourceLocation& sl) noexcept {
+        const std::size_t idx = lookup(sl);
+        LIKELY_IF(idx != NO_SITE) { shard()[idx].errors.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    static void count_propagation(const location::SourceLocation& sl) noexcept {
+        const std::size_t idx = lookup(sl);
+        LIKELY_IF(idx != NO_SITE) { shard()[idx].propagations.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    // Calls func(const SiteCount&) for every site seen so far. The counts are summed over all shards while other
+    // threads keep counting, so a count may lag behind increments that are still in flight.
+    template <typename F>
+    static void for_each(F&& func) {
+        for (std::size_t idx = 0; idx < MAX_SITES; ++idx) {
+            const Site& site = sites_[idx];
+            if (!site.ready.load(std::memory_order_acquire)) {
+                continue;
+            }
+
+            SiteCount count{location::SourceLocation::current(site.file, site.func, site.line, site.col), 0, 0};
+            for (std::size_t s = 0; s < SHARDS; ++s) {
+                count.errors += counters_[s][idx].errors.load(std::memory_order_relaxed);
+                count.propagations += counters_[s][idx].propagations.load(std::memory_order_relaxed);
+            }
+            func(count);
+        }
+    }
+
+    // Writes up to capacity sites to out and returns the number of sites seen so far, which may exceed capacity.
+    static std::size_t snapshot(SiteCount* out, const std::size_t capacity) noexcept {
+        std::size_t n = 0;
+        for_each([out, capacity, &n](const SiteCount& count) {
+            if (n < capacity) {
+                out[n] = count;
+            }
+            ++n;
+        });
+        return n;
+    }
+
+    // Number of counts lost because the site table was full
+    [[nodiscard]] static std::uint64_t dropped() noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    // Zeroes all counters, sites stay registered
+    static void reset() noexcept {
+        for (auto& shard_counters : counters_) {
+            for (auto& counter : shard_counters) {
+                counter.errors.store(0, std::memory_order_relaxed);
+                counter.propagations.store(0, std::memory_order_relaxed);
+            }
+        }
+        dropped_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct Site {
+        // 0 while the slot is free
+        std::atomic<std::uint64_t> key;
+        // Set once the location below has been written
+        std::atomic<bool> ready;
+        const char* file;
+        const char* func;
+        int line;
+        int col;
+    };
+
+    struct Counter {
+        std::atomic<std::uint64_t> errors;
+        std::atomic<std::uint64_t> propagations;
+    };
+
+    // A slot as last found by this thread, file is nullptr while the entry is unused
+    struct CachedSite {
+        const char* file;
+        const char* func;
+        int line;
+        int col;
+        std::size_t idx;
+    };
+
+    static constexpr std::size_t CACHED_SITES = 64;
+
+    // Sites never leave the table, so a cached slot stays valid. Locations with the same strings at the same addresses
+    // hit the cache, any other copy of a location takes the slow path once and then has an entry of its own.
+    static std::size_t lookup(const location::SourceLocation& sl) noexcept {
+        constexpr std::uint64_t MULTIPLIER = 0x9E3779B97F4A7C15u;
+        thread_local CachedSite cache[CACHED_SITES];
+
+        const int line  = static_cast<int>(sl.line());
+        std::uint64_t h = reinterpret_cast<std::uintptr_t>(sl.file_name());
+        h               = (h ^ reinterpret_cast<std::uintptr_t>(sl.function_name())) * MULTIPLIER;
+        h               = (h ^ static_cast<std::uint32_t>(line)) * MULTIPLIER;
+        h               = (h ^ static_cast<std::uint32_t>(sl.column())) * MULTIPLIER;
+
+        CachedSite& entry = cache[(h >> 32) & (CACHED_SITES - 1)];
+        LIKELY_IF(entry.file == sl.file_name() && entry.func == sl.function_name() && entry.line == line &&
+                  entry.col == sl.column()) {
+            return entry.idx;
+        }
+
+        const std::size_t idx = find_or_insert(sl);
+        if (idx != NO_SITE) {
+            entry = CachedSite{sl.file_name(), sl.function_name(), line, sl.column(), idx};
+        }
+        return idx;
+    }
+
+    // Keyed on the contents of the location rather than the addresses of its strings, the same site may be reported
+    // with copies of its file name living in different translation units. Never 0.
+    static std::uint64_t site_key(const location::SourceLocation& sl) noexcept {
+        return static_cast<std::uint64_t>(sl.hash()) | (std::uint64_t{1} << 32);
+    }
+
+    // Keys of different sites may collide, a slot only belongs to the site once its stored location compares equal
+    static bool holds(const Site& site, const location::SourceLocation& sl) noexcept {
+        // The slot was claimed by another thread that has not written the location yet
+        while (!site.ready.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        if (site.line != static_cast<int>(sl.line()) || site.col != sl.column()) {
+            return false;
+        }
+        LIKELY_IF(site.file == sl.file_name() && site.func == sl.function_name()) { return true; }
+        return location::SourceLocation::current(site.file, site.func, site.line, site.col) == sl;
+    }
+
+    static std::size_t find_or_insert(const location::SourceLocation& sl) noexcept {
+        const std::uint64_t key = site_key(sl);
+
+        for (std::size_t probe = 0; probe < MAX_SITES; ++probe) {
+            const std::size_t idx = static_cast<std::size_t>(key + probe) & (MAX_SITES - 1);
+            Site& site            = sites_[idx];
+
+            std::uint64_t current = site.key.load(std::memory_order_acquire);
+            if (current == 0) {
+                if (site.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                    site.file = sl.file_name();
+                    site.func = sl.function_name();
+                    site.line = static_cast<int>(sl.line());
+                    site.col  = sl.column();
+                    site.ready.store(true, std::memory_order_release);
+                    return idx;
+                }
+                // Lost the race for the slot, current now holds the key of the winner
+            }
+
+            LIKELY_IF(current == key && holds(site, sl)) { return idx; }
+        }
+
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return NO_SITE;
+    }
+
+    static Counter* shard() noexcept {
+        thread_local const std::size_t thread_shard = next_shard_.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return counters_[thread_shard];
+    }
+
+    inline static Site sites_[MAX_SITES];
+    inline static Counter counters_[SHARDS][MAX_SITES];
+    inline static std::atomic<std::uint64_t> dropped_;
+    inline static std::atomic<std::size_t> next_shard_;
+};
+
+// Hooks used by Err and Result when COGLE_ERROR_COUNTERS is defined, nothing is counted during constant evaluation.
+constexpr void count_err(const location::SourceLocation& sl) noexcept {
+    if (__builtin_is_constant_evaluated()) {
+        return;
+    }
+    ErrorCounters::count_err(sl);
+}
+
+constexpr void count_propagation(const bool failed, const location::SourceLocation& sl) noexcept {
+    if (__builtin_is_constant_evaluated() || !failed) {
+        return;
+    }
+    ErrorCounters::count_propagation(sl);
+}
+
+}  // namespace counters
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
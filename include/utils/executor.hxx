@@ -0,0 +1,583 @@
+#pragma once
+
+// Work stealing thread pool for functions returning Result.
+//
+//     ThreadPool pool{4};
+//     Future<Config, std::string> config = pool.submit([] { return load("app.toml"); })
+//                                              .and_then([](Config c) { return validate(std::move(c)); });
+//     Result<Config, std::string> result = std::move(config).get();
+//
+// Every worker owns a deque of tasks, it pushes and pops at one end while idle workers steal from the other. Tasks
+// submitted from outside the pool go through a shared queue. A Future offers the combinators of Result (and_then, map,
+// map_err, or_else, match) and runs them inline on the thread completing it, or on the calling thread when it already
+// is complete, without going through the pool again. Errors travel as the error of the Result, submitted functions
+// must not throw.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <utils/compatibility.hxx>
+#include <utils/futex.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+namespace cogle {
+namespace utils {
+namespace executor {
+
+template <typename R, typename E>
+class Future;
+
+template <typename E>
+class Graph;
+
+class ThreadPool;
+
+namespace detail {
+class Task {
+public:
+    virtual void run() noexcept = 0;
+
+protected:
+    ~Task() = default;
+};
+
+// Chase-Lev deque (Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models").
+// The owner pushes and pops at the bottom, any thread steals from the top. Rings replaced when growing are kept until
+// the deque is destroyed as a thief may still be reading them.
+class WorkDeque {
+public:
+    explicit WorkDeque(const std::size_t capacity = 256) : ring_(new Ring(capacity)) { rings_.emplace_back(ring_); }
+
+    WorkDeque(const WorkDeque&)            = delete;
+    WorkDeque& operator=(const WorkDeque&) = delete;
+
+    // Owner only
+    void push(Task* task) {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top    = top_.load(std::memory_order_acquire);
+        Ring* ring                = ring_.load(std::memory_order_relaxed);
+        UNLIKELY_IF(bottom - top >= static_cast<std::int64_t>(ring->mask)) { ring = grow(ring, top, bottom); }
+
+        ring->put(bottom, task);
+        bottom_.store(bottom + 1, std::memory_order_release);
+    }
+
+    // Owner only, nullptr if empty
+    Task* pop() noexcept {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* ring                = ring_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Task* task = ring->get(bottom);
+        if (top == bottom) {
+            // Last task, race the thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                task = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    // Any thread, nullptr if empty or lost to another thread
+    Task* steal() noexcept {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        Task* task = ring_.load(std::memory_order_acquire)->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return task;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return bottom_.load(std::memory_order_seq_cst) <= top_.load(std::memory_order_seq_cst);
+    }
+
+private:
+    struct Ring {
+        explicit Ring(const std::size_t capacity) : mask(capacity - 1), slots(new std::atomic<Task*>[capacity]) {}
+
+        [[nodiscard]] Task* get(const std::int64_t idx) const noexcept {
+            return slots[static_cast<std::size_t>(idx) & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(const std::int64_t idx, Task* task) noexcept {
+            slots[static_cast<std::size_t>(idx) & mask].store(task, std::memory_order_relaxed);
+        }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+    };
+
+    Ring* grow(Ring* ring, const std::int64_t top, const std::int64_t bottom) {
+        auto* bigger = new Ring((ring->mask + 1) * 2);
+        rings_.emplace_back(bigger);
+        for (std::int64_t i = top; i < bottom; ++i) {
+            bigger->put(i, ring->get(i));
+        }
+        ring_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(CACHE_LINE) std::atomic<std::int64_t> top_{0};
+    alignas(CACHE_LINE) std::atomic<std::int64_t> bottom_{0};
+    std::atomic<Ring*> ring_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+};
+
+// The pool and worker the current thread belongs to, if any
+struct WorkerContext {
+    ThreadPool* pool   = nullptr;
+    std::size_t worker = 0;
+};
+
+inline thread_local WorkerContext current_worker;
+
+// Runs one pending task of the current thread's pool, false if there is none or the thread is not a worker
+inline bool help_one() noexcept;
+
+// Receives the Result of the state it is attached to, on the thread completing it
+template <typename R, typename E>
+class Continuation {
+public:
+    virtual void resume(result::Result<R, E>&& result) noexcept = 0;
+
+protected:
+    ~Continuation() = default;
+};
+
+// Shared between a Future, the task or continuation producing its Result and the continuation consuming it. Whichever
+// of complete and attach comes second runs the continuation.
+template <typename R, typename E>
+class State {
+public:
+    explicit State(const std::uint32_t refs) noexcept : refs_(refs) {}
+
+    State(const State&)            = delete;
+    State& operator=(const State&) = delete;
+
+    virtual ~State() = default;
+
+    void release() noexcept {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    template <typename... Args>
+    void complete(Args&&... args) noexcept {
+        result_.emplace(std::forward<Args>(args)...);
+        const std::uint32_t prev = flags_.fetch_or(READY, std::memory_order_acq_rel);
+        if (prev & CONTINUATION) {
+            next_->resume(std::move(*result_));
+        }
+        if (prev & WAITING) {
+            notify();
+        }
+    }
+
+    void attach(Continuation<R, E>* next) noexcept {
+        next_ = next;
+        if (flags_.fetch_or(CONTINUATION, std::memory_order_acq_rel) & READY) {
+            next_->resume(std::move(*result_));
+        }
+    }
+
+    [[nodiscard]] bool ready() const noexcept { return flags_.load(std::memory_order_acquire) & READY; }
+
+    // A worker of the pool runs other tasks while it waits, so that waiting inside a task cannot starve the pool
+    void wait() noexcept {
+        while (!ready()) {
+            if (help_one()) {
+                continue;
+            }
+            const std::uint32_t flags = flags_.fetch_or(WAITING, std::memory_order_acq_rel) | WAITING;
+            if (flags & READY) {
+                return;
+            }
+            futex::wait(flags_, flags);
+        }
+    }
+
+    [[nodiscard]] result::Result<R, E> take() noexcept {
+        wait();
+        return std::move(*result_);
+    }
+
+private:
+    static constexpr std::uint32_t READY        = 1;
+    static constexpr std::uint32_t CONTINUATION = 2;
+    static constexpr std::uint32_t WAITING      = 4;
+
+    void notify() noexcept { futex::wake_all(flags_); }
+
+    std::atomic<std::uint32_t> refs_;
+    std::atomic<std::uint32_t> flags_{0};
+    std::optional<result::Result<R, E>> result_;
+    Continuation<R, E>* next_ = nullptr;
+};
+
+// A submitted function, the task and the state of its Future in one allocation
+template <typename F, typename R, typename E>
+class TaskState final : public State<R, E>, public Task {
+public:
+    explicit TaskState(F&& func) : State<R, E>(2), func_(std::move(func)) {}
+
+    void run() noexcept override {
+        this->complete(func_());
+        this->release();
+    }
+
+private:
+    F func_;
+};
+
+// A continuation and the state of the Future it returns, func maps the upstream Result to this one's
+template <typename F, typename R, typename E, typename Rn, typename En>
+class ThenState final : public State<Rn, En>, public Continuation<R, E> {
+public:
+    explicit ThenState(F&& func) : State<Rn, En>(2), func_(std::move(func)) {}
+
+    void resume(result::Result<R, E>&& result) noexcept override {
+        this->complete(func_(std::move(result)));
+        this->release();
+    }
+
+private:
+    F func_;
+};
+
+// A continuation ending a chain, nothing waits for it
+template <typename F, typename R, typename E>
+class SinkState final : public Continuation<R, E> {
+public:
+    explicit SinkState(F&& func) : func_(std::move(func)) {}
+
+    void resume(result::Result<R, E>&& result) noexcept override {
+        func_(std::move(result));
+        delete this;
+    }
+
+private:
+    F func_;
+};
+}  // namespace detail
+
+// Result of a task running on a ThreadPool. Futures are move only, the combinators and get consume them.
+template <typename R, typename E>
+class Future {
+public:
+    using result_type = R;
+    using error_type  = E;
+
+    Future() noexcept = default;
+
+    Future(Future&& other) noexcept : state_(std::exchange(other.state_, nullptr)) {}
+
+    Future& operator=(Future&& other) noexcept {
+        if (this != &other) {
+            reset();
+            state_ = std::exchange(other.state_, nullptr);
+        }
+        return *this;
+    }
+
+    Future(const Future&)            = delete;
+    Future& operator=(const Future&) = delete;
+
+    ~Future() { reset(); }
+
+    // False for a default constructed or consumed Future
+    [[nodiscard]] bool valid() const noexcept { return state_ != nullptr; }
+
+    [[nodiscard]] bool is_ready() const noexcept { return state_->ready(); }
+
+    void wait() const noexcept { state_->wait(); }
+
+    // Blocks until the Result is available, on a worker thread other tasks are run meanwhile
+    [[nodiscard]] result::Result<R, E> get() && noexcept {
+        auto result = state_->take();
+        reset();
+        return result;
+    }
+
+    // The combinators of Result, applied to the Result once it is available, see Result for their signatures
+    template <typename F>
+    [[nodiscard]] auto and_then(F&& func) && {
+        return std::move(*this).then([func = std::forward<F>(func)](result::Result<R, E>&& result) mutable {
+            return std::move(result).and_then(std::move(func));
+        });
+    }
+
+    template <typename F>
+    [[nodiscard]] auto map(F&& func) && {
+        return std::move(*this).then([func = std::forward<F>(func)](result::Result<R, E>&& result) mutable {
+            return std::move(result).map(std::move(func));
+        });
+    }
+
+    template <typename F>
+    [[nodiscard]] auto map_err(F&& func) && {
+        return std::move(*this).then([func = std::forward<F>(func)](result::Result<R, E>&& result) mutable {
+            return std::move(result).map_err(std::move(func));
+        });
+    }
+
+    template <typename F>
+    [[nodiscard]] auto or_else(F&& func) && {
+        return std::move(*this).then([func = std::forward<F>(func)](result::Result<R, E>&& result) mutable {
+            return std::move(result).or_else(std::move(func));
+        });
+    }
+
+    // Ends the chain, one of the functors is run with the payload once it is available and its return is discarded
+    template <typename OkF, typename ErrF>
+    void match(OkF&& ok_func, ErrF&& err_func) && {
+        auto sink = [ok_func = std::forward<OkF>(ok_func),
+                     err_func = std::forward<ErrF>(err_func)](result::Result<R, E>&& result) mutable {
+            static_cast<void>(std::move(result).match(std::move(ok_func), std::move(err_func)));
+        };
+        state_->attach(new detail::SinkState<decltype(sink), R, E>(std::move(sink)));
+        reset();
+    }
+
+    // then<Func>(Func&& f) -> Future<U, F>
+    // where f(Result<R, E>&& r) -> Result<U, F>
+    // The general continuation the others are built on, f gets the whole Result.
+    template <typename F>
+    [[nodiscard]] auto then(F&& func) && {
+        using Fn  = std::decay_t<F>;
+        using Res = std::invoke_result_t<Fn&, result::Result<R, E>&&>;
+        static_assert(traits::is_result_v<Res>, "a continuation must return a Result");
+        using Rn = typename Res::result_type;
+        using En = typename Res::error_type;
+
+        auto* next = new detail::ThenState<Fn, R, E, Rn, En>(Fn(std::forward<F>(func)));
+        state_->attach(next);
+        reset();
+        return Future<Rn, En>{next};
+    }
+
+private:
+    friend class ThreadPool;
+
+    template <typename Rx, typename Ex>
+    friend class Future;
+
+    explicit Future(detail::State<R, E>* state) noexcept : state_(state) {}
+
+    void reset() noexcept {
+        if (state_ != nullptr) {
+            std::exchange(state_, nullptr)->release();
+        }
+    }
+
+    detail::State<R, E>* state_ = nullptr;
+};
+
+class ThreadPool {
+public:
+    // 0 threads for std::thread::hardware_concurrency()
+    explicit ThreadPool(std::size_t threads = 0) {
+        threads = threads != 0 ? threads : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        workers_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back(std::make_unique<Worker>());
+        }
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers_[i]->thread = std::thread([this, i] { work(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Runs every task submitted so far, including the ones they submit, before joining the workers
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_.store(true, std::memory_order_seq_cst);
+        }
+        sleep_cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker->thread.join();
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return workers_.size(); }
+
+    // submit<Func>(Func&& f) -> Future<R, E>
+    // where f() -> Result<R, E>
+    // Schedules f on the pool. Submitted from a worker it goes to the worker's own deque, which is run last in first
+    // out and stolen from first in first out.
+    template <typename F>
+    [[nodiscard]] auto submit(F&& func) {
+        using Fn  = std::decay_t<F>;
+        using Res = std::invoke_result_t<Fn&>;
+        static_assert(traits::is_result_v<Res>, "a submitted function must return a Result");
+        using R = typename Res::result_type;
+        using E = typename Res::error_type;
+
+        auto* task = new detail::TaskState<Fn, R, E>(Fn(std::forward<F>(func)));
+        schedule(task);
+        return Future<R, E>{task};
+    }
+
+private:
+    friend bool detail::help_one() noexcept;
+
+    template <typename E>
+    friend class Graph;
+
+    struct alignas(CACHE_LINE) Worker {
+        detail::WorkDeque deque;
+        std::thread thread;
+    };
+
+    void schedule(detail::Task* task) {
+        if (detail::current_worker.pool == this) {
+            workers_[detail::current_worker.worker]->deque.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(inject_mutex_);
+            inject(task);
+        }
+        // Pairs with the sleeping worker's check of the queues, either it sees the task or this sees it sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_seq_cst) != 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            sleep_cv_.notify_one();
+        }
+    }
+
+    // Appends to the shared queue, a ring that only allocates when it grows. Called with inject_mutex_ held.
+    void inject(detail::Task* task) {
+        const std::size_t size = injected_size_.load(std::memory_order_relaxed);
+        UNLIKELY_IF(size == injected_.size()) {
+            std::vector<detail::Task*> bigger(std::max<std::size_t>(injected_.size() * 2, 64));
+            for (std::size_t i = 0; i < size; ++i) {
+                bigger[i] = injected_[(injected_head_ + i) & (injected_.size() - 1)];
+            }
+            injected_      = std::move(bigger);
+            injected_head_ = 0;
+        }
+        injected_[(injected_head_ + size) & (injected_.size() - 1)] = task;
+        injected_size_.store(size + 1, std::memory_order_seq_cst);
+    }
+
+    // The worker's own tasks first, then the shared queue, then the other workers
+    detail::Task* find_task(const std::size_t self) noexcept {
+        if (detail::Task* task = workers_[self]->deque.pop()) {
+            return task;
+        }
+        if (injected_size_.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(inject_mutex_);
+            const std::size_t size = injected_size_.load(std::memory_order_relaxed);
+            if (size != 0) {
+                detail::Task* task = injected_[injected_head_];
+                injected_head_     = (injected_head_ + 1) & (injected_.size() - 1);
+                injected_size_.store(size - 1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        for (std::size_t i = 1; i < workers_.size(); ++i) {
+            if (detail::Task* task = workers_[(self + i) % workers_.size()]->deque.steal()) {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] bool has_work() noexcept {
+        if (injected_size_.load(std::memory_order_seq_cst) != 0) {
+            return true;
+        }
+        for (const auto& worker : workers_) {
+            if (!worker->deque.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(const std::size_t self) {
+        detail::current_worker = detail::WorkerContext{this, self};
+
+        constexpr int SPINS = 64;
+        int idle            = 0;
+        while (true) {
+            if (detail::Task* task = find_task(self)) {
+                task->run();
+                idle = 0;
+                continue;
+            }
+            if (++idle < SPINS) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleeping_.fetch_add(1, std::memory_order_seq_cst);
+            while (!has_work()) {
+                if (stop_.load(std::memory_order_seq_cst)) {
+                    sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+                    return;
+                }
+                sleep_cv_.wait(lock);
+            }
+            sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+            idle = 0;
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex inject_mutex_;
+    std::vector<detail::Task*> injected_;
+    std::size_t injected_head_ = 0;
+    std::atomic<std::size_t> injected_size_{0};
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> sleeping_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+};
+
+namespace detail {
+inline bool help_one() noexcept {
+    ThreadPool* pool = current_worker.pool;
+    if (pool == nullptr) {
+        return false;
+    }
+    Task* task = pool->find_task(current_worker.worker);
+    if (task == nullptr) {
+        return false;
+    }
+    task->run();
+    return true;
+}
+}  // namespace detail
+
+}  // namespace executor
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
@@ -0,0 +1,366 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utils/compatibility.hxx>
+#include <utils/location.hxx>
+
+namespace cogle {
+namespace utils {
+namespace recorder {
+
+// The flight recorder keeps the most recent errors of every thread in a memory mapped file so that they survive the
+// process dying in abort::abort. It is opt in, define COGLE_FLIGHT_RECORDER in every translation unit to log each
+// user constructed Err<E> and each failed cogle_assert, then call FlightRecorder::open early in main.
+//
+// File layout, all integers in host byte order:
+//     FileHeader | RingHeader 0 | Entry[capacity] | RingHeader 1 | Entry[capacity] | ...
+// Every thread claims one ring on its first record and is its only writer, the ring head is published after the entry
+// has been written so a crash can at worst lose the entry that was being written. Once a ring has wrapped the oldest
+// entry is overwritten in place, its sequence is cleared first and set again last so that readers skip it meanwhile.
+
+static constexpr char MAGIC[8]                    = {'C', 'O', 'G', 'L', 'E', 'F', 'R', '\0'};
+static constexpr std::uint32_t VERSION             = 2;
+static constexpr std::size_t PAYLOAD_CAPACITY      = 32;
+static constexpr std::size_t FILE_CAPACITY         = 40;
+static constexpr std::size_t FUNCTION_CAPACITY     = 24;
+static constexpr std::uint32_t DEFAULT_CAPACITY    = 1024;
+static constexpr std::uint32_t DEFAULT_MAX_THREADS = 64;
+
+enum class EntryKind : std::uint8_t { ERR = 0, ASSERT = 1 };
+
+enum class TimestampSource : std::uint32_t { STEADY_CLOCK_NS = 0, TSC = 1 };
+
+struct Entry {
+    std::uint64_t timestamp;
+    std::uint32_t line;
+    std::int32_t column;
+    std::uint32_t thread_id;
+    // sizeof the error before truncation, 0 when the error is not trivially copyable
+    std::uint32_t error_size;
+    EntryKind kind;
+    std::uint8_t payload_size;
+    std::uint8_t reserved[2];
+    // The low 32 bits of the ring head once the entry is written, 0 while it is being written. Accessed atomically.
+    std::uint32_t sequence;
+    // The raw bytes of the error for ERR entries, the start of the message for ASSERT entries
+    unsigned char payload[PAYLOAD_CAPACITY];
+    // The tail of the file name and the start of the function name, both NUL terminated
+    char file[FILE_CAPACITY];
+    char function[FUNCTION_CAPACITY];
+};
+
+static_assert(sizeof(Entry) == 128, "Entries are expected to be two cache lines");
+static_assert(std::is_trivially_copyable_v<Entry>, "Entries are read back from the file as is");
+
+struct alignas(64) FileHeader {
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version;
+    std::uint32_t entry_size;
+    // Entries per ring, a power of two
+    std::uint32_t capacity;
+    std::uint32_t max_threads;
+    // Number of rings claimed so far, may exceed max_threads
+    std::atomic<std::uint32_t> threads;
+    TimestampSource timestamp_source;
+    // Timestamp and CLOCK_REALTIME in ns taken when the file was opened, relates entry timestamps to wall time
+    std::uint64_t open_timestamp;
+    std::uint64_t open_realtime_ns;
+};
+
+struct alignas(64) RingHeader {
+    // Number of entries ever written to the ring, the newest one is at (head - 1) % capacity
+    std::atomic<std::uint64_t> head;
+    std::uint32_t thread_id;
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free,
+              "The recorder file is shared through lock free atomics");
+
+namespace detail {
+inline std::uint64_t timestamp() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+}
+
+// The sequence of the entry written when the ring head was head, never 0 within 2^32 entries of the head
+constexpr std::uint32_t sequence_of(const std::uint64_t head) noexcept { return static_cast<std::uint32_t>(head + 1); }
+
+constexpr TimestampSource timestamp_source() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return TimestampSource::TSC;
+#else
+    return TimestampSource::STEADY_CLOCK_NS;
+#endif
+}
+
+constexpr std::size_t ring_stride(const std::uint32_t capacity) noexcept {
+    return sizeof(RingHeader) + static_cast<std::size_t>(capacity) * sizeof(Entry);
+}
+
+constexpr std::size_t file_size(const std::uint32_t capacity, const std::uint32_t max_threads) noexcept {
+    return sizeof(FileHeader) + static_cast<std::size_t>(max_threads) * ring_stride(capacity);
+}
+
+template <typename Byte>
+Byte* ring_at(Byte* base, const std::uint32_t capacity, const std::uint32_t idx) noexcept {
+    return base + sizeof(FileHeader) + static_cast<std::size_t>(idx) * ring_stride(capacity);
+}
+
+// Copies at most cap - 1 characters from the start of src
+inline void copy_head(char* dst, const std::size_t cap, const char* src) noexcept {
+    const std::size_t len = ::strnlen(src, cap - 1);
+    std::memcpy(dst, src, len);
+    dst[len] = '\0';
+}
+
+// Copies at most cap - 1 characters from the end of src, the end of a path is its most telling part
+inline void copy_tail(char* dst, const std::size_t cap, const char* src) noexcept {
+    const std::size_t len = std::strlen(src);
+    const std::size_t n   = len < cap ? len : cap - 1;
+    std::memcpy(dst, src + (len - n), n);
+    dst[n] = '\0';
+}
+}  // namespace detail
+
+class FlightRecorder {
+public:
+    // Creates or truncates the file at path and starts recording into it. Returns 0 on success or an errno value.
+    // capacity is the number of entries kept per thread and must be a power of two, threads beyond max_threads are
+    // not recorded.
+    static int open(const char* path, const std::uint32_t capacity = DEFAULT_CAPACITY,
+                    const std::uint32_t max_threads = DEFAULT_MAX_THREADS) noexcept {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0 || max_threads == 0) {
+            return EINVAL;
+        }
+
+        if (header_.load(std::memory_order_acquire) != nullptr) {
+            return EBUSY;
+        }
+
+        const std::size_t size = detail::file_size(capacity, max_threads);
+
+        const int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return errno;
+        }
+
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            const int err = errno;
+            ::close(fd);
+            return err;
+        }
+
+        void* base    = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int err = errno;
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            return err;
+        }
+
+        auto* header             = new (base) FileHeader{};
+        header->version          = VERSION;
+        header->entry_size       = sizeof(Entry);
+        header->capacity         = capacity;
+        header->max_threads      = max_threads;
+        header->timestamp_source = detail::timestamp_source();
+        header->open_timestamp   = detail::timestamp();
+        header->open_realtime_ns = realtime_ns();
+
+        for (std::uint32_t i = 0; i < max_threads; ++i) {
+            new (detail::ring_at(static_cast<unsigned char*>(base), capacity, i)) RingHeader{};
+        }
+
+        // The magic is written last, a file without it was never fully initialized
+        std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+
+        mapped_size_ = size;
+        header_.store(header, std::memory_order_release);
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        return 0;
+    }
+
+    // Stops recording and unmaps the file. Must not race with threads that are still recording.
+    static void close() noexcept {
+        FileHeader* header = header_.exchange(nullptr, std::memory_order_acq_rel);
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        if (header != nullptr) {
+            ::munmap(header, mapped_size_);
+        }
+    }
+
+    [[nodiscard]] static bool is_open() noexcept { return header_.load(std::memory_order_acquire) != nullptr; }
+
+    static void record(const EntryKind kind, const location::SourceLocation& sl, const void* payload,
+                       const std::size_t payload_size, const std::uint32_t error_size) noexcept {
+        RingHeader* ring = thread_ring();
+        UNLIKELY_IF(ring == nullptr) { return; }
+
+        const std::uint32_t capacity = header_.load(std::memory_order_relaxed)->capacity;
+        const std::uint64_t head     = ring->head.load(std::memory_order_relaxed);
+
+        Entry& entry = entries(ring)[head & (capacity - 1)];
+        __atomic_store_n(&entry.sequence, 0, __ATOMIC_RELAXED);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        entry.timestamp    = detail::timestamp();
+        entry.line         = static_cast<std::uint32_t>(sl.line());
+        entry.column       = sl.column();
+        entry.thread_id    = ring->thread_id;
+        entry.error_size   = error_size;
+        entry.kind         = kind;
+        entry.payload_size = static_cast<std::uint8_t>(payload_size);
+        if (payload_size != 0) {
+            std::memcpy(entry.payload, payload, payload_size);
+        }
+        detail::copy_tail(entry.file, FILE_CAPACITY, sl.file_name());
+        detail::copy_head(entry.function, FUNCTION_CAPACITY, sl.function_name());
+
+        __atomic_store_n(&entry.sequence, detail::sequence_of(head), __ATOMIC_RELEASE);
+        ring->head.store(head + 1, std::memory_order_release);
+    }
+
+private:
+    static std::uint64_t realtime_ns() noexcept {
+        timespec ts{};
+        ::clock_gettime(CLOCK_REALTIME, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000u + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+    static Entry* entries(RingHeader* ring) noexcept {
+        return reinterpret_cast<Entry*>(reinterpret_cast<unsigned char*>(ring) + sizeof(RingHeader));
+    }
+
+    // The calling thread's ring, claimed on first use. nullptr when the recorder is closed or all rings are taken.
+    static RingHeader* thread_ring() noexcept {
+        thread_local RingHeader* ring              = nullptr;
+        thread_local std::uint64_t ring_generation = 0;
+
+        const std::uint64_t generation = generation_.load(std::memory_order_acquire);
+        LIKELY_IF(ring_generation == generation) { return ring; }
+
+        ring_generation = generation;
+        ring            = claim_ring();
+        return ring;
+    }
+
+    static RingHeader* claim_ring() noexcept {
+        FileHeader* header = header_.load(std::memory_order_acquire);
+        if (header == nullptr) {
+            return nullptr;
+        }
+
+        const std::uint32_t idx = header->threads.fetch_add(1, std::memory_order_relaxed);
+        if (idx >= header->max_threads) {
+            return nullptr;
+        }
+
+        auto* ring = reinterpret_cast<RingHeader*>(
+            detail::ring_at(reinterpret_cast<unsigned char*>(header), header->capacity, idx));
+        ring->thread_id = static_cast<std::uint32_t>(::syscall(SYS_gettid));
+        return ring;
+    }
+
+    inline static std::atomic<FileHeader*> header_{nullptr};
+    inline static std::atomic<std::uint64_t> generation_{0};
+    inline static std::size_t mapped_size_{0};
+};
+
+// Read only view of a recorder file, e.g. one left behind by a process that has crashed.
+class RecordingView {
+public:
+    RecordingView(const void* base, const std::size_t size) noexcept
+        : base_(static_cast<const unsigned char*>(base)), size_(size) {}
+
+    // True when the file carries a fully initialized header of this version and is large enough for its rings
+    [[nodiscard]] bool valid() const noexcept {
+        if (size_ < sizeof(FileHeader)) {
+            return false;
+        }
+        const FileHeader& h = header();
+        return std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) == 0 && h.version == VERSION &&
+               h.entry_size == sizeof(Entry) && h.capacity != 0 && (h.capacity & (h.capacity - 1)) == 0 &&
+               size_ >= detail::file_size(h.capacity, h.max_threads);
+    }
+
+    [[nodiscard]] const FileHeader& header() const noexcept { return *reinterpret_cast<const FileHeader*>(base_); }
+
+    [[nodiscard]] std::uint32_t ring_count() const noexcept {
+        const std::uint32_t threads = header().threads.load(std::memory_order_acquire);
+        return threads < header().max_threads ? threads : header().max_threads;
+    }
+
+    [[nodiscard]] const RingHeader& ring(const std::uint32_t idx) const noexcept {
+        return *reinterpret_cast<const RingHeader*>(detail::ring_at(base_, header().capacity, idx));
+    }
+
+    // Calls func(const Entry&) with a copy of every entry still held by the ring, oldest first. Entries that are being
+    // written, or were overwritten while being copied, are skipped.
+    template <typename F>
+    void for_each_entry(const std::uint32_t idx, F&& func) const {
+        const RingHeader& r          = ring(idx);
+        const std::uint32_t capacity = header().capacity;
+        const std::uint64_t head     = r.head.load(std::memory_order_acquire);
+        const std::uint64_t count    = head < capacity ? head : capacity;
+        const auto* ring_entries =
+            reinterpret_cast<const Entry*>(reinterpret_cast<const unsigned char*>(&r) + sizeof(RingHeader));
+
+        for (std::uint64_t i = head - count; i < head; ++i) {
+            const Entry& entry           = ring_entries[i & (capacity - 1)];
+            const std::uint32_t sequence = detail::sequence_of(i);
+            if (__atomic_load_n(&entry.sequence, __ATOMIC_ACQUIRE) != sequence) {
+                continue;
+            }
+            Entry copy;
+            std::memcpy(&copy, &entry, sizeof(Entry));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (__atomic_load_n(&entry.sequence, __ATOMIC_RELAXED) != sequence) {
+                continue;
+            }
+            func(static_cast<const Entry&>(copy));
+        }
+    }
+
+private:
+    const unsigned char* base_;
+    std::size_t size_;
+};
+
+// Hooks used by Err and abort when COGLE_FLIGHT_RECORDER is defined, nothing is recorded during constant evaluation.
+template <typename E>
+constexpr void record_err(const E& err, const location::SourceLocation& sl) noexcept {
+    if (__builtin_is_constant_evaluated()) {
+        return;
+    }
+
+    if constexpr (std::is_trivially_copyable_v<E>) {
+        constexpr std::size_t size = sizeof(E) < PAYLOAD_CAPACITY ? sizeof(E) : PAYLOAD_CAPACITY;
+        FlightRecorder::record(EntryKind::ERR, sl, &err, size, static_cast<std::uint32_t>(sizeof(E)));
+    } else {
+        FlightRecorder::record(EntryKind::ERR, sl, nullptr, 0, 0);
+    }
+}
+
+inline void record_assert(const char* message, const location::SourceLocation& sl) noexcept {
+    FlightRecorder::record(EntryKind::ASSERT, sl, message, ::strnlen(message, PAYLOAD_CAPACITY), 0);
+}
+
+}  // namespace recorder
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+// Sleeping on a 32 bit word until another thread changes it, shared by the blocking paths of the concurrent utilities.
+//
+//     // Waiter
+//     while (word.load(std::memory_order_acquire) == seen) {
+//         futex::wait(word, seen);
+//     }
+//     // Waker
+//     word.store(seen + 1, std::memory_order_release);
+//     futex::wake_all(word);
+//
+// Linux sleeps on the word itself through the futex system call. Elsewhere C++20 atomic waits are used when the
+// standard library has them, otherwise a condition variable picked by the address of the word. wait may return
+// spuriously, callers check the word again in a loop. A word may be woken after the object holding it is gone, none of
+// the implementations touch it then.
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace cogle {
+namespace utils {
+namespace futex {
+
+namespace detail {
+#if !defined(__linux__) && !defined(__cpp_lib_atomic_wait)
+struct Bucket {
+    std::mutex mutex;
+    std::condition_variable sleepers;
+};
+
+// Words sharing a bucket wake each other, which wait allows for
+inline Bucket& bucket(const void* word) noexcept {
+    static constexpr std::size_t BUCKETS = 64;
+    static Bucket buckets[BUCKETS];
+    return buckets[(reinterpret_cast<std::uintptr_t>(word) / sizeof(std::uint32_t)) % BUCKETS];
+}
+#endif
+}  // namespace detail
+
+// Sleeps while word holds expected, may return spuriously
+inline void wait(std::atomic<std::uint32_t>& word, const std::uint32_t expected) noexcept {
+#if defined(__linux__)
+    static_cast<void>(::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected,
+                                nullptr, nullptr, 0));
+#elif defined(__cpp_lib_atomic_wait)
+    word.wait(expected, std::memory_order_acquire);
+#else
+    detail::Bucket& bucket = detail::bucket(&word);
+    std::unique_lock<std::mutex> lock{bucket.mutex};
+    if (word.load(std::memory_order_acquire) == expected) {
+        bucket.sleepers.wait(lock);
+    }
+#endif
+}
+
+// Wakes up to count threads sleeping on word, to be called after changing it
+inline void wake(std::atomic<std::uint32_t>& word, const std::size_t count) noexcept {
+#if defined(__linux__)
+    const int waiters = count < static_cast<std::size_t>(INT_MAX) ? static_cast<int>(count) : INT_MAX;
+    static_cast<void>(::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, waiters,
+                                nullptr, nullptr, 0));
+#elif defined(__cpp_lib_atomic_wait)
+    if (count == 1) {
+        word.notify_one();
+    } else {
+        word.notify_all();
+    }
+#else
+    static_cast<void>(count);
+    detail::Bucket& bucket = detail::bucket(&word);
+    // A waiter has either not checked the word yet or is already asleep once the lock is free
+    {
+        std::lock_guard<std::mutex> lock{bucket.mutex};
+    }
+    bucket.sleepers.notify_all();
+#endif
+}
+
+inline void wake_all(std::atomic<std::uint32_t>& word) noexcept { wake(word, static_cast<std::size_t>(INT_MAX)); }
+
+}  // namespace futex
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
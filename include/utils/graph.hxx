@@ -0,0 +1,375 @@
+#pragma once
+
+// Dependency graph of functions returning Result, run on a ThreadPool.
+//
+//     Graph<Error> graph;
+//     auto a = graph.add([] { return fetch_a(); });
+//     auto b = graph.add([] { return fetch_b(); });
+//     auto c = graph.add([](const A& a, const B& b) { return combine(a, b); }, a, b);
+//     auto d = graph.add([](const C& c) { return render(c); }, c);
+//     Result<void, GraphError<Error>> done = graph.run(pool);
+//     const Page& page = d.value();
+//
+// A node is called with the results of its parents, in the order they were given, once all of them succeeded. Parents
+// returning void only order the nodes and pass nothing. Nodes without a pending parent run in parallel. A node
+// returning an error cancels its descendants, which are skipped, while the nodes not depending on it still run. The
+// run returns the first error with the id of the node returning it. As for ThreadPool::submit, node functions must not
+// throw.
+//
+// Nodes, their edges and their results live in an arena owned by the graph. A graph is built once and may be run any
+// number of times, a run resets the results of the previous one and does not allocate.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <utils/abort.hxx>
+#include <utils/compatibility.hxx>
+#include <utils/executor.hxx>
+#include <utils/futex.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+namespace cogle {
+namespace utils {
+namespace executor {
+
+template <typename E>
+struct GraphError {
+    // Id of the failing node, nodes are numbered in the order they are added
+    std::size_t node;
+    E error;
+};
+
+template <typename R, typename E>
+class NodeRef;
+
+namespace detail {
+// Monotonic allocator, memory is released all at once with the arena
+class GraphArena {
+public:
+    GraphArena() noexcept = default;
+
+    GraphArena(const GraphArena&)            = delete;
+    GraphArena& operator=(const GraphArena&) = delete;
+
+    [[nodiscard]] void* allocate(const std::size_t size, const std::size_t align) {
+        std::size_t offset = aligned_offset(align);
+        UNLIKELY_IF(blocks_.empty() || offset + size > capacity_) {
+            capacity_ = std::max(BLOCK_SIZE, size + align);
+            blocks_.emplace_back(new std::byte[capacity_]);
+            used_  = 0;
+            offset = aligned_offset(align);
+        }
+        used_ = offset + size;
+        return blocks_.back().get() + offset;
+    }
+
+    template <typename T, typename... Args>
+    [[nodiscard]] T* make(Args&&... args) {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+private:
+    static constexpr std::size_t BLOCK_SIZE = 4096;
+
+    // Offset of the first free address of the current block aligned to align. Blocks only have the alignment of new,
+    // so the offset follows from the address rather than from used_ alone.
+    [[nodiscard]] std::size_t aligned_offset(const std::size_t align) const noexcept {
+        const auto base = reinterpret_cast<std::uintptr_t>(blocks_.empty() ? nullptr : blocks_.back().get());
+        return static_cast<std::size_t>(((base + used_ + align - 1) & ~static_cast<std::uintptr_t>(align - 1)) - base);
+    }
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks_;
+    std::size_t used_     = 0;
+    std::size_t capacity_ = 0;
+};
+
+template <typename E>
+class NodeBase;
+
+template <typename E>
+struct Edge {
+    NodeBase<E>* node;
+    Edge* next;
+};
+
+template <typename E>
+class NodeBase : public Task {
+public:
+    NodeBase(Graph<E>& graph, const std::size_t id, const std::uint32_t parents) noexcept
+        : graph_(graph), id_(id), parents_(parents) {}
+
+    NodeBase(const NodeBase&)            = delete;
+    NodeBase& operator=(const NodeBase&) = delete;
+
+    virtual ~NodeBase() = default;
+
+    // Runs the node unless it was cancelled, then releases its children
+    void run() noexcept override;
+
+    [[nodiscard]] std::size_t id() const noexcept { return id_; }
+
+protected:
+    // Calls the function, false and the error reported to the graph if it fails
+    virtual bool evaluate() noexcept = 0;
+
+    // Drops the result of the previous run
+    virtual void reset() noexcept = 0;
+
+    Graph<E>& graph_;
+
+private:
+    friend class Graph<E>;
+
+    const std::size_t id_;
+    const std::uint32_t parents_;
+    std::atomic<std::uint32_t> pending_{0};
+    // Set by a parent that failed or was cancelled before it releases the node
+    std::atomic<bool> cancelled_{false};
+    Edge<E>* children_  = nullptr;
+    NodeBase* next_node_ = nullptr;
+};
+
+// A node producing R, what its children and NodeRef read
+template <typename R, typename E>
+class ValueNode : public NodeBase<E> {
+public:
+    using NodeBase<E>::NodeBase;
+
+    // A tuple holding a reference to the result, an empty tuple for void
+    [[nodiscard]] auto argument() const noexcept {
+        if constexpr (std::is_void_v<R>) {
+            return std::tuple<>{};
+        } else {
+            return std::tuple<const R&>{*value_};
+        }
+    }
+
+protected:
+    friend class NodeRef<R, E>;
+
+    void reset() noexcept override { value_.reset(); }
+
+    std::optional<std::conditional_t<std::is_void_v<R>, bool, R>> value_;
+};
+
+template <typename F, typename R, typename E, typename... Rs>
+class Node final : public ValueNode<R, E> {
+public:
+    Node(Graph<E>& graph, const std::size_t id, F&& func, ValueNode<Rs, E>*... parents)
+        : ValueNode<R, E>(graph, id, sizeof...(Rs)), func_(std::move(func)), parents_(parents...) {}
+
+protected:
+    bool evaluate() noexcept override {
+        auto arguments = std::apply([](auto*... parents) { return std::tuple_cat(parents->argument()...); }, parents_);
+        auto result    = std::apply(func_, arguments);
+        UNLIKELY_IF(result.is_err()) {
+            this->graph_.fail(this->id(), std::move(result).error_unchecked());
+            return false;
+        }
+        if constexpr (std::is_void_v<R>) {
+            this->value_.emplace(true);
+        } else {
+            this->value_.emplace(std::move(result).unwrap_unchecked());
+        }
+        return true;
+    }
+
+private:
+    F func_;
+    std::tuple<ValueNode<Rs, E>*...> parents_;
+};
+}  // namespace detail
+
+// Handle to a node of a Graph, valid as long as the graph
+template <typename R, typename E>
+class NodeRef {
+public:
+    [[nodiscard]] std::size_t id() const noexcept { return node_->id(); }
+
+    // Whether the node succeeded in the last run
+    [[nodiscard]] bool has_value() const noexcept { return node_->value_.has_value(); }
+
+    // The result of the node in the last run, which must have succeeded
+    template <typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
+    [[nodiscard]] const X& value() const {
+        COGLE_ASSERT(has_value(), "NodeRef::value() of a node without a result");
+        return *node_->value_;
+    }
+
+private:
+    friend class Graph<E>;
+
+    explicit NodeRef(detail::ValueNode<R, E>* node) noexcept : node_(node) {}
+
+    detail::ValueNode<R, E>* node_;
+};
+
+template <typename E>
+class Graph {
+public:
+    Graph() = default;
+
+    Graph(const Graph&)            = delete;
+    Graph& operator=(const Graph&) = delete;
+
+    ~Graph() {
+        for (detail::NodeBase<E>* node = nodes_; node != nullptr;) {
+            detail::NodeBase<E>* next = node->next_node_;
+            node->~NodeBase();
+            node = next;
+        }
+    }
+
+    // add<Func, Rs...>(Func&& f, NodeRef<Rs, E>... parents) -> NodeRef<R, E>
+    // where f(const Rs&...) -> Result<R, E>, with the void Rs left out
+    template <typename F, typename... Rs>
+    [[nodiscard]] auto add(F&& func, const NodeRef<Rs, E>&... parents) {
+        using Fn  = std::decay_t<F>;
+        using Res = decltype(std::apply(std::declval<Fn&>(),
+                                        std::tuple_cat(std::declval<detail::ValueNode<Rs, E>&>().argument()...)));
+        static_assert(traits::is_result_v<Res>, "a node must return a Result");
+        static_assert(std::is_same_v<typename Res::error_type, E>, "a node must return the error type of its graph");
+        using R = typename Res::result_type;
+
+        auto* node = arena_.make<detail::Node<Fn, R, E, Rs...>>(*this, size_++, Fn(std::forward<F>(func)),
+                                                                parents.node_...);
+        node->next_node_ = nodes_;
+        nodes_           = node;
+        if constexpr (sizeof...(Rs) == 0) {
+            roots_ = arena_.make<detail::Edge<E>>(detail::Edge<E>{node, roots_});
+        } else {
+            ((parents.node_->children_ = arena_.make<detail::Edge<E>>(detail::Edge<E>{node, parents.node_->children_})),
+             ...);
+        }
+        return NodeRef<R, E>{node};
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    // Runs every node once and returns when the graph is done. The calling thread runs nodes as well, on a worker of
+    // pool it also runs other tasks while it waits. The graph must not be changed or run again before this returns.
+    [[nodiscard]] result::Result<void, GraphError<E>> run(ThreadPool& pool) {
+        error_.reset();
+        failed_.store(false, std::memory_order_relaxed);
+        for (detail::NodeBase<E>* node = nodes_; node != nullptr; node = node->next_node_) {
+            node->reset();
+            node->pending_.store(node->parents_, std::memory_order_relaxed);
+            node->cancelled_.store(false, std::memory_order_relaxed);
+        }
+        if (size_ == 0) {
+            return result::Result<void, GraphError<E>>{result::in_place_ok};
+        }
+
+        pool_ = &pool;
+        done_.store(RUNNING, std::memory_order_relaxed);
+        remaining_.store(size_, std::memory_order_release);
+        // The calling thread takes the first root itself instead of waiting for a worker to wake up
+        for (detail::Edge<E>* root = roots_->next; root != nullptr; root = root->next) {
+            pool.schedule(root->node);
+        }
+        roots_->node->run();
+        wait();
+
+        if (error_) {
+            return result::Result<void, GraphError<E>>{result::in_place_err, std::move(*error_)};
+        }
+        return result::Result<void, GraphError<E>>{result::in_place_ok};
+    }
+
+private:
+    friend class detail::NodeBase<E>;
+
+    template <typename F, typename R, typename Ex, typename... Rs>
+    friend class detail::Node;
+
+    void fail(const std::size_t node, E&& error) noexcept {
+        if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+            error_.emplace(GraphError<E>{node, std::move(error)});
+        }
+    }
+
+    // Schedules the children that became ready but one, which is returned for the caller to run next. The children of
+    // a node without a result are cancelled, the flag is published by the release on pending_.
+    detail::NodeBase<E>* release_children(detail::NodeBase<E>& node, const bool succeeded) {
+        detail::NodeBase<E>* next = nullptr;
+        for (detail::Edge<E>* edge = node.children_; edge != nullptr; edge = edge->next) {
+            if (!succeeded) {
+                edge->node->cancelled_.store(true, std::memory_order_relaxed);
+            }
+            if (edge->node->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                if (next != nullptr) {
+                    pool_->schedule(next);
+                }
+                next = edge->node;
+            }
+        }
+        return next;
+    }
+
+    // Called last by every node. The waiter returns once it sees DONE, the final store of the last node, so that the
+    // notification cannot outlive the graph.
+    void finish_one() noexcept {
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done_.store(NOTIFYING, std::memory_order_release);
+            futex::wake_all(done_);
+            done_.store(DONE, std::memory_order_release);
+        }
+    }
+
+    void wait() noexcept {
+        while (remaining_.load(std::memory_order_acquire) != 0 && detail::help_one()) {
+        }
+        std::uint32_t state = done_.load(std::memory_order_acquire);
+        while (state != DONE) {
+            if (state == RUNNING) {
+                futex::wait(done_, RUNNING);
+            } else {
+                // The last node is between its notification and its final store
+                std::this_thread::yield();
+            }
+            state = done_.load(std::memory_order_acquire);
+        }
+    }
+
+    detail::GraphArena arena_;
+    detail::NodeBase<E>* nodes_ = nullptr;
+    detail::Edge<E>* roots_     = nullptr;
+    std::size_t size_           = 0;
+
+    ThreadPool* pool_ = nullptr;
+    std::optional<GraphError<E>> error_;
+    alignas(CACHE_LINE) std::atomic<bool> failed_{false};
+    alignas(CACHE_LINE) std::atomic<std::size_t> remaining_{0};
+    static constexpr std::uint32_t RUNNING   = 0;
+    static constexpr std::uint32_t NOTIFYING = 1;
+    static constexpr std::uint32_t DONE      = 2;
+    std::atomic<std::uint32_t> done_{DONE};
+};
+
+namespace detail {
+// Continues with a child that became ready on this thread, like the continuations of a Future. The graph stays alive
+// while that child is pending, after the last node finishes neither it nor the graph are touched again.
+template <typename E>
+void NodeBase<E>::run() noexcept {
+    Graph<E>& graph = graph_;
+    for (NodeBase* node = this; node != nullptr;) {
+        const bool succeeded = !node->cancelled_.load(std::memory_order_relaxed) && node->evaluate();
+        NodeBase* next       = graph.release_children(*node, succeeded);
+        graph.finish_one();
+        node = next;
+    }
+}
+}  // namespace detail
+
+}  // namespace executor
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
@@ -1,20 +1,76 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 #include <utils/traits.hxx>
 
+// GCC only gained __builtin_COLUMN in GCC 13, the column is reported as 0 where it is missing.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_COLUMN)
+#define COGLE_HAS_BUILTIN_COLUMN 1
+#define COGLE_BUILTIN_COLUMN()   __builtin_COLUMN()
+#endif
+#endif
+
+#ifndef COGLE_BUILTIN_COLUMN
+#define COGLE_HAS_BUILTIN_COLUMN 0
+#define COGLE_BUILTIN_COLUMN()   0
+#endif
+
+// Evaluates to a const SourceLocation* pointing at a static record in .rodata that describes the call site, so that
+// passing a location around costs a single pointer and nothing is stored on the stack. Relies on GNU statement
+// expressions and cannot be used inside a constexpr function.
+#define COGLE_CURRENT_LOCATION()                                                                            \
+    ({                                                                                                      \
+        static constexpr ::cogle::utils::location::SourceLocation cogle_current_location_ =                 \
+            ::cogle::utils::location::SourceLocation::current(__builtin_FILE(), __func__, __builtin_LINE(), \
+                                                              COGLE_BUILTIN_COLUMN());                      \
+        &cogle_current_location_;                                                                           \
+    })
+
 namespace cogle {
 namespace utils {
 namespace location {
 
 namespace detail {
 static constexpr auto DEFAULT_LOC_CHAR_ARR_VAL = "unknown";
+
+static constexpr bool HAS_BUILTIN_COLUMN = COGLE_HAS_BUILTIN_COLUMN;
+
+// 32 bit FNV-1a
+static constexpr std::uint32_t FNV_OFFSET_BASIS = 2166136261u;
+static constexpr std::uint32_t FNV_PRIME        = 16777619u;
+
+constexpr std::uint32_t fnv1a(std::uint32_t hash, const char* str) noexcept {
+    for (; *str != '\0'; ++str) {
+        hash = (hash ^ static_cast<unsigned char>(*str)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+constexpr std::uint32_t fnv1a(std::uint32_t hash, std::uint32_t val) noexcept {
+    for (int i = 0; i < 4; ++i) {
+        hash = (hash ^ (val & 0xFFu)) * FNV_PRIME;
+        val >>= 8;
+    }
+    return hash;
+}
+
+constexpr bool str_equal(const char* lhs, const char* rhs) noexcept {
+    if (lhs == rhs) {
+        return true;
+    }
+    for (; *lhs != '\0' && *lhs == *rhs; ++lhs, ++rhs) {
+    }
+    return *lhs == *rhs;
+}
 }  // namespace detail
 
 // https://en.cppreference.com/w/cpp/utility/source_location
 // https://github.com/gcc-mirror/gcc/blob/master/libstdc%2B%2B-v3/include/experimental/source_location
 struct SourceLocation {
     using line_t = typename std::remove_cv<decltype(__builtin_LINE())>::type;
+    using id_t   = std::uint32_t;
 
 public:
     constexpr SourceLocation() noexcept
@@ -23,7 +79,7 @@ public:
 
     static constexpr SourceLocation current(const char* file = __builtin_FILE(),
                                             const char* func = __builtin_FUNCTION(), line_t line = __builtin_LINE(),
-                                            int col = 0) noexcept {
+                                            int col = COGLE_BUILTIN_COLUMN()) noexcept {
         SourceLocation sl{};
 
         sl.file_ = file;
@@ -40,6 +96,22 @@ public:
     constexpr const char* file_name() const noexcept { return file_; }
     constexpr const char* function_name() const noexcept { return func_; }
 
+    // A stable 32 bit id for the location, equal locations hash equally even when their strings live at different
+    // addresses, e.g. in different translation units.
+    constexpr id_t hash() const noexcept {
+        id_t h = detail::fnv1a(detail::FNV_OFFSET_BASIS, file_);
+        h      = detail::fnv1a(h, func_);
+        h      = detail::fnv1a(h, static_cast<std::uint32_t>(line_));
+        return detail::fnv1a(h, static_cast<std::uint32_t>(col_));
+    }
+
+    constexpr bool operator==(const SourceLocation& o) const noexcept {
+        return line_ == o.line_ && col_ == o.col_ && detail::str_equal(file_, o.file_) &&
+               detail::str_equal(func_, o.func_);
+    }
+
+    constexpr bool operator!=(const SourceLocation& o) const noexcept { return !(*this == o); }
+
     friend std::ostream& operator<<(std::ostream& os, const SourceLocation& sl) {
         os << "File: " << sl.file_ << "\tFunc: " << sl.func_ << "\tLine: " << sl.line_ << "\tCol: " << sl.col_;
         return os;
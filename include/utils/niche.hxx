@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utils/abort.hxx>
+
+namespace cogle {
+namespace utils {
+namespace niche {
+
+// niche_traits<R, E> allows a Result<R, E> to encode whether it holds an OK or an ERR inside the payload itself
+// rather than in a separate tag, e.g. Result<int, Errno> is the size of an int.
+//
+// The primary template is disabled, to enable a niche specialize niche_traits for the R, E pair and provide:
+//
+// using storage_type = T;                              // trivially copyable representation
+// static storage_type encode_ok(const R&);             // encode_ok() when R is void
+// static storage_type encode_err(const E&);
+// static bool is_ok(storage_type);
+// static R decode_ok(storage_type);                    // not required when R is void
+// static E decode_err(storage_type);
+//
+// The set of values produced by encode_ok and encode_err must be disjoint. As the payload is decoded on access a
+// niche Result hands out its result and error by value.
+template <typename R, typename E, typename Enabled = void>
+struct niche_traits {};
+
+template <typename R, typename E, typename = void>
+struct is_niche : std::false_type {};
+
+template <typename R, typename E>
+struct is_niche<R, E, std::void_t<typename niche_traits<R, E>::storage_type>> : std::true_type {};
+
+template <typename R, typename E>
+constexpr bool is_niche_v = is_niche<R, E>::value;
+
+namespace detail {
+template <typename T, typename = void>
+struct pointee_alignment : std::integral_constant<std::size_t, 1> {};
+
+// 1 for incomplete types, whose alignment is unknown
+template <typename T>
+struct pointee_alignment<T, std::enable_if_t<std::is_object_v<T>, std::void_t<decltype(sizeof(T))>>>
+    : std::integral_constant<std::size_t, alignof(T)> {};
+
+template <typename T, typename = void>
+struct unsigned_repr {
+    using type = std::make_unsigned_t<T>;
+};
+
+template <typename T>
+struct unsigned_repr<T, std::enable_if_t<std::is_enum_v<T>>> {
+    using type = std::make_unsigned_t<std::underlying_type_t<T>>;
+};
+
+template <typename T>
+using unsigned_repr_t = typename unsigned_repr<T>::type;
+
+template <typename T>
+constexpr bool is_elidable_v =
+    std::is_empty_v<T> && std::is_trivially_copyable_v<T> && std::is_trivially_default_constructible_v<T>;
+
+template <typename E>
+constexpr bool is_small_integral_v =
+    (std::is_enum_v<E> || (std::is_integral_v<E> && !std::is_same_v<E, bool>)) && sizeof(E) < sizeof(std::uintptr_t);
+}  // namespace detail
+
+// Stores the error in the pointer bits with the lowest bit set, which is never set for an aligned T*. This is opt in,
+// as the pointee must be complete and the niche Result then hands out its pointer and error by value:
+// template <>
+// struct niche_traits<Node*, IoError> : PointerTagNiche<Node, IoError> {};
+template <typename T, typename E>
+struct PointerTagNiche {
+    static_assert(detail::pointee_alignment<T>::value >= 2, "Pointer tagging requires a spare low bit");
+    static_assert(detail::is_small_integral_v<E>, "Pointer tagging requires an integral error narrower than a pointer");
+
+    using storage_type = std::uintptr_t;
+
+    static storage_type encode_ok(T* ptr) noexcept { return reinterpret_cast<storage_type>(ptr); }
+
+    static constexpr storage_type encode_err(const E err) noexcept {
+        return (static_cast<storage_type>(static_cast<detail::unsigned_repr_t<E>>(err)) << 1) | TAG_BIT;
+    }
+
+    static constexpr bool is_ok(const storage_type raw) noexcept { return (raw & TAG_BIT) == 0; }
+
+    static T* decode_ok(const storage_type raw) noexcept { return reinterpret_cast<T*>(raw); }
+
+    static constexpr E decode_err(const storage_type raw) noexcept {
+        return static_cast<E>(static_cast<detail::unsigned_repr_t<E>>(raw >> 1));
+    }
+
+private:
+    static constexpr storage_type TAG_BIT = 1;
+};
+
+// A positive errno value, as used by the kernel convention of returning -errno on failure.
+struct Errno {
+    int value;
+
+    [[nodiscard]] constexpr bool operator==(const Errno& o) const noexcept { return value == o.value; }
+    [[nodiscard]] constexpr bool operator!=(const Errno& o) const noexcept { return value != o.value; }
+};
+
+// Stores OK values as is and errors as -errno, the OK value must be non-negative.
+template <typename T>
+struct NegativeErrnoNiche {
+    static_assert(std::is_integral_v<T> && std::is_signed_v<T>, "Negative errno requires a signed integral result");
+
+    using storage_type = T;
+
+    static constexpr storage_type encode_ok(const T val) noexcept {
+        abort::cogle_assert(val >= 0, "Negative errno niche requires a non-negative OK value");
+        return val;
+    }
+
+    static constexpr storage_type encode_err(const Errno err) noexcept {
+        abort::cogle_assert(err.value > 0, "Negative errno niche requires a positive errno");
+        return static_cast<storage_type>(-err.value);
+    }
+
+    static constexpr bool is_ok(const storage_type raw) noexcept { return raw >= 0; }
+
+    static constexpr T decode_ok(const storage_type raw) noexcept { return raw; }
+
+    static constexpr Errno decode_err(const storage_type raw) noexcept { return Errno{static_cast<int>(-raw)}; }
+};
+
+template <typename T>
+struct niche_traits<T, Errno,
+                    std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T) >= sizeof(int))>>
+    : NegativeErrnoNiche<T> {};
+
+// Reserves an enum value that is never used as an error to represent OK in a Result<void, Enum>. This is opt in:
+// template <>
+// struct niche_traits<void, MyEnum> : EnumSentinelNiche<MyEnum, MyEnum::NONE> {};
+template <typename Enum, Enum Sentinel>
+struct EnumSentinelNiche {
+    static_assert(std::is_enum_v<Enum>, "Enum sentinel niche requires an enum error");
+
+    using storage_type = Enum;
+
+    static constexpr storage_type encode_ok() noexcept { return Sentinel; }
+
+    static constexpr storage_type encode_err(const Enum err) noexcept {
+        abort::cogle_assert(err != Sentinel, "Enum sentinel niche error must not be the sentinel");
+        return err;
+    }
+
+    static constexpr bool is_ok(const storage_type raw) noexcept { return raw == Sentinel; }
+
+    static constexpr Enum decode_err(const storage_type raw) noexcept { return raw; }
+};
+
+// Elides the storage of empty payloads, only a single byte discriminator is stored and the empty payload is
+// recreated on access. Used automatically when both sides are empty (or R is void).
+template <typename R, typename E>
+struct EmptyNiche {
+    static_assert(std::is_void_v<R> || detail::is_elidable_v<R>, "Empty niche requires an empty result");
+    static_assert(detail::is_elidable_v<E>, "Empty niche requires an empty error");
+
+    using storage_type = bool;
+
+    static constexpr storage_type encode_ok() noexcept { return true; }
+
+    template <typename U = R>
+    static constexpr storage_type encode_ok(const U&) noexcept {
+        return true;
+    }
+
+    static constexpr storage_type encode_err(const E&) noexcept { return false; }
+
+    static constexpr bool is_ok(const storage_type raw) noexcept { return raw; }
+
+    template <typename U = R>
+    static constexpr U decode_ok(const storage_type) noexcept {
+        return U{};
+    }
+
+    static constexpr E decode_err(const storage_type) noexcept { return E{}; }
+};
+
+template <typename R, typename E>
+struct niche_traits<R, E,
+                    std::enable_if_t<(std::is_void_v<R> || detail::is_elidable_v<R>) && detail::is_elidable_v<E>>>
+    : EmptyNiche<R, E> {};
+
+// Stores a reference as a pointer and an empty error as the null pointer, a Result<T&, E> is then the size of a
+// pointer. Used automatically when E is empty, other errors are stored next to the pointer.
+template <typename T, typename E>
+struct NullReferenceNiche {
+    static_assert(detail::is_elidable_v<E>, "Null reference niche requires an empty error");
+
+    using storage_type = T*;
+
+    static constexpr storage_type encode_ok(T& ref) noexcept { return &ref; }
+
+    static constexpr storage_type encode_err(const E&) noexcept { return nullptr; }
+
+    static constexpr bool is_ok(const storage_type raw) noexcept { return raw != nullptr; }
+
+    static constexpr T& decode_ok(const storage_type raw) noexcept { return *raw; }
+
+    static constexpr E decode_err(const storage_type) noexcept { return E{}; }
+};
+
+template <typename T, typename E>
+struct niche_traits<T&, E, std::enable_if_t<detail::is_elidable_v<E>>> : NullReferenceNiche<T, E> {};
+
+// Stores a reference as a pointer tagged like PointerTagNiche. Used automatically for an integral error when the
+// referent is complete and aligned, a reference is handed out as is whatever its storage.
+template <typename T, typename E>
+struct ReferenceTagNiche : PointerTagNiche<T, E> {
+    using storage_type = std::uintptr_t;
+
+    static storage_type encode_ok(T& ref) noexcept { return PointerTagNiche<T, E>::encode_ok(&ref); }
+
+    static T& decode_ok(const storage_type raw) noexcept { return *PointerTagNiche<T, E>::decode_ok(raw); }
+};
+
+template <typename T, typename E>
+struct niche_traits<T&, E,
+                    std::enable_if_t<(detail::pointee_alignment<T>::value >= 2) && detail::is_small_integral_v<E>>>
+    : ReferenceTagNiche<T, E> {};
+
+}  // namespace niche
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
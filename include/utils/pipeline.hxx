@@ -0,0 +1,235 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <utils/result.hxx>
+
+namespace cogle {
+namespace utils {
+namespace pipeline {
+
+// Lazily fused and_then/map/map_err chains:
+//
+//     using namespace cogle::utils::pipeline;
+//     Result<Report, std::string> report = parse(input) | then(validate) | map(summarize) | map_err(annotate);
+//
+// Chaining the members of Result materializes a Result after every stage and moves the error once per stage. A
+// pipeline instead composes its stages at compile time and only runs when it is converted to its Result or run() is
+// called. Every then costs a single branch, map and map_err none, stages that do not apply to the current state are
+// skipped at compile time. The value or error is passed along by reference and the final Result is constructed once, in
+// place, so an error reaches it by a single move.
+//
+// A pipeline references the Result it was started from, it has to be run in the full expression that created it.
+
+template <typename F>
+struct Then {
+    F func;
+};
+
+template <typename F>
+struct Map {
+    F func;
+};
+
+template <typename F>
+struct MapErr {
+    F func;
+};
+
+// A sequence of stages that is not yet bound to a Result, stages can be composed ahead of time:
+//     auto validate = then(check_size) | then(check_crc);
+//     auto result   = read() | validate | map(decode);
+template <typename... S>
+struct Stages {
+    std::tuple<S...> stages;
+};
+
+template <typename F>
+[[nodiscard]] constexpr Stages<Then<std::decay_t<F>>> then(F&& func) {
+    return Stages<Then<std::decay_t<F>>>{
+        std::tuple<Then<std::decay_t<F>>>{Then<std::decay_t<F>>{std::forward<F>(func)}}};
+}
+
+template <typename F>
+[[nodiscard]] constexpr Stages<Map<std::decay_t<F>>> map(F&& func) {
+    return Stages<Map<std::decay_t<F>>>{std::tuple<Map<std::decay_t<F>>>{Map<std::decay_t<F>>{std::forward<F>(func)}}};
+}
+
+template <typename F>
+[[nodiscard]] constexpr Stages<MapErr<std::decay_t<F>>> map_err(F&& func) {
+    return Stages<MapErr<std::decay_t<F>>>{
+        std::tuple<MapErr<std::decay_t<F>>>{MapErr<std::decay_t<F>>{std::forward<F>(func)}}};
+}
+
+template <typename... A, typename... B>
+[[nodiscard]] constexpr Stages<A..., B...> operator|(Stages<A...> first, Stages<B...> second) {
+    return Stages<A..., B...>{std::tuple_cat(std::move(first.stages), std::move(second.stages))};
+}
+
+namespace detail {
+// What a stage is invoked with when its input is A, void stands for no argument
+template <typename F, typename A>
+struct invoke {
+    using type = traits::invoke_result_t<F&, A>;
+};
+
+template <typename F>
+struct invoke<F, void> {
+    using type = traits::invoke_result_t<F&>;
+};
+
+template <typename F, typename A>
+using invoke_t = typename invoke<F, A>::type;
+
+template <template <typename> class Stage, typename T>
+constexpr bool is_stage_v = false;
+
+template <template <typename> class Stage, typename F>
+constexpr bool is_stage_v<Stage, Stage<F>> = true;
+
+// What result() of a Result qualified as Res hands out, void for a void result
+template <typename Res, typename = void>
+struct result_arg {
+    using type = decltype(std::declval<Res>().result());
+};
+
+template <typename Res>
+struct result_arg<Res, std::enable_if_t<std::is_void_v<typename std::remove_reference_t<Res>::result_type>>> {
+    using type = void;
+};
+
+template <typename Res>
+using result_arg_t = typename result_arg<Res>::type;
+
+// Follows the value through the stages. A is what the next stage is invoked with, R and E are the result and error
+// types of the Result the pipeline produces so far.
+template <typename A, typename R, typename E, typename... S>
+struct Flow {
+    using type = result::Result<R, E>;
+};
+
+template <typename A, typename R, typename E, typename F, typename... S>
+struct Flow<A, R, E, Then<F>, S...> {
+    using Next = invoke_t<F, A>;
+    static_assert(traits::is_result_v<Next>, "then requires a functor returning a Result");
+    static_assert(std::is_same_v<typename Next::error_type, E>, "then requires a Result with the current error type");
+
+    using type = typename Flow<result_arg_t<Next&&>, typename Next::result_type, E, S...>::type;
+};
+
+template <typename A, typename R, typename E, typename F, typename... S>
+struct Flow<A, R, E, Map<F>, S...> {
+    using type = typename Flow<invoke_t<F, A>, invoke_t<F, A>, E, S...>::type;
+};
+
+template <typename A, typename R, typename E, typename F, typename... S>
+struct Flow<A, R, E, MapErr<F>, S...> {
+    using type = typename Flow<A, R, std::decay_t<traits::invoke_result_t<F&, E&&>>, S...>::type;
+};
+}  // namespace detail
+
+template <typename Src, typename... S>
+class Pipeline {
+    using Source = std::remove_reference_t<Src>;
+
+public:
+    using result_type = typename detail::Flow<detail::result_arg_t<Src&&>, typename Source::result_type,
+                                              typename Source::error_type, S...>::type;
+
+    constexpr Pipeline(Src&& source, Stages<S...>&& stages)
+        : source_(std::forward<Src>(source)), stages_(std::move(stages.stages)) {}
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    [[nodiscard]] constexpr result_type run() && {
+        if (source_.is_ok()) {
+            if constexpr (std::is_void_v<typename Source::result_type>) {
+                return run_ok<0>();
+            } else {
+                return run_ok<0>(std::forward<Src>(source_).result());
+            }
+        }
+        return run_err<0>(std::forward<Src>(source_).error());
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    constexpr operator result_type() && { return std::move(*this).run(); }
+
+    template <typename... B>
+    [[nodiscard]] friend constexpr Pipeline<Src, S..., B...> operator|(Pipeline&& pipeline, Stages<B...> stages) {
+        return Pipeline<Src, S..., B...>{
+            std::forward<Src>(pipeline.source_),
+            Stages<S..., B...>{std::tuple_cat(std::move(pipeline.stages_), std::move(stages.stages))}};
+    }
+
+private:
+    template <std::size_t I>
+    using stage_t = std::tuple_element_t<I, std::tuple<S...>>;
+
+    template <std::size_t I, typename... V>
+    constexpr result_type run_ok(V&&... value) {
+        if constexpr (I == sizeof...(S)) {
+            return result_type{result::in_place_ok, std::forward<V>(value)...};
+        } else {
+            auto& stage = std::get<I>(stages_);
+
+            if constexpr (detail::is_stage_v<Then, stage_t<I>>) {
+                auto next = stage.func(std::forward<V>(value)...);
+                if (next.is_err()) {
+                    return run_err<I + 1>(std::move(next).error());
+                }
+                if constexpr (std::is_void_v<typename decltype(next)::result_type>) {
+                    return run_ok<I + 1>();
+                } else {
+                    return run_ok<I + 1>(std::move(next).result());
+                }
+            } else if constexpr (detail::is_stage_v<Map, stage_t<I>>) {
+                if constexpr (std::is_void_v<decltype(stage.func(std::forward<V>(value)...))>) {
+                    stage.func(std::forward<V>(value)...);
+                    return run_ok<I + 1>();
+                } else {
+                    return run_ok<I + 1>(stage.func(std::forward<V>(value)...));
+                }
+            } else {
+                return run_ok<I + 1>(std::forward<V>(value)...);
+            }
+        }
+    }
+
+    template <std::size_t I, typename V>
+    constexpr result_type run_err(V&& error) {
+        if constexpr (I == sizeof...(S)) {
+            return result_type{result::in_place_err, std::forward<V>(error)};
+        } else if constexpr (detail::is_stage_v<MapErr, stage_t<I>>) {
+            auto& stage = std::get<I>(stages_);
+            // An error borrowed from an lvalue source is copied for a functor that only takes an rvalue, the copy
+            // replaces the one the final Result would otherwise make
+            if constexpr (std::is_invocable_v<decltype(stage.func)&, V&&>) {
+                return run_err<I + 1>(stage.func(std::forward<V>(error)));
+            } else {
+                return run_err<I + 1>(stage.func(std::decay_t<V>(error)));
+            }
+        } else {
+            return run_err<I + 1>(std::forward<V>(error));
+        }
+    }
+
+    Src&& source_;
+    std::tuple<S...> stages_;
+
+    template <typename OtherSrc, typename... OtherS>
+    friend class Pipeline;
+};
+
+// Starts a pipeline from a Result, an lvalue Result is left untouched while an rvalue Result is moved from
+template <typename Src, typename... S, typename = std::enable_if_t<traits::is_result_v<Src>>>
+[[nodiscard]] constexpr Pipeline<Src, S...> operator|(Src&& source, Stages<S...> stages) {
+    return Pipeline<Src, S...>{std::forward<Src>(source), std::move(stages)};
+}
+
+}  // namespace pipeline
+}  // namespace utils
+}  // namespace cogle
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <utils/compatibility.hxx>
+#include <utils/traits.hxx>
+
+namespace cogle {
+namespace utils {
+namespace relocate {
+
+// Relocation moves objects to uninitialized memory and ends their lifetime at the source. For trivially relocatable
+// types, see traits::is_trivially_relocatable, whole ranges are moved with a single memmove instead of a move
+// constructor and a destructor per element. Other types fall back to exactly that loop and must not throw when moved.
+
+template <typename T>
+constexpr bool is_nothrow_relocatable_v =
+    traits::is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+// Relocates the n objects starting at src to the uninitialized memory starting at dest and returns the end of the
+// relocated range. The two ranges may overlap.
+template <typename T>
+T* relocate_n(T* src, const std::size_t n, T* dest) noexcept {
+    static_assert(is_nothrow_relocatable_v<T>, "Relocation requires a trivially relocatable or nothrow movable type");
+
+    if constexpr (traits::is_trivially_relocatable_v<T>) {
+        if (n != 0 && src != dest) {
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+        }
+    } else if (dest < src) {
+        for (std::size_t i = 0; i < n; ++i) {
+            new (dest + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    } else if (dest > src) {
+        for (std::size_t i = n; i > 0; --i) {
+            new (dest + i - 1) T(std::move(src[i - 1]));
+            src[i - 1].~T();
+        }
+    }
+    return dest + n;
+}
+
+template <typename T>
+T* relocate(T* first, T* last, T* dest) noexcept {
+    return relocate_n(first, static_cast<std::size_t>(last - first), dest);
+}
+
+// Destroys [first, last) and closes the gap by relocating [last, end) down to first. Returns the new end, the memory
+// from there to end is left uninitialized.
+template <typename T>
+T* erase(T* first, T* last, T* end) noexcept(std::is_nothrow_destructible_v<T>) {
+    std::destroy(first, last);
+    return relocate(last, end, first);
+}
+
+// A minimal vector whose growth and erase relocate their elements. std::vector has to move construct and destroy every
+// element one at a time because it cannot know that T is trivially relocatable.
+template <typename T, typename Allocator = std::allocator<T>>
+class Buffer {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+public:
+    using value_type = T;
+    using iterator   = T*;
+
+    Buffer() = default;
+
+    explicit Buffer(const Allocator& alloc) : alloc_(alloc) {}
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    Buffer(Buffer&& o) noexcept
+        : alloc_(std::move(o.alloc_)),
+          data_(std::exchange(o.data_, nullptr)),
+          size_(std::exchange(o.size_, 0)),
+          capacity_(std::exchange(o.capacity_, 0)) {}
+
+    Buffer& operator=(Buffer&& o) noexcept {
+        if (this != &o) {
+            release();
+            alloc_    = std::move(o.alloc_);
+            data_     = std::exchange(o.data_, nullptr);
+            size_     = std::exchange(o.size_, 0);
+            capacity_ = std::exchange(o.capacity_, 0);
+        }
+        return *this;
+    }
+
+    ~Buffer() { release(); }
+
+    [[nodiscard]] T* data() noexcept { return data_; }
+    [[nodiscard]] const T* data() const noexcept { return data_; }
+
+    [[nodiscard]] iterator begin() noexcept { return data_; }
+    [[nodiscard]] iterator end() noexcept { return data_ + size_; }
+    [[nodiscard]] const T* begin() const noexcept { return data_; }
+    [[nodiscard]] const T* end() const noexcept { return data_ + size_; }
+
+    [[nodiscard]] T& operator[](const std::size_t idx) noexcept { return data_[idx]; }
+    [[nodiscard]] const T& operator[](const std::size_t idx) const noexcept { return data_[idx]; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    void reserve(const std::size_t capacity) {
+        if (capacity > capacity_) {
+            T* grown = AllocTraits::allocate(alloc_, capacity);
+            relocate_n(data_, size_, grown);
+            replace(grown, capacity);
+        }
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        LIKELY_IF(size_ < capacity_) {
+            T* slot = new (data_ + size_) T(std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        }
+
+        // The new element is built before the old ones are relocated, args may refer to them
+        const std::size_t capacity = capacity_ == 0 ? INITIAL_CAPACITY : capacity_ * 2;
+        Allocation grown{alloc_, AllocTraits::allocate(alloc_, capacity), capacity};
+        T* slot = new (grown.ptr + size_) T(std::forward<Args>(args)...);
+
+        relocate_n(data_, size_, grown.ptr);
+        replace(std::exchange(grown.ptr, nullptr), capacity);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        --size_;
+        data_[size_].~T();
+    }
+
+    iterator erase(iterator first, iterator last) noexcept(std::is_nothrow_destructible_v<T>) {
+        T* new_end = relocate::erase(first, last, end());
+        size_      = static_cast<std::size_t>(new_end - data_);
+        return first;
+    }
+
+    iterator erase(iterator pos) noexcept(std::is_nothrow_destructible_v<T>) { return erase(pos, pos + 1); }
+
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+private:
+    static constexpr std::size_t INITIAL_CAPACITY = 8;
+
+    // Returns a fresh allocation unless it has been handed over
+    struct Allocation {
+        Allocation(Allocator& owner, T* allocated, const std::size_t allocated_capacity)
+            : alloc(owner), ptr(allocated), capacity(allocated_capacity) {}
+        Allocation(const Allocation&) = delete;
+        Allocation& operator=(const Allocation&) = delete;
+
+        ~Allocation() {
+            if (ptr != nullptr) {
+                AllocTraits::deallocate(alloc, ptr, capacity);
+            }
+        }
+
+        Allocator& alloc;
+        T* ptr;
+        std::size_t capacity;
+    };
+
+    // Takes over grown, the elements have already been relocated out of data_
+    void replace(T* grown, const std::size_t capacity) noexcept {
+        if (data_ != nullptr) {
+            AllocTraits::deallocate(alloc_, data_, capacity_);
+        }
+        data_     = grown;
+        capacity_ = capacity;
+    }
+
+    void release() noexcept {
+        clear();
+        if (data_ != nullptr) {
+            AllocTraits::deallocate(alloc_, data_, capacity_);
+        }
+        data_     = nullptr;
+        capacity_ = 0;
+    }
+
+    Allocator alloc_{};
+    T* data_{nullptr};
+    std::size_t size_{0};
+    std::size_t capacity_{0};
+};
+
+}  // namespace relocate
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
@@ -1,10 +1,34 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <new>
+#include <tuple>
+#include <utility>
 #include <utils/abort.hxx>
+#include <utils/compatibility.hxx>
 #include <utils/location.hxx>
+#include <utils/niche.hxx>
 #include <utils/traits.hxx>
 
+#if defined(COGLE_FLIGHT_RECORDER)
+#include <utils/flight_recorder.hxx>
+#endif
+
+#if defined(COGLE_ERROR_COUNTERS)
+#include <utils/error_counters.hxx>
+#endif
+
+// With COGLE_ERROR_COUNTERS and_then, map and map_err take the location they are called from as a defaulted trailing
+// argument so that errors passing through them can be counted per call site, see counters::ErrorCounters.
+#if defined(COGLE_ERROR_COUNTERS)
+#define COGLE_CALL_SITE_PARAM     , const location::SourceLocation call_site = location::SourceLocation::current()
+#define COGLE_COUNT_PROPAGATION() counters::count_propagation(is_err(), call_site)
+#else
+#define COGLE_CALL_SITE_PARAM
+#define COGLE_COUNT_PROPAGATION()
+#endif
+
 namespace cogle {
 
 namespace utils {
@@ -22,31 +46,120 @@ struct Err;
 template <typename R, typename E>
 class Result;
 
+// Tags selecting the in place constructors of Result, the remaining arguments construct the value or the error directly
+// in the storage of the Result.
+struct in_place_ok_t {
+    explicit in_place_ok_t() = default;
+};
+inline constexpr in_place_ok_t in_place_ok{};
+
+struct in_place_err_t {
+    explicit in_place_err_t() = default;
+};
+inline constexpr in_place_err_t in_place_err{};
+
 namespace detail {
-enum class ResultTag { OK = 0, ERR = 1, INVALID = 2 };
+// A single byte so that the tag can be placed in the tail padding after the payload.
+enum class ResultTag : std::uint8_t { OK = 0, ERR = 1, INVALID = 2 };
+
+// Accessing the payload of a Result checks the tag and aborts on a mismatch. Defining COGLE_RESULT_UNCHECKED turns
+// these checks into optimizer assumptions instead, accessing the wrong payload is then undefined behaviour.
+#if defined(COGLE_RESULT_UNCHECKED)
+constexpr void assert_ok(const ResultTag tag, const abort::AbortRecord&) { ASSUME(tag == ResultTag::OK); }
+
+constexpr void assert_err(const ResultTag tag, const abort::AbortRecord&) { ASSUME(tag == ResultTag::ERR); }
+#else
+constexpr void assert_ok(const ResultTag tag, const abort::AbortRecord& record) {
+    abort::cogle_assert(tag == ResultTag::OK, record);
+}
 
-constexpr void assert_ok(const ResultTag tag,
-                         const location::SourceLocation& sl = location::SourceLocation::current()) {
-    abort::cogle_assert(tag == ResultTag::OK, "Expected OK tag to be valid ", sl);
+constexpr void assert_err(const ResultTag tag, const abort::AbortRecord& record) {
+    abort::cogle_assert(tag == ResultTag::ERR, record);
 }
+#endif
+
+// Declares the static record an accessor hands to assert_ok or assert_err, so that a failed check only passes a pointer
+// into .rodata. Records are class members as constexpr accessors cannot hold static variables, each is declared next to
+// the accessor it names.
+#define COGLE_TAG_RECORD(name, message, accessor)                                                                \
+    static constexpr ::cogle::utils::abort::AbortRecord name {                                                   \
+        message, ::cogle::utils::location::SourceLocation::current(__builtin_FILE(), accessor, __builtin_LINE(), \
+                                                                   COGLE_BUILTIN_COLUMN())                       \
+    }
+
+struct propagate_t {
+    explicit propagate_t() = default;
+};
+inline constexpr propagate_t propagate{};
+
+// Makes T depend on Ts, which defers its use until Ts are known
+template <typename T, typename... Ts>
+struct dependent {
+    using type = T;
+};
+
+// Common result of the two branches of a match, not defined if the error branch does not convert to the ok branch
+template <typename OkResult, typename ErrResult>
+using match_result_t = std::enable_if_t<std::is_convertible_v<ErrResult, OkResult>, OkResult>;
 
-constexpr void assert_err(const ResultTag tag,
-                          const location::SourceLocation& sl = location::SourceLocation::current()) {
-    abort::cogle_assert(tag == ResultTag::ERR, "Expected ERR tag to be valid ", sl);
+// Whether the reference T can be bound in place to Args, which takes a single lvalue whose address converts. Binding a
+// temporary or a converted copy would leave the result dangling.
+template <typename T, typename... Args>
+struct is_bindable : std::false_type {};
+
+template <typename T, typename U>
+struct is_bindable<T, U>
+    : std::bool_constant<std::is_lvalue_reference_v<U> &&
+                         std::is_convertible_v<std::remove_reference_t<U>*, std::remove_reference_t<T>*>> {};
+
+// Whether T, which may be void or a reference, can be constructed in place from Args
+template <typename T, typename... Args>
+constexpr bool is_in_place_constructible_v = std::is_void_v<T>        ? sizeof...(Args) == 0
+                                             : std::is_reference_v<T> ? is_bindable<T, Args...>::value
+                                                                      : std::is_constructible_v<T, Args...>;
+
+#if defined(COGLE_FLIGHT_RECORDER) || defined(COGLE_ERROR_COUNTERS)
+// Called for every Err built outside of the library
+template <typename E>
+constexpr void on_err([[maybe_unused]] const E& err, [[maybe_unused]] const location::SourceLocation& sl) noexcept {
+#if defined(COGLE_FLIGHT_RECORDER)
+    recorder::record_err(err, sl);
+#endif
+#if defined(COGLE_ERROR_COUNTERS)
+    counters::count_err(sl);
+#endif
 }
+#endif
+
+// Payloads whose special members are all trivial, Results built only from these are trivially copyable and can be
+// passed around in registers.
+template <typename T>
+constexpr bool is_trivial_payload_v =
+    std::is_trivially_copy_constructible_v<T> && std::is_trivially_move_constructible_v<T> &&
+    std::is_trivially_copy_assignable_v<T> && std::is_trivially_move_assignable_v<T> &&
+    std::is_trivially_destructible_v<T>;
 
 template <typename R, typename E, typename Enabled = void>
 class ResultStorage {
 public:
     explicit constexpr ResultStorage(const Ok<R>& ok) noexcept(std::is_nothrow_copy_constructible_v<R>)
-        : tag_(ResultTag::OK), result_(ok.get_result()) {}
+        : result_(ok.get_result()), tag_(ResultTag::OK) {}
     explicit constexpr ResultStorage(Ok<R>&& ok) noexcept(std::is_nothrow_move_constructible_v<R>)
-        : tag_(ResultTag::OK), result_(std::move(ok.get_result())) {}
+        : result_(std::move(ok.get_result())), tag_(ResultTag::OK) {}
 
     explicit constexpr ResultStorage(const Err<E>& err) noexcept(std::is_nothrow_copy_constructible_v<E>)
-        : tag_(ResultTag::ERR), error_(err.get_error()) {}
+        : error_(err.get_error()), tag_(ResultTag::ERR) {}
     explicit constexpr ResultStorage(Err<E>&& err) noexcept(std::is_nothrow_move_constructible_v<E>)
-        : tag_(ResultTag::ERR), error_(std::move(err.get_error())) {}
+        : error_(std::move(err.get_error())), tag_(ResultTag::ERR) {}
+
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_ok_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<R, Args&&...>)
+        : result_(std::forward<Args>(args)...), tag_(ResultTag::OK) {}
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_err_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<E, Args&&...>)
+        : error_(std::forward<Args>(args)...), tag_(ResultTag::ERR) {}
 
     constexpr ResultStorage(ResultStorage const&) = default;
 
@@ -71,44 +184,49 @@ public:
     }
 
     [[nodiscard]] constexpr ResultTag& get_tag() { return tag_; }
+    [[nodiscard]] constexpr ResultTag get_tag() const { return tag_; }
+
+    COGLE_TAG_RECORD(ERR_RECORD, "Expected ERR tag to be valid", "ResultStorage::get_error");
 
     [[nodiscard]] constexpr E& get_error() & noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return error_;
     }
 
     [[nodiscard]] constexpr E&& get_error() && noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return std::move(error_);
     }
 
     [[nodiscard]] constexpr const E& get_error() const& noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return error_;
     }
 
     [[nodiscard]] constexpr const E&& get_error() const&& noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return std::move(error_);
     }
 
+    COGLE_TAG_RECORD(OK_RECORD, "Expected OK tag to be valid", "ResultStorage::get_result");
+
     [[nodiscard]] constexpr R& get_result() & noexcept {
-        assert_ok(tag_);
+        assert_ok(tag_, OK_RECORD);
         return result_;
     }
 
     [[nodiscard]] constexpr R&& get_result() && noexcept {
-        assert_ok(tag_);
+        assert_ok(tag_, OK_RECORD);
         return std::move(result_);
     }
 
     [[nodiscard]] constexpr const R& get_result() const& noexcept {
-        assert_ok(tag_);
+        assert_ok(tag_, OK_RECORD);
         return result_;
     }
 
     [[nodiscard]] constexpr const R&& get_result() const&& noexcept {
-        assert_ok(tag_);
+        assert_ok(tag_, OK_RECORD);
         return std::move(result_);
     }
 
@@ -129,31 +247,133 @@ private:
 
     constexpr void invalidate() { tag_ = ResultTag::INVALID; }
 
+    union {
+        R result_;
+        E error_;
+    };
+
     ResultTag tag_;
 
+    template <typename Rv, typename Ev>
+    friend class result::Result;
+};
+
+// Trivially copyable storage, every special member is defaulted so that a moved from storage keeps its value rather
+// than being marked INVALID.
+template <typename R, typename E>
+class ResultStorage<R, E,
+                    std::enable_if_t<!niche::is_niche_v<R, E> && !std::is_void_v<R> && !std::is_reference_v<R> &&
+                                     is_trivial_payload_v<R> && is_trivial_payload_v<E>>> {
+public:
+    explicit constexpr ResultStorage(const Ok<R>& ok) noexcept(std::is_nothrow_copy_constructible_v<R>)
+        : result_(ok.get_result()), tag_(ResultTag::OK) {}
+    explicit constexpr ResultStorage(Ok<R>&& ok) noexcept(std::is_nothrow_move_constructible_v<R>)
+        : result_(std::move(ok.get_result())), tag_(ResultTag::OK) {}
+
+    explicit constexpr ResultStorage(const Err<E>& err) noexcept(std::is_nothrow_copy_constructible_v<E>)
+        : error_(err.get_error()), tag_(ResultTag::ERR) {}
+    explicit constexpr ResultStorage(Err<E>&& err) noexcept(std::is_nothrow_move_constructible_v<E>)
+        : error_(std::move(err.get_error())), tag_(ResultTag::ERR) {}
+
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_ok_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<R, Args&&...>)
+        : result_(std::forward<Args>(args)...), tag_(ResultTag::OK) {}
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_err_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<E, Args&&...>)
+        : error_(std::forward<Args>(args)...), tag_(ResultTag::ERR) {}
+
+    constexpr ResultStorage(ResultStorage const&) = default;
+    constexpr ResultStorage(ResultStorage&&)      = default;
+
+    ~ResultStorage() = default;
+
+    constexpr ResultStorage& operator=(ResultStorage const&) = default;
+    constexpr ResultStorage& operator=(ResultStorage&&) = default;
+
+    [[nodiscard]] constexpr ResultTag& get_tag() { return tag_; }
+    [[nodiscard]] constexpr ResultTag get_tag() const { return tag_; }
+
+    COGLE_TAG_RECORD(ERR_RECORD, "Expected ERR tag to be valid", "ResultStorage::get_error");
+
+    [[nodiscard]] constexpr E& get_error() & noexcept {
+        assert_err(tag_, ERR_RECORD);
+        return error_;
+    }
+
+    [[nodiscard]] constexpr E&& get_error() && noexcept {
+        assert_err(tag_, ERR_RECORD);
+        return std::move(error_);
+    }
+
+    [[nodiscard]] constexpr const E& get_error() const& noexcept {
+        assert_err(tag_, ERR_RECORD);
+        return error_;
+    }
+
+    [[nodiscard]] constexpr const E&& get_error() const&& noexcept {
+        assert_err(tag_, ERR_RECORD);
+        return std::move(error_);
+    }
+
+    COGLE_TAG_RECORD(OK_RECORD, "Expected OK tag to be valid", "ResultStorage::get_result");
+
+    [[nodiscard]] constexpr R& get_result() & noexcept {
+        assert_ok(tag_, OK_RECORD);
+        return result_;
+    }
+
+    [[nodiscard]] constexpr R&& get_result() && noexcept {
+        assert_ok(tag_, OK_RECORD);
+        return std::move(result_);
+    }
+
+    [[nodiscard]] constexpr const R& get_result() const& noexcept {
+        assert_ok(tag_, OK_RECORD);
+        return result_;
+    }
+
+    [[nodiscard]] constexpr const R&& get_result() const&& noexcept {
+        assert_ok(tag_, OK_RECORD);
+        return std::move(result_);
+    }
+
+private:
     union {
         R result_;
         E error_;
     };
 
+    ResultTag tag_;
+
     template <typename Rv, typename Ev>
     friend class result::Result;
 };
 
 template <typename R, typename E>
 class ResultStorage<R, E,
-                    std::enable_if_t<!std::is_void_v<R> &&
+                    std::enable_if_t<!niche::is_niche_v<R, E> && !std::is_void_v<R> && !std::is_reference_v<R> &&
                                      (!std::is_trivially_destructible_v<R> || !std::is_trivially_destructible_v<E>)>> {
 public:
     explicit constexpr ResultStorage(const Ok<R>& ok) noexcept(std::is_nothrow_copy_constructible_v<R>)
-        : tag_(ResultTag::OK), result_(ok.get_result()) {}
+        : result_(ok.get_result()), tag_(ResultTag::OK) {}
     explicit constexpr ResultStorage(Ok<R>&& ok) noexcept(std::is_nothrow_move_constructible_v<R>)
-        : tag_(ResultTag::OK), result_(std::move(ok.get_result())) {}
+        : result_(std::move(ok.get_result())), tag_(ResultTag::OK) {}
 
     explicit constexpr ResultStorage(const Err<E>& err) noexcept(std::is_nothrow_copy_constructible_v<E>)
-        : tag_(ResultTag::ERR), error_(err.get_error()) {}
+        : error_(err.get_error()), tag_(ResultTag::ERR) {}
     explicit constexpr ResultStorage(Err<E>&& err) noexcept(std::is_nothrow_move_constructible_v<E>)
-        : tag_(ResultTag::ERR), error_(std::move(err.get_error())) {}
+        : error_(std::move(err.get_error())), tag_(ResultTag::ERR) {}
+
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_ok_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<R, Args&&...>)
+        : result_(std::forward<Args>(args)...), tag_(ResultTag::OK) {}
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_err_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<E, Args&&...>)
+        : error_(std::forward<Args>(args)...), tag_(ResultTag::ERR) {}
 
     constexpr ResultStorage(ResultStorage const& o) noexcept(
         std::is_nothrow_copy_constructible_v<R>&& std::is_nothrow_copy_constructible_v<E>)
@@ -171,63 +391,68 @@ public:
     ~ResultStorage() noexcept(noexcept(std::declval<R>().~R()) && noexcept(std::declval<E>().~E())) { clear(); }
 
     constexpr ResultStorage& operator=(ResultStorage const& o) noexcept(
-        std::is_nothrow_copy_constructible_v<R>&& std::is_nothrow_copy_constructible_v<E>) {
-        clear();
-        assign(o);
-        tag_ = o.tag_;
+        std::is_nothrow_copy_constructible_v<R>&& std::is_nothrow_copy_constructible_v<E>&&
+            std::is_nothrow_copy_assignable_v<R>&& std::is_nothrow_copy_assignable_v<E>) {
+        reassign(o);
 
         return *this;
     }
 
     constexpr ResultStorage& operator=(ResultStorage&& o) noexcept(
-        std::is_nothrow_move_constructible_v<R>&& std::is_nothrow_move_constructible_v<E>) {
-        clear();
-        assign(std::move(o));
-        tag_ = o.tag_;
-        o.invalidate();
+        std::is_nothrow_move_constructible_v<R>&& std::is_nothrow_move_constructible_v<E>&&
+            std::is_nothrow_move_assignable_v<R>&& std::is_nothrow_move_assignable_v<E>) {
+        if (this != &o) {
+            reassign(std::move(o));
+            o.invalidate();
+        }
 
         return *this;
     }
 
     [[nodiscard]] constexpr ResultTag& get_tag() { return tag_; }
+    [[nodiscard]] constexpr ResultTag get_tag() const { return tag_; }
+
+    COGLE_TAG_RECORD(ERR_RECORD, "Expected ERR tag to be valid", "ResultStorage::get_error");
 
     [[nodiscard]] constexpr E& get_error() & noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return error_;
     }
 
     [[nodiscard]] constexpr E&& get_error() && noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return std::move(error_);
     }
 
     [[nodiscard]] constexpr const E& get_error() const& noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return error_;
     }
 
     [[nodiscard]] constexpr const E&& get_error() const&& noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return std::move(error_);
     }
 
+    COGLE_TAG_RECORD(OK_RECORD, "Expected OK tag to be valid", "ResultStorage::get_result");
+
     [[nodiscard]] constexpr R& get_result() & noexcept {
-        assert_ok(tag_);
+        assert_ok(tag_, OK_RECORD);
         return result_;
     }
 
     [[nodiscard]] constexpr R&& get_result() && noexcept {
-        assert_ok(tag_);
+        assert_ok(tag_, OK_RECORD);
         return std::move(result_);
     }
 
     [[nodiscard]] constexpr const R& get_result() const& noexcept {
-        assert_ok(tag_);
+        assert_ok(tag_, OK_RECORD);
         return result_;
     }
 
     [[nodiscard]] constexpr const R&& get_result() const&& noexcept {
-        assert_ok(tag_);
+        assert_ok(tag_, OK_RECORD);
         return std::move(result_);
     }
 
@@ -246,6 +471,51 @@ private:
         }
     }
 
+    // Assignment to an already constructed storage. When both sides hold the same alternative it goes through
+    // R::operator= or E::operator= so resources such as a vector or string buffer are reused, with whatever guarantee
+    // those give. Otherwise the old value is only destroyed once nothing can throw anymore, an exception leaves *this
+    // untouched. The one exception is a payload whose move constructor may throw: it is built aside, the old value
+    // destroyed and the new one moved in, if that move throws *this is left INVALID, neither is_ok nor is_err.
+    template <typename U>
+    constexpr void reassign(U&& u) {
+        switch (u.tag_) {
+            case ResultTag::OK:
+                reassign_member(result_, ResultTag::OK, std::forward<U>(u).get_result());
+                break;
+            case ResultTag::ERR:
+                reassign_member(error_, ResultTag::ERR, std::forward<U>(u).get_error());
+                break;
+            default:
+                invalidate();
+                break;
+        }
+    }
+
+    template <typename T, typename V>
+    constexpr void reassign_member(T& member, const ResultTag tag, V&& value) {
+        if constexpr (std::is_assignable_v<T&, V&&>) {
+            LIKELY_IF(tag_ == tag) {
+                member = std::forward<V>(value);
+                return;
+            }
+        }
+
+        if constexpr (std::is_nothrow_constructible_v<T, V&&>) {
+            clear();
+            new (&member) T(std::forward<V>(value));
+        } else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            T tmp(std::forward<V>(value));
+            clear();
+            new (&member) T(std::move(tmp));
+        } else {
+            // Basic guarantee only, holding both values at once would need a second buffer
+            T tmp(std::forward<V>(value));
+            invalidate();
+            new (&member) T(std::move(tmp));
+        }
+        tag_ = tag;
+    }
+
     constexpr void clear() noexcept {
         switch (tag_) {
             case ResultTag::OK:
@@ -264,19 +534,19 @@ private:
         tag_ = ResultTag::INVALID;
     }
 
-    ResultTag tag_;
-
     union {
         R result_;
         E error_;
     };
 
+    ResultTag tag_;
+
     template <typename Rv, typename Ev>
     friend class result::Result;
 };
 
 template <typename E>
-class ResultStorage<void, E, std::enable_if_t<std::is_standard_layout_v<E> && std::is_trivial_v<E>>> {
+class ResultStorage<void, E, std::enable_if_t<!niche::is_niche_v<void, E> && is_trivial_payload_v<E>>> {
     using type = typename std::aligned_storage<sizeof(E), alignof(E)>::type;
 
 public:
@@ -293,107 +563,75 @@ public:
         new (&error_) E(std::move(err.get_error()));
     }
 
-    constexpr ResultStorage(ResultStorage const& o) noexcept(std::is_nothrow_copy_constructible_v<E>) : tag_(o.tag_) {
-        assign(o);
-    }
-
-    constexpr ResultStorage(ResultStorage&& o) noexcept(std::is_nothrow_move_constructible_v<E>) : tag_(o.tag_) {
-        assign(std::move(o));
-        o.invalidate();
+    explicit constexpr ResultStorage(in_place_ok_t) noexcept : tag_(ResultTag::OK) {}
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_err_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<E, Args&&...>)
+        : tag_(ResultTag::ERR) {
+        new (&error_) E(std::forward<Args>(args)...);
     }
 
-    ~ResultStorage() { clear(); }
-
-    constexpr ResultStorage& operator=(const ResultStorage& o) noexcept(std::is_nothrow_copy_constructible_v<E>) {
-        clear();
-        assign(o);
-        tag_ = o.tag_;
+    constexpr ResultStorage(ResultStorage const&) = default;
+    constexpr ResultStorage(ResultStorage&&)      = default;
 
-        return *this;
-    }
+    ~ResultStorage() = default;
 
-    constexpr ResultStorage& operator=(ResultStorage&& o) noexcept(std::is_nothrow_move_constructible_v<E>) {
-        clear();
-        assign(std::move(o));
-        tag_ = o.tag_;
-        o.invalidate();
-
-        return *this;
-    }
+    constexpr ResultStorage& operator=(const ResultStorage&) = default;
+    constexpr ResultStorage& operator=(ResultStorage&&) = default;
 
     [[nodiscard]] constexpr ResultTag& get_tag() { return tag_; }
+    [[nodiscard]] constexpr ResultTag get_tag() const { return tag_; }
+
+    COGLE_TAG_RECORD(ERR_RECORD, "Expected ERR tag to be valid", "ResultStorage::get_error");
 
     [[nodiscard]] constexpr E& get_error() & noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return *std::launder(reinterpret_cast<E*>(&error_));
     }
 
     [[nodiscard]] constexpr E&& get_error() && noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return std::move(*std::launder(reinterpret_cast<E*>(&error_)));
     }
 
     [[nodiscard]] constexpr const E& get_error() const& noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return *std::launder(reinterpret_cast<const E*>(&error_));
     }
 
     [[nodiscard]] constexpr const E&& get_error() const&& noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return std::move(*std::launder(reinterpret_cast<const E*>(&error_)));
     }
 
 private:
-    template <typename U>
-    constexpr void assign(U&& u) {
-        switch (u.tag_) {
-            case ResultTag::OK:
-                break;
-            case ResultTag::ERR:
-                new (&error_) E(std::forward<U>(u).get_error());
-                break;
-            default:
-                break;
-        }
-    }
-
-    constexpr void clear() {
-        switch (tag_) {
-            case ResultTag::OK:
-                break;
-            case ResultTag::ERR:
-                std::launder(reinterpret_cast<E*>(&error_))->~E();
-                break;
-            default:
-                break;
-        }
-    }
-
-    constexpr void invalidate() {
-        clear();
-        tag_ = ResultTag::INVALID;
-    }
-
-    ResultTag tag_;
     union {
         type error_;
     };
 
+    ResultTag tag_;
+
     template <typename Rv, typename Ev>
     friend class result::Result;
 };
 
 template <typename E>
-class ResultStorage<void, E, std::enable_if_t<!std::is_standard_layout_v<E> || !std::is_trivial_v<E>>> {
+class ResultStorage<void, E, std::enable_if_t<!niche::is_niche_v<void, E> && !is_trivial_payload_v<E>>> {
 public:
     explicit constexpr ResultStorage(const Ok<void>&) noexcept : tag_(ResultTag::OK) {}
 
     explicit constexpr ResultStorage(Ok<void>&&) noexcept : tag_(ResultTag::OK) {}
 
     explicit constexpr ResultStorage(const Err<E>& err) noexcept(std::is_nothrow_copy_constructible_v<E>)
-        : tag_(ResultTag::ERR), error_(err.get_error()) {}
+        : error_(err.get_error()), tag_(ResultTag::ERR) {}
     explicit constexpr ResultStorage(Err<E>&& err) noexcept(std::is_nothrow_move_constructible_v<E>)
-        : tag_(ResultTag::ERR), error_(std::move(err.get_error())) {}
+        : error_(std::move(err.get_error())), tag_(ResultTag::ERR) {}
+
+    explicit constexpr ResultStorage(in_place_ok_t) noexcept : tag_(ResultTag::OK) {}
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_err_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<E, Args&&...>)
+        : error_(std::forward<Args>(args)...), tag_(ResultTag::ERR) {}
 
     constexpr ResultStorage(ResultStorage const& o) noexcept(std::is_nothrow_copy_constructible_v<E>) : tag_(o.tag_) {
         assign(o);
@@ -406,42 +644,45 @@ public:
 
     ~ResultStorage() { clear(); }
 
-    constexpr ResultStorage& operator=(const ResultStorage& o) noexcept(std::is_nothrow_copy_constructible_v<E>) {
-        clear();
-        assign(o);
-        tag_ = o.tag_;
+    constexpr ResultStorage& operator=(const ResultStorage& o) noexcept(
+        std::is_nothrow_copy_constructible_v<E>&& std::is_nothrow_copy_assignable_v<E>) {
+        reassign(o);
 
         return *this;
     }
 
-    constexpr ResultStorage& operator=(ResultStorage&& o) noexcept(std::is_nothrow_move_constructible_v<E>) {
-        clear();
-        assign(std::move(o));
-        tag_ = o.tag_;
-        o.invalidate();
+    constexpr ResultStorage& operator=(ResultStorage&& o) noexcept(
+        std::is_nothrow_move_constructible_v<E>&& std::is_nothrow_move_assignable_v<E>) {
+        if (this != &o) {
+            reassign(std::move(o));
+            o.invalidate();
+        }
 
         return *this;
     }
 
     [[nodiscard]] constexpr ResultTag& get_tag() { return tag_; }
+    [[nodiscard]] constexpr ResultTag get_tag() const { return tag_; }
+
+    COGLE_TAG_RECORD(ERR_RECORD, "Expected ERR tag to be valid", "ResultStorage::get_error");
 
     [[nodiscard]] constexpr E& get_error() & noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return error_;
     }
 
     [[nodiscard]] constexpr E&& get_error() && noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return std::move(error_);
     }
 
     [[nodiscard]] constexpr const E& get_error() const& noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return error_;
     }
 
     [[nodiscard]] constexpr const E&& get_error() const&& noexcept {
-        assert_err(tag_);
+        assert_err(tag_, ERR_RECORD);
         return std::move(error_);
     }
 
@@ -459,6 +700,38 @@ private:
         }
     }
 
+    // Same as for the non void storage, an ERR to ERR assignment reuses the error through E::operator= and only an E
+    // whose move constructor may throw can leave *this INVALID
+    template <typename U>
+    constexpr void reassign(U&& u) {
+        switch (u.tag_) {
+            case ResultTag::OK:
+                clear();
+                tag_ = ResultTag::OK;
+                break;
+            case ResultTag::ERR:
+                if constexpr (std::is_assignable_v<E&, decltype(std::forward<U>(u).get_error())>) {
+                    LIKELY_IF(tag_ == ResultTag::ERR) {
+                        error_ = std::forward<U>(u).get_error();
+                        break;
+                    }
+                }
+                // When holding OK there is nothing to destroy and a throwing E leaves *this untouched
+                if (tag_ == ResultTag::OK) {
+                    new (&error_) E(std::forward<U>(u).get_error());
+                } else {
+                    E tmp(std::forward<U>(u).get_error());
+                    invalidate();
+                    new (&error_) E(std::move(tmp));
+                }
+                tag_ = ResultTag::ERR;
+                break;
+            default:
+                invalidate();
+                break;
+        }
+    }
+
     constexpr void clear() {
         switch (tag_) {
             case ResultTag::OK:
@@ -476,11 +749,126 @@ private:
         tag_ = ResultTag::INVALID;
     }
 
-    ResultTag tag_;
     union {
         E error_;
     };
 
+    ResultTag tag_;
+
+    template <typename Rv, typename Ev>
+    friend class result::Result;
+};
+
+// Niche storage, the OK/ERR discriminator is encoded inside the payload as described by niche::niche_traits<R, E>.
+// Payloads are decoded on access and therefore handed out by value.
+template <typename R, typename E>
+class ResultStorage<R, E, std::enable_if_t<niche::is_niche_v<R, E>>> {
+    using Niche       = niche::niche_traits<R, E>;
+    using StorageType = typename Niche::storage_type;
+
+    static_assert(std::is_trivially_copyable_v<StorageType>, "Niche storage_type must be trivially copyable");
+
+public:
+    explicit constexpr ResultStorage(const Ok<R>& ok) noexcept : raw_(encode(ok)) {}
+
+    explicit constexpr ResultStorage(const Err<E>& err) noexcept : raw_(Niche::encode_err(err.get_error())) {}
+
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_ok_t, Args&&... args) noexcept
+        : raw_(encode_in_place(std::forward<Args>(args)...)) {}
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_err_t, Args&&... args) noexcept
+        : raw_(Niche::encode_err(E(std::forward<Args>(args)...))) {}
+
+    constexpr ResultStorage(ResultStorage const&) = default;
+    constexpr ResultStorage(ResultStorage&&)      = default;
+
+    ~ResultStorage() = default;
+
+    constexpr ResultStorage& operator=(ResultStorage const&) = default;
+    constexpr ResultStorage& operator=(ResultStorage&&) = default;
+
+    [[nodiscard]] constexpr ResultTag get_tag() const { return Niche::is_ok(raw_) ? ResultTag::OK : ResultTag::ERR; }
+
+    COGLE_TAG_RECORD(ERR_RECORD, "Expected ERR tag to be valid", "ResultStorage::get_error");
+
+    [[nodiscard]] constexpr E get_error() const noexcept {
+        assert_err(get_tag(), ERR_RECORD);
+        return Niche::decode_err(raw_);
+    }
+
+    COGLE_TAG_RECORD(OK_RECORD, "Expected OK tag to be valid", "ResultStorage::get_result");
+
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr U get_result() const noexcept {
+        assert_ok(get_tag(), OK_RECORD);
+        return Niche::decode_ok(raw_);
+    }
+
+private:
+    static constexpr StorageType encode(const Ok<R>& ok) noexcept {
+        if constexpr (std::is_void_v<R>) {
+            return Niche::encode_ok();
+        } else {
+            return Niche::encode_ok(ok.get_result());
+        }
+    }
+
+    template <typename... Args>
+    static constexpr StorageType encode_in_place(Args&&... args) noexcept {
+        if constexpr (std::is_void_v<R>) {
+            static_assert(sizeof...(Args) == 0, "Ok<void> is built without arguments");
+            return Niche::encode_ok();
+        } else if constexpr (std::is_reference_v<R>) {
+            R ref(std::forward<Args>(args)...);
+            return Niche::encode_ok(ref);
+        } else {
+            return Niche::encode_ok(R(std::forward<Args>(args)...));
+        }
+    }
+
+    StorageType raw_;
+
+    template <typename Rv, typename Ev>
+    friend class result::Result;
+};
+
+// Reference payloads without a niche are stored as a pointer in the storage of a Result<T*, E>. The referent is never
+// copied and the reference is handed out as is.
+template <typename R, typename E>
+class ResultStorage<R, E, std::enable_if_t<!niche::is_niche_v<R, E> && std::is_reference_v<R>>> {
+    using Pointer = std::remove_reference_t<R>*;
+    using Inner   = ResultStorage<Pointer, E>;
+
+public:
+    explicit constexpr ResultStorage(const Ok<R>& ok) noexcept : inner_(Ok<Pointer>{&ok.get_result()}) {}
+
+    explicit constexpr ResultStorage(const Err<E>& err) noexcept(std::is_nothrow_copy_constructible_v<E>)
+        : inner_(err) {}
+    explicit constexpr ResultStorage(Err<E>&& err) noexcept(std::is_nothrow_move_constructible_v<E>)
+        : inner_(std::move(err)) {}
+
+    template <typename U, typename = std::enable_if_t<is_bindable<R, U&&>::value>>
+    explicit constexpr ResultStorage(in_place_ok_t, U&& ref) noexcept : inner_(in_place_ok, Pointer{&ref}) {}
+    template <typename... Args>
+    explicit constexpr ResultStorage(in_place_err_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<E, Args&&...>)
+        : inner_(in_place_err, std::forward<Args>(args)...) {}
+
+    [[nodiscard]] constexpr decltype(auto) get_tag() { return inner_.get_tag(); }
+    [[nodiscard]] constexpr ResultTag get_tag() const { return inner_.get_tag(); }
+
+    [[nodiscard]] constexpr decltype(auto) get_error() & noexcept { return inner_.get_error(); }
+    [[nodiscard]] constexpr decltype(auto) get_error() && noexcept { return std::move(inner_).get_error(); }
+    [[nodiscard]] constexpr decltype(auto) get_error() const& noexcept { return inner_.get_error(); }
+    [[nodiscard]] constexpr decltype(auto) get_error() const&& noexcept { return std::move(inner_).get_error(); }
+
+    // Whatever the value category of the storage, the result is the referent
+    [[nodiscard]] constexpr R get_result() const noexcept { return *inner_.get_result(); }
+
+private:
+    Inner inner_;
+
     template <typename Rv, typename Ev>
     friend class result::Result;
 };
@@ -510,14 +898,16 @@ struct Ok {
 
     template <typename T>
     [[nodiscard]] constexpr bool operator==(const Ok<T>& o) const {
-        static_assert(traits::is_comparable_with<R, T>{}, "Equality operator requires comparability");
-        return value_ == o.value_;
+        static_assert(traits::is_comparable_with<R, std::remove_reference_t<T>>{},
+                      "Equality operator requires comparability");
+        return value_ == o.get_result();
     }
 
     template <typename T>
     [[nodiscard]] constexpr bool operator!=(const Ok<T>& o) const {
-        static_assert(traits::is_comparable_with<R, T>{}, "Inequality operator requires comparability");
-        return value_ != o.value_;
+        static_assert(traits::is_comparable_with<R, std::remove_reference_t<T>>{},
+                      "Inequality operator requires comparability");
+        return value_ != o.get_result();
     }
 
     template <typename T>
@@ -539,6 +929,51 @@ private:
     friend class Result;
 };
 
+// Holds a reference to the result as a pointer, temporaries are rejected as they would dangle.
+template <typename R>
+struct Ok<R&> {
+    using value_type = R&;
+
+    [[nodiscard]] explicit constexpr Ok(R& val) noexcept : value_(&val) {}
+    explicit Ok(R&& val) = delete;
+
+    constexpr Ok(Ok&&)    = default;
+    constexpr Ok& operator=(Ok&&) = default;
+
+    constexpr Ok(Ok const&) = default;
+    constexpr Ok& operator=(Ok const&) = default;
+
+    [[nodiscard]] constexpr R& get_result() const noexcept { return *value_; }
+
+    // Compares the referents, not their addresses
+    template <typename T>
+    [[nodiscard]] constexpr bool operator==(const Ok<T>& o) const {
+        static_assert(traits::is_comparable_with<R, std::remove_reference_t<T>>{},
+                      "Equality operator requires comparability");
+        return *value_ == o.get_result();
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr bool operator!=(const Ok<T>& o) const {
+        static_assert(traits::is_comparable_with<R, std::remove_reference_t<T>>{},
+                      "Inequality operator requires comparability");
+        return *value_ != o.get_result();
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr bool operator==(const Err<T>&) const {
+        return false;
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr bool operator!=(const Err<T>&) const {
+        return true;
+    }
+
+private:
+    R* value_;
+};
+
 template <>
 struct Ok<void> {
     using value_type = void;
@@ -571,10 +1006,27 @@ template <typename E>
 struct Err {
     using value_type = E;
 
+#if defined(COGLE_FLIGHT_RECORDER) || defined(COGLE_ERROR_COUNTERS)
+    // Every Err built outside of the library is reported together with the location it was built at, see
+    // recorder::FlightRecorder and counters::ErrorCounters.
+    [[nodiscard]] explicit constexpr Err(const E& val,
+                                         const location::SourceLocation sl = location::SourceLocation::current())
+        noexcept(std::is_nothrow_copy_constructible<E>())
+        : error_(val) {
+        detail::on_err(error_, sl);
+    }
+    [[nodiscard]] explicit constexpr Err(E&& val,
+                                         const location::SourceLocation sl = location::SourceLocation::current())
+        noexcept(std::is_nothrow_move_constructible<E>())
+        : error_(std::move(val)) {
+        detail::on_err(error_, sl);
+    }
+#else
     [[nodiscard]] explicit constexpr Err(const E& val) noexcept(std::is_nothrow_copy_constructible<E>())
         : error_(val) {}
     [[nodiscard]] explicit constexpr Err(E&& val) noexcept(std::is_nothrow_move_constructible<E>())
         : error_(std::move(val)) {}
+#endif
 
     constexpr Err(Err&&)   = default;
     constexpr Err& operator=(Err&&) = default;
@@ -613,17 +1065,94 @@ struct Err {
     }
 
 private:
+    // Used by Result to pass an existing error along, this is not a new error and is never recorded.
+    template <typename U>
+    constexpr Err(detail::propagate_t, U&& val) noexcept(std::is_nothrow_constructible_v<E, U&&>)
+        : error_(std::forward<U>(val)) {}
+
     E error_;
 
     template <typename Rv, typename Ev>
     friend class Result;
 };
 
+// Forwarding counterparts of Ok and Err. They only hold references to their arguments, the Result they are converted to
+// constructs its value or error from them directly in its storage:
+//     return EmplaceOk{std::move(path)};
+// Since the arguments are referenced they have to be converted in the full expression that created them.
+template <typename... Args>
+struct EmplaceOk {
+    [[nodiscard]] explicit constexpr EmplaceOk(Args&&... args) noexcept : args_(std::forward<Args>(args)...) {}
+
+    EmplaceOk(EmplaceOk const&) = delete;
+    EmplaceOk& operator=(EmplaceOk const&) = delete;
+
+private:
+    std::tuple<Args&&...> args_;
+
+    template <typename Rv, typename Ev>
+    friend class Result;
+};
+
+template <typename... Args>
+EmplaceOk(Args&&...) -> EmplaceOk<Args...>;
+
+template <typename... Args>
+struct EmplaceErr {
+#if defined(COGLE_FLIGHT_RECORDER) || defined(COGLE_ERROR_COUNTERS)
+    // The error does not exist yet, the location is kept until the Result has constructed it.
+    [[nodiscard]] explicit constexpr EmplaceErr(Args&&... args,
+                                                const location::SourceLocation sl = location::SourceLocation::current())
+        noexcept
+        : args_(std::forward<Args>(args)...), location_(sl) {}
+#else
+    [[nodiscard]] explicit constexpr EmplaceErr(Args&&... args) noexcept : args_(std::forward<Args>(args)...) {}
+#endif
+
+    EmplaceErr(EmplaceErr const&) = delete;
+    EmplaceErr& operator=(EmplaceErr const&) = delete;
+
+private:
+    std::tuple<Args&&...> args_;
+#if defined(COGLE_FLIGHT_RECORDER) || defined(COGLE_ERROR_COUNTERS)
+    location::SourceLocation location_;
+#endif
+
+    template <typename Rv, typename Ev>
+    friend class Result;
+};
+
+template <typename... Args>
+EmplaceErr(Args&&...) -> EmplaceErr<Args...>;
+
 template <typename R, typename E>
 class Result {
+    static_assert(!std::is_rvalue_reference_v<R>, "Result can hold an lvalue reference but not an rvalue reference");
+
     using TagEnum = detail::ResultTag;
     using Storage = detail::ResultStorage<R, E>;
 
+    // What the functors given to the combinators are invoked with when applied to the storage qualified as S, that is
+    // the payload or the error qualified like *this. Niche storages decode their payload and pass it by value. X defers
+    // the lookup of get_result until the overloads for a void R have been discarded.
+    template <typename X, typename S>
+    using ok_arg_t = decltype(std::declval<typename detail::dependent<S, X>::type>().get_result());
+    template <typename S>
+    using err_arg_t = decltype(std::declval<S>().get_error());
+
+    // Return types of the combinators, an overload is discarded when its functors cannot be invoked with the arguments
+    template <typename F, typename... Args>
+    using and_then_t = Result<typename traits::invoke_result_t<F&&, Args...>::result_type, E>;
+    template <typename F, typename... Args>
+    using map_t = Result<traits::invoke_result_t<F&&, Args...>, E>;
+    template <typename F, typename S>
+    using map_err_t = Result<R, traits::invoke_result_t<F&&, err_arg_t<S>>>;
+    template <typename F, typename S>
+    using or_else_t = Result<R, typename traits::invoke_result_t<F&&, err_arg_t<S>>::error_type>;
+    template <typename OkF, typename ErrF, typename S, typename... X>
+    using match_t = detail::match_result_t<traits::invoke_result_t<OkF&&, ok_arg_t<X, S>...>,
+                                           traits::invoke_result_t<ErrF&&, err_arg_t<S>>>;
+
 public:
     using result_type = R;
     using error_type  = E;
@@ -640,67 +1169,137 @@ public:
     [[nodiscard]] constexpr Result(Err<E>&& err) noexcept(std::is_nothrow_move_constructible<Storage>())
         : storage_(std::move(err)) {}
 
-    constexpr Result(const Result& o) noexcept(std::is_nothrow_copy_constructible<Storage>()) : storage_(o.storage_) {}
+    // Construct the value or the error directly in the storage, without an intermediate Ok or Err. Errors built this
+    // way are not reported to the flight recorder or the error counters, use EmplaceErr for that.
+    template <typename... Args, typename = std::enable_if_t<detail::is_in_place_constructible_v<R, Args&&...>>>
+    [[nodiscard]] explicit constexpr Result(in_place_ok_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<Storage, in_place_ok_t, Args&&...>)
+        : storage_(in_place_ok, std::forward<Args>(args)...) {}
 
-    constexpr Result(Result&& o) noexcept(std::is_nothrow_move_constructible<Storage>())
-        : storage_(std::move(o.storage_)) {}
+    template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<E, Args&&...>>>
+    [[nodiscard]] explicit constexpr Result(in_place_err_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<Storage, in_place_err_t, Args&&...>)
+        : storage_(in_place_err, std::forward<Args>(args)...) {}
 
-    ~Result() = default;
+    template <typename... Args, typename = std::enable_if_t<detail::is_in_place_constructible_v<R, Args&&...>>>
+    [[nodiscard]] constexpr Result(EmplaceOk<Args...>&& ok) noexcept(
+        std::is_nothrow_constructible_v<Storage, in_place_ok_t, Args&&...>)
+        : Result(std::index_sequence_for<Args...>{}, in_place_ok, std::move(ok.args_)) {}
 
-    constexpr Result& operator=(Result const& o) {
-        storage_ = o.storage_;
-        return *this;
+    template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<E, Args&&...>>>
+    [[nodiscard]] constexpr Result(EmplaceErr<Args...>&& err) noexcept(
+        std::is_nothrow_constructible_v<Storage, in_place_err_t, Args&&...>)
+        : Result(std::index_sequence_for<Args...>{}, in_place_err, std::move(err.args_)) {
+#if defined(COGLE_FLIGHT_RECORDER) || defined(COGLE_ERROR_COUNTERS)
+        detail::on_err(storage_.get_error(), err.location_);
+#endif
     }
 
-    constexpr Result& operator=(Result&& o) {
-        storage_ = std::move(o.storage_);
-        return *this;
-    }
+    // Defaulted so that Result inherits the triviality of its storage, a Result<int, int> is returned in registers.
+    constexpr Result(const Result&) = default;
+    constexpr Result(Result&&)      = default;
+
+    ~Result() = default;
+
+    constexpr Result& operator=(Result const&) = default;
+    constexpr Result& operator=(Result&&) = default;
 
     explicit constexpr operator bool() const { return is_ok(); }
 
-    [[nodiscard]] constexpr bool is_ok() const { return storage_.tag_ == TagEnum::OK; }
+    [[nodiscard]] constexpr bool is_ok() const { return storage_.get_tag() == TagEnum::OK; }
 
-    [[nodiscard]] constexpr bool is_err() const { return storage_.tag_ == TagEnum::ERR; }
+    [[nodiscard]] constexpr bool is_err() const { return storage_.get_tag() == TagEnum::ERR; }
 
-    template <typename U = E>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, U&> error() & noexcept {
+    // The accessors return whatever the storage hands out, a reference for regular storage and a value for niche
+    // storage (see niche::niche_traits).
+    template <typename U = E, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) error() & noexcept {
         return storage_.get_error();
     }
 
-    template <typename U = E>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, U&&> error() && noexcept {
-        return std::move(storage_.get_error());
+    template <typename U = E, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) error() && noexcept {
+        return std::move(storage_).get_error();
     }
 
-    template <typename U = E>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, const U&> error() const& noexcept {
+    template <typename U = E, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) error() const& noexcept {
         return storage_.get_error();
     }
 
-    template <typename U = E>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, const E&&> error() const&& noexcept {
-        return std::move(storage_.get_error());
+    template <typename U = E, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) error() const&& noexcept {
+        return std::move(storage_).get_error();
+    }
+
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) result() & noexcept {
+        return storage_.get_result();
+    }
+
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) result() && noexcept {
+        return std::move(storage_).get_result();
+    }
+
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) result() const& noexcept {
+        return storage_.get_result();
+    }
+
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) result() const&& noexcept {
+        return std::move(storage_).get_result();
     }
 
-    template <typename U = R>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, U&> result() & noexcept {
+    // unwrap_unchecked/error_unchecked skip the tag check, the caller guarantees that the Result holds the requested
+    // payload, e.g. right after testing is_ok(). Calling them on the wrong payload is undefined behaviour.
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) unwrap_unchecked() & noexcept {
+        ASSUME(is_ok());
         return storage_.get_result();
     }
 
-    template <typename U = R>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, U&&> result() && noexcept {
-        return std::move(storage_.get_result());
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) unwrap_unchecked() && noexcept {
+        ASSUME(is_ok());
+        return std::move(storage_).get_result();
     }
 
-    template <typename U = R>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, const U&> result() const& noexcept {
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) unwrap_unchecked() const& noexcept {
+        ASSUME(is_ok());
         return storage_.get_result();
     }
 
-    template <typename U = R>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, const U&&> result() const&& noexcept {
-        return std::move(storage_.get_result());
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) unwrap_unchecked() const&& noexcept {
+        ASSUME(is_ok());
+        return std::move(storage_).get_result();
+    }
+
+    template <typename U = E, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) error_unchecked() & noexcept {
+        ASSUME(is_err());
+        return storage_.get_error();
+    }
+
+    template <typename U = E, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) error_unchecked() && noexcept {
+        ASSUME(is_err());
+        return std::move(storage_).get_error();
+    }
+
+    template <typename U = E, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) error_unchecked() const& noexcept {
+        ASSUME(is_err());
+        return storage_.get_error();
+    }
+
+    template <typename U = E, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) error_unchecked() const&& noexcept {
+        ASSUME(is_err());
+        return std::move(storage_).get_error();
     }
 
     // Helpful link about auto vs decltype(auto)
@@ -708,6 +1307,7 @@ public:
 
     // and_then<R, Func>(Func&& f) -> Result<U, E>
     // where f(R r) -> Result<U, E>
+    // f is invoked with the result qualified like *this, so it may take R by value or as R&, const R& or R&& to match.
     // and_then: takes a functor that takes the current result and returns a Result<U,E>
     // Example(s):
     // Result<char, int> r{Ok{'a'}};
@@ -717,79 +1317,77 @@ public:
 
     // non-void
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto and_then(
-        F&& func) & -> Result<typename traits::invoke_result_t<F&&, X&&>::result_type, E> {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
-        static_assert(std::is_same_v<typename traits::invoke_result_t<F&&, X&&>::error_type, E>);
+    [[nodiscard]] constexpr auto and_then(F&& func COGLE_CALL_SITE_PARAM) & -> and_then_t<F, ok_arg_t<X, Storage&>> {
+        static_assert(std::is_same_v<typename traits::invoke_result_t<F&&, ok_arg_t<X, Storage&>>::error_type, E>);
+        COGLE_COUNT_PROPAGATION();
 
         return and_then_(storage_, std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto and_then(
-        F&& func) && -> Result<typename traits::invoke_result_t<F&&, X&&>::result_type, E> {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
-        static_assert(std::is_same_v<typename traits::invoke_result_t<F&&, X&&>::error_type, E>);
+    [[nodiscard]] constexpr auto and_then(F&& func COGLE_CALL_SITE_PARAM) && -> and_then_t<F, ok_arg_t<X, Storage&&>> {
+        static_assert(std::is_same_v<typename traits::invoke_result_t<F&&, ok_arg_t<X, Storage&&>>::error_type, E>);
+        COGLE_COUNT_PROPAGATION();
 
         return and_then_(std::move(storage_), std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
     [[nodiscard]] constexpr auto and_then(
-        F&& func) const& -> Result<typename traits::invoke_result_t<F&&, X&&>::result_type, E> {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
-        static_assert(std::is_same_v<typename traits::invoke_result_t<F&&, X&&>::error_type, E>);
+        F&& func COGLE_CALL_SITE_PARAM) const& -> and_then_t<F, ok_arg_t<X, const Storage&>> {
+        static_assert(
+            std::is_same_v<typename traits::invoke_result_t<F&&, ok_arg_t<X, const Storage&>>::error_type, E>);
+        COGLE_COUNT_PROPAGATION();
 
         return and_then_(storage_, std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
     [[nodiscard]] constexpr auto and_then(
-        F&& func) const&& -> Result<typename traits::invoke_result_t<F&&, X&&>::result_type, E> {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
-        static_assert(std::is_same_v<typename traits::invoke_result_t<F&&, X&&>::error_type, E>);
+        F&& func COGLE_CALL_SITE_PARAM) const&& -> and_then_t<F, ok_arg_t<X, const Storage&&>> {
+        static_assert(
+            std::is_same_v<typename traits::invoke_result_t<F&&, ok_arg_t<X, const Storage&&>>::error_type, E>);
+        COGLE_COUNT_PROPAGATION();
 
         return and_then_(std::move(storage_), std::forward<F>(func));
     }
 
     // void Result specialization
     template <typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto and_then(F&& func) & -> Result<typename traits::invoke_result_t<F&&>::result_type, E> {
-        static_assert(traits::is_invocable_v<F&&>);
+    [[nodiscard]] constexpr auto and_then(F&& func COGLE_CALL_SITE_PARAM) & -> and_then_t<F> {
         static_assert(std::is_same_v<typename traits::invoke_result_t<F&&>::error_type, E>);
+        COGLE_COUNT_PROPAGATION();
 
         return and_then_(storage_, std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto and_then(
-        F&& func) && -> Result<typename traits::invoke_result_t<F&&>::result_type, E> {
-        static_assert(traits::is_invocable_v<F&&>);
+    [[nodiscard]] constexpr auto and_then(F&& func COGLE_CALL_SITE_PARAM) && -> and_then_t<F> {
         static_assert(std::is_same_v<typename traits::invoke_result_t<F&&>::error_type, E>);
+        COGLE_COUNT_PROPAGATION();
 
         return and_then_(std::move(storage_), std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto and_then(
-        F&& func) const& -> Result<typename traits::invoke_result_t<F&&>::result_type, E> {
-        static_assert(traits::is_invocable_v<F&&>);
+    [[nodiscard]] constexpr auto and_then(F&& func COGLE_CALL_SITE_PARAM) const& -> and_then_t<F> {
         static_assert(std::is_same_v<typename traits::invoke_result_t<F&&>::error_type, E>);
+        COGLE_COUNT_PROPAGATION();
 
         return and_then_(storage_, std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto and_then(
-        F&& func) const&& -> Result<typename traits::invoke_result_t<F&&>::result_type, E> {
-        static_assert(traits::is_invocable_v<F&&>);
+    [[nodiscard]] constexpr auto and_then(F&& func COGLE_CALL_SITE_PARAM) const&& -> and_then_t<F> {
         static_assert(std::is_same_v<typename traits::invoke_result_t<F&&>::error_type, E>);
+        COGLE_COUNT_PROPAGATION();
 
         return and_then_(std::move(storage_), std::forward<F>(func));
     }
 
     // map<R, Func>(Func&& f) -> Result<U, E>
     // where f(R r) -> U
+    // As with and_then f may take R by value or by a reference matching *this.
     // map: takes a functor that takes the current result and returns a result of type U
     // Example(s):
     // Result<char, int> r{Ok{'a'}};
@@ -797,176 +1395,269 @@ public:
 
     // non-void
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map(F&& func) & -> Result<traits::invoke_result_t<F&&, X&&>, E> {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<F>, X>);
+    [[nodiscard]] constexpr auto map(F&& func COGLE_CALL_SITE_PARAM) & -> map_t<F, ok_arg_t<X, Storage&>> {
+        COGLE_COUNT_PROPAGATION();
 
         return map_(storage_, std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map(F&& func) && -> Result<traits::invoke_result_t<F&&, X&&>, E> {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<F>, X>);
+    [[nodiscard]] constexpr auto map(F&& func COGLE_CALL_SITE_PARAM) && -> map_t<F, ok_arg_t<X, Storage&&>> {
+        COGLE_COUNT_PROPAGATION();
 
         return map_(std::move(storage_), std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map(F&& func) const& -> Result<traits::invoke_result_t<F&&, X&&>, E> {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<F>, X>);
+    [[nodiscard]] constexpr auto map(F&& func COGLE_CALL_SITE_PARAM) const& -> map_t<F, ok_arg_t<X, const Storage&>> {
+        COGLE_COUNT_PROPAGATION();
 
         return map_(storage_, std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map(F&& func) const&& -> Result<traits::invoke_result_t<F&&, X&&>, E> {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<F>, X>);
+    [[nodiscard]] constexpr auto map(F&& func COGLE_CALL_SITE_PARAM) const&& -> map_t<F, ok_arg_t<X, const Storage&&>> {
+        COGLE_COUNT_PROPAGATION();
 
         return map_(std::move(storage_), std::forward<F>(func));
     }
 
     // void Result specialization
     template <typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map(F&& func) & -> Result<traits::invoke_result_t<F&&>, E> {
-        static_assert(traits::is_invocable_v<F&&>);
+    [[nodiscard]] constexpr auto map(F&& func COGLE_CALL_SITE_PARAM) & -> map_t<F> {
+        COGLE_COUNT_PROPAGATION();
 
         return map_(storage_, std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map(F&& func) && -> Result<traits::invoke_result_t<F&&>, E> {
-        static_assert(traits::is_invocable_v<F&&>);
+    [[nodiscard]] constexpr auto map(F&& func COGLE_CALL_SITE_PARAM) && -> map_t<F> {
+        COGLE_COUNT_PROPAGATION();
 
         return map_(std::move(storage_), std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map(F&& func) const& -> Result<traits::invoke_result_t<F&&>, E> {
-        static_assert(traits::is_invocable_v<F&&>);
+    [[nodiscard]] constexpr auto map(F&& func COGLE_CALL_SITE_PARAM) const& -> map_t<F> {
+        COGLE_COUNT_PROPAGATION();
 
         return map_(storage_, std::forward<F>(func));
     }
 
     template <typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map(F&& func) const&& -> Result<traits::invoke_result_t<F&&>, E> {
-        static_assert(traits::is_invocable_v<F&&>);
+    [[nodiscard]] constexpr auto map(F&& func COGLE_CALL_SITE_PARAM) const&& -> map_t<F> {
+        COGLE_COUNT_PROPAGATION();
 
         return map_(std::move(storage_), std::forward<F>(func));
     }
 
+    // map_err<Func>(Func&& f) -> Result<R, U>
+    // where f(E e) -> U
+    // map_err: the error side counterpart of map, f is invoked with the error qualified like *this. The result is moved
+    // out of an rvalue Result.
+    // Example(s):
+    // Result<int, niche::Errno> r{Err{niche::Errno{ENOENT}}};
+    // auto fin = r.map_err([](const niche::Errno& e) { return std::string{std::strerror(e.value)}; });
+    template <typename F>
+    [[nodiscard]] constexpr auto map_err(F&& func COGLE_CALL_SITE_PARAM) & -> map_err_t<F, Storage&> {
+        COGLE_COUNT_PROPAGATION();
+
+        return map_err_(storage_, std::forward<F>(func));
+    }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map_err(F&& func COGLE_CALL_SITE_PARAM) && -> map_err_t<F, Storage&&> {
+        COGLE_COUNT_PROPAGATION();
+
+        return map_err_(std::move(storage_), std::forward<F>(func));
+    }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map_err(F&& func COGLE_CALL_SITE_PARAM) const& -> map_err_t<F, const Storage&> {
+        COGLE_COUNT_PROPAGATION();
+
+        return map_err_(storage_, std::forward<F>(func));
+    }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map_err(F&& func COGLE_CALL_SITE_PARAM) const&& -> map_err_t<F, const Storage&&> {
+        COGLE_COUNT_PROPAGATION();
+
+        return map_err_(std::move(storage_), std::forward<F>(func));
+    }
+
+    // or_else<Func>(Func&& f) -> Result<R, U>
+    // where f(E e) -> Result<R, U>
+    // or_else: the error side counterpart of and_then, f may recover from the error or replace it. The result is moved
+    // out of an rvalue Result.
+    // Example(s):
+    // Result<Config, std::string> r = load(path);
+    // auto fin = std::move(r).or_else([](const std::string&) { return load(DEFAULT_PATH); });
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F&& func) & -> or_else_t<F, Storage&> {
+        return or_else_(storage_, std::forward<F>(func));
+    }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F&& func) && -> or_else_t<F, Storage&&> {
+        return or_else_(std::move(storage_), std::forward<F>(func));
+    }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F&& func) const& -> or_else_t<F, const Storage&> {
+        return or_else_(storage_, std::forward<F>(func));
+    }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F&& func) const&& -> or_else_t<F, const Storage&&> {
+        return or_else_(std::move(storage_), std::forward<F>(func));
+    }
+
+    // unwrap_or<U>(U&& fallback) -> R
+    // unwrap_or: the result, or fallback converted to R if *this holds an error. The result is moved out of an rvalue
+    // Result, use unwrap_or_else when the fallback is expensive to build.
+    // Example(s):
+    // Result<std::string, int> r{Err{1}};
+    // auto fin = std::move(r).unwrap_or("unknown");
+    template <typename U, typename X = R, typename = std::enable_if_t<std::is_convertible_v<U&&, X>>>
+    [[nodiscard]] constexpr R unwrap_or(U&& fallback) & {
+        return unwrap_or_(storage_, std::forward<U>(fallback));
+    }
+
+    template <typename U, typename X = R, typename = std::enable_if_t<std::is_convertible_v<U&&, X>>>
+    [[nodiscard]] constexpr R unwrap_or(U&& fallback) && {
+        return unwrap_or_(std::move(storage_), std::forward<U>(fallback));
+    }
+
+    template <typename U, typename X = R, typename = std::enable_if_t<std::is_convertible_v<U&&, X>>>
+    [[nodiscard]] constexpr R unwrap_or(U&& fallback) const& {
+        return unwrap_or_(storage_, std::forward<U>(fallback));
+    }
+
+    template <typename U, typename X = R, typename = std::enable_if_t<std::is_convertible_v<U&&, X>>>
+    [[nodiscard]] constexpr R unwrap_or(U&& fallback) const&& {
+        return unwrap_or_(std::move(storage_), std::forward<U>(fallback));
+    }
+
+    // unwrap_or_else<Func>(Func&& f) -> R
+    // where f(E e) -> convertable(R) or f() -> convertable(R)
+    // unwrap_or_else: the result, or what f returns if *this holds an error. f is only invoked on an error and may take
+    // the error qualified like *this or nothing at all.
+    // Example(s):
+    // Result<std::string, int> r{Err{1}};
+    // auto fin = r.unwrap_or_else([](int code) { return "error " + std::to_string(code); });
+    template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
+    [[nodiscard]] constexpr R unwrap_or_else(F&& func) & {
+        return unwrap_or_else_(storage_, std::forward<F>(func));
+    }
+
+    template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
+    [[nodiscard]] constexpr R unwrap_or_else(F&& func) && {
+        return unwrap_or_else_(std::move(storage_), std::forward<F>(func));
+    }
+
+    template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
+    [[nodiscard]] constexpr R unwrap_or_else(F&& func) const& {
+        return unwrap_or_else_(storage_, std::forward<F>(func));
+    }
+
+    template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
+    [[nodiscard]] constexpr R unwrap_or_else(F&& func) const&& {
+        return unwrap_or_else_(std::move(storage_), std::forward<F>(func));
+    }
+
+    // value_or<U>(U&& fallback) -> R
+    // value_or: unwrap_or under the name std::optional and std::expected use.
+    template <typename U, typename X = R, typename = std::enable_if_t<std::is_convertible_v<U&&, X>>>
+    [[nodiscard]] constexpr R value_or(U&& fallback) & {
+        return unwrap_or_(storage_, std::forward<U>(fallback));
+    }
+
+    template <typename U, typename X = R, typename = std::enable_if_t<std::is_convertible_v<U&&, X>>>
+    [[nodiscard]] constexpr R value_or(U&& fallback) && {
+        return unwrap_or_(std::move(storage_), std::forward<U>(fallback));
+    }
+
+    template <typename U, typename X = R, typename = std::enable_if_t<std::is_convertible_v<U&&, X>>>
+    [[nodiscard]] constexpr R value_or(U&& fallback) const& {
+        return unwrap_or_(storage_, std::forward<U>(fallback));
+    }
+
+    template <typename U, typename X = R, typename = std::enable_if_t<std::is_convertible_v<U&&, X>>>
+    [[nodiscard]] constexpr R value_or(U&& fallback) const&& {
+        return unwrap_or_(std::move(storage_), std::forward<U>(fallback));
+    }
+
     // match<FuncOk, FuncErr>(FuncR&& ok_func, FuncE&& err_func) -> convertable(ok_func(R), err_func(E))
     // where ok_func(R r) -> U
     // where err_func(E e) -> U
+    // Both functors may take their argument by value or by a reference matching *this, including generic lambdas and
+    // overloaded functors.
     // match: Where ok_func is invokable with type R and err_func is invokable with type E, match will
     // apply the functor based upon the status of the result.
     // Example(s):
 
     template <typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) & -> traits::invoke_result_t<OkF&&, X&&> {
-        static_assert(traits::is_invocable_v<OkF&&, X&&>);
-        static_assert(traits::is_invocable_v<ErrF&&, E&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<OkF>, X>);
-        static_assert(std::is_same_v<traits::first_argument_t<ErrF>, E>);
-        static_assert(std::is_convertible_v<traits::invoke_result_t<ErrF&&, E&&>, traits::invoke_result_t<OkF&&, X&&>>);
-
+    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) & -> match_t<OkF, ErrF, Storage&, X> {
         return match_(storage_, std::forward<OkF>(ok_func), std::forward<ErrF>(err_func));
     }
 
     template <typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) && -> traits::invoke_result_t<OkF&&, X&&> {
-        static_assert(traits::is_invocable_v<OkF&&, X&&>);
-        static_assert(traits::is_invocable_v<ErrF&&, E&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<OkF>, X>);
-        static_assert(std::is_same_v<traits::first_argument_t<ErrF>, E>);
-        static_assert(std::is_convertible_v<traits::invoke_result_t<ErrF&&, E&&>, traits::invoke_result_t<OkF&&, X&&>>);
-
+    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) && -> match_t<OkF, ErrF, Storage&&, X> {
         return match_(std::move(storage_), std::forward<OkF>(ok_func), std::forward<ErrF>(err_func));
     }
 
     template <typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) const& -> traits::invoke_result_t<OkF&&, X&&> {
-        static_assert(traits::is_invocable_v<OkF&&, X&&>);
-        static_assert(traits::is_invocable_v<ErrF&&, E&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<OkF>, X>);
-        static_assert(std::is_same_v<traits::first_argument_t<ErrF>, E>);
-        static_assert(std::is_convertible_v<traits::invoke_result_t<ErrF&&, E&&>, traits::invoke_result_t<OkF&&, X&&>>);
-
+    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) const& -> match_t<OkF, ErrF, const Storage&, X> {
         return match_(storage_, std::forward<OkF>(ok_func), std::forward<ErrF>(err_func));
     }
 
     template <typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) const&& -> traits::invoke_result_t<OkF&&, X&&> {
-        static_assert(traits::is_invocable_v<OkF&&, X&&>);
-        static_assert(traits::is_invocable_v<ErrF&&, E&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<OkF>, X>);
-        static_assert(std::is_same_v<traits::first_argument_t<ErrF>, E>);
-        static_assert(std::is_convertible_v<traits::invoke_result_t<ErrF&&, E&&>, traits::invoke_result_t<OkF&&, X&&>>);
-
+    [[nodiscard]] constexpr auto match(OkF&& ok_func,
+                                       ErrF&& err_func) const&& -> match_t<OkF, ErrF, const Storage&&, X> {
         return match_(std::move(storage_), std::forward<OkF>(ok_func), std::forward<ErrF>(err_func));
     }
 
     // void Result specialization
     template <typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) & -> traits::invoke_result_t<OkF&&> {
-        static_assert(traits::is_invocable_v<OkF&&>);
-        static_assert(traits::is_invocable_v<ErrF&&, E&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<ErrF>, E>);
-        static_assert(std::is_convertible_v<traits::invoke_result_t<ErrF&&, E&&>, traits::invoke_result_t<OkF&&>>);
-
+    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) & -> match_t<OkF, ErrF, Storage&> {
         return match_(storage_, std::forward<OkF>(ok_func), std::forward<ErrF>(err_func));
     }
 
     template <typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) && -> traits::invoke_result_t<OkF&&> {
-        static_assert(traits::is_invocable_v<OkF&&>);
-        static_assert(traits::is_invocable_v<ErrF&&, E&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<ErrF>, E>);
-        static_assert(std::is_convertible_v<traits::invoke_result_t<ErrF&&, E&&>, traits::invoke_result_t<OkF&&>>);
-
+    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) && -> match_t<OkF, ErrF, Storage&&> {
         return match_(std::move(storage_), std::forward<OkF>(ok_func), std::forward<ErrF>(err_func));
     }
 
     template <typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) const& -> traits::invoke_result_t<OkF&&> {
-        static_assert(traits::is_invocable_v<OkF&&>);
-        static_assert(traits::is_invocable_v<ErrF&&, E&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<ErrF>, E>);
-        static_assert(std::is_convertible_v<traits::invoke_result_t<ErrF&&, E&&>, traits::invoke_result_t<OkF&&>>);
-
+    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) const& -> match_t<OkF, ErrF, const Storage&> {
         return match_(storage_, std::forward<OkF>(ok_func), std::forward<ErrF>(err_func));
     }
 
     template <typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) const&& -> traits::invoke_result_t<OkF&&> {
-        static_assert(traits::is_invocable_v<OkF&&>);
-        static_assert(traits::is_invocable_v<ErrF&&, E&&>);
-        static_assert(std::is_same_v<traits::first_argument_t<ErrF>, E>);
-        static_assert(std::is_convertible_v<traits::invoke_result_t<ErrF&&, E&&>, traits::invoke_result_t<OkF&&>>);
-
+    [[nodiscard]] constexpr auto match(OkF&& ok_func, ErrF&& err_func) const&& -> match_t<OkF, ErrF, const Storage&&> {
         return match_(std::move(storage_), std::forward<OkF>(ok_func), std::forward<ErrF>(err_func));
     }
 
     // Custom >> operator non-void function return value
     // This will abort if the result contains error.
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    constexpr std::enable_if_t<!std::is_same_v<traits::invoke_result_t<F&&, X&&>, void>,
-                               traits::invoke_result_t<F&&, X&&>>
+    constexpr std::enable_if_t<!std::is_same_v<traits::invoke_result_t<F&&, ok_arg_t<X, Storage&>>, void>,
+                               traits::invoke_result_t<F&&, ok_arg_t<X, Storage&>>>
     operator>>(F&& func) {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
         return func(storage_.get_result());
     }
 
     // Custom >> operator void function return value
     // This will abort if the result contains error.
     template <typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    constexpr std::enable_if_t<std::is_same_v<traits::invoke_result_t<F&&, X&&>, void>, void> operator>>(F&& func) {
-        static_assert(traits::is_invocable_v<F&&, X&&>);
+    constexpr std::enable_if_t<std::is_same_v<traits::invoke_result_t<F&&, ok_arg_t<X, Storage&>>, void>, void>
+    operator>>(F&& func) {
         func(storage_.get_result());
     }
 
+    COGLE_TAG_RECORD(OK_RECORD, "Expected OK tag to be valid", "Result::operator>>");
+
     // Void R Specialization
     // Custom >> operator non-void function return value
     // This will abort if the result contains error.
@@ -974,7 +1665,7 @@ public:
     constexpr std::enable_if_t<!std::is_same_v<traits::invoke_result_t<F&&>, void>, traits::invoke_result_t<F&&>>
     operator>>(F&& func) {
         static_assert(traits::is_invocable_v<F&&>);
-        detail::assert_ok(storage_.get_tag());
+        detail::assert_ok(storage_.get_tag(), OK_RECORD);
         return func();
     }
 
@@ -984,79 +1675,132 @@ public:
     template <typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
     constexpr std::enable_if_t<std::is_same_v<traits::invoke_result_t<F&&>, void>, void> operator>>(F&& func) {
         static_assert(traits::is_invocable_v<F&&>);
-        detail::assert_ok(storage_.get_tag());
+        detail::assert_ok(storage_.get_tag(), OK_RECORD);
         func();
     }
 
     // Custom *(derefernce) operator will return value
     // This will abort if the result contains an error.
-    template <typename U = R>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, U&> operator*() & noexcept {
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) operator*() & noexcept {
         return result();
     }
 
-    template <typename U = R>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, U&&> operator*() && noexcept {
-        return std::move(result());
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) operator*() && noexcept {
+        return std::move(*this).result();
     }
 
-    template <typename U = R>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, const U&> operator*() const& noexcept {
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) operator*() const& noexcept {
         return result();
     }
 
-    template <typename U = R>
-    [[nodiscard]] constexpr std::enable_if_t<!std::is_void_v<U>, const U&&> operator*() const&& noexcept {
-        return std::move(result());
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] constexpr decltype(auto) operator*() const&& noexcept {
+        return std::move(*this).result();
     }
 
 private:
+    // Unpacks the arguments referenced by EmplaceOk and EmplaceErr
+    template <std::size_t... I, typename Tag, typename Tuple>
+    constexpr Result(std::index_sequence<I...>, Tag tag, Tuple&& args) noexcept(
+        std::is_nothrow_constructible_v<Storage, Tag, std::tuple_element_t<I, std::decay_t<Tuple>>...>)
+        : storage_(tag, std::get<I>(std::forward<Tuple>(args))...) {}
+
     // Non-void and_then_
     template <typename S, typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto and_then_(S&& s, F&& func)
-        -> Result<typename traits::invoke_result_t<F&&, X&&>::result_type, E> {
+    [[nodiscard]] constexpr auto and_then_(S&& s, F&& func) const -> and_then_t<F, ok_arg_t<X, S&&>> {
         if (is_ok()) {
             return func(std::forward<S>(s).get_result());
         } else {
-            return Err<E>{std::forward<S>(s).get_error()};
+            return Err<E>{detail::propagate, std::forward<S>(s).get_error()};
         }
     }
 
     // void specialization and_then_
     template <typename S, typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto and_then_(S&& s, F&& func)
-        -> Result<typename traits::invoke_result_t<F&&>::result_type, E> {
+    [[nodiscard]] constexpr auto and_then_(S&& s, F&& func) const -> and_then_t<F> {
         if (is_ok()) {
             return func();
         } else {
-            return Err<E>{std::forward<S>(s).get_error()};
+            return Err<E>{detail::propagate, std::forward<S>(s).get_error()};
         }
     }
 
     // Non-void map_
     template <typename S, typename F, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map_(S&& s, F&& func) -> Result<traits::invoke_result_t<F&&, X&&>, E> {
+    [[nodiscard]] constexpr auto map_(S&& s, F&& func) const -> map_t<F, ok_arg_t<X, S&&>> {
         if (is_ok()) {
-            return Ok<traits::invoke_result_t<F&&, X&&>>{func(std::forward<S>(s).get_result())};
+            return Ok<traits::invoke_result_t<F&&, ok_arg_t<X, S&&>>>{func(std::forward<S>(s).get_result())};
         } else {
-            return Err<E>{std::forward<S>(s).get_error()};
+            return Err<E>{detail::propagate, std::forward<S>(s).get_error()};
         }
     }
 
     // void specialization map_
     template <typename S, typename F, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto map_(S&& s, F&& func) -> Result<traits::invoke_result_t<F&&>, E> {
+    [[nodiscard]] constexpr auto map_(S&& s, F&& func) const -> map_t<F> {
         if (is_ok()) {
             return Ok<traits::invoke_result_t<F&&>>{func()};
         } else {
-            return Err<E>{std::forward<S>(s).get_error()};
+            return Err<E>{detail::propagate, std::forward<S>(s).get_error()};
+        }
+    }
+
+    // The result is passed on in place, an rvalue storage moves it
+    template <typename S, typename F>
+    [[nodiscard]] constexpr auto map_err_(S&& s, F&& func) const -> map_err_t<F, S&&> {
+        if (is_ok()) {
+            if constexpr (std::is_void_v<R>) {
+                return map_err_t<F, S&&>{in_place_ok};
+            } else {
+                return map_err_t<F, S&&>{in_place_ok, std::forward<S>(s).get_result()};
+            }
+        } else {
+            return map_err_t<F, S&&>{in_place_err, func(std::forward<S>(s).get_error())};
+        }
+    }
+
+    template <typename S, typename F>
+    [[nodiscard]] constexpr auto or_else_(S&& s, F&& func) const -> or_else_t<F, S&&> {
+        static_assert(std::is_same_v<typename traits::invoke_result_t<F&&, err_arg_t<S&&>>::result_type, R>);
+
+        if (is_ok()) {
+            if constexpr (std::is_void_v<R>) {
+                return or_else_t<F, S&&>{in_place_ok};
+            } else {
+                return or_else_t<F, S&&>{in_place_ok, std::forward<S>(s).get_result()};
+            }
+        } else {
+            return func(std::forward<S>(s).get_error());
+        }
+    }
+
+    template <typename S, typename U>
+    [[nodiscard]] constexpr R unwrap_or_(S&& s, U&& fallback) const {
+        if (is_ok()) {
+            return std::forward<S>(s).get_result();
+        } else {
+            return std::forward<U>(fallback);
+        }
+    }
+
+    template <typename S, typename F>
+    [[nodiscard]] constexpr R unwrap_or_else_(S&& s, F&& func) const {
+        if (is_ok()) {
+            return std::forward<S>(s).get_result();
+        } else if constexpr (traits::is_invocable_v<F&&, err_arg_t<S&&>>) {
+            return func(std::forward<S>(s).get_error());
+        } else {
+            static_assert(traits::is_invocable_v<F&&>, "unwrap_or_else requires a functor taking the error or nothing");
+            return func();
         }
     }
 
     // Non-void match_
     template <typename S, typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<!std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match_(S&& s, OkF&& ok_func,
-                                        ErrF&& err_func) & -> traits::invoke_result_t<OkF&&, X&&> {
+    [[nodiscard]] constexpr auto match_(S&& s, OkF&& ok_func, ErrF&& err_func) const -> match_t<OkF, ErrF, S&&, X> {
         if (is_ok()) {
             return ok_func(std::forward<S>(s).get_result());
         } else {
@@ -1066,7 +1810,7 @@ private:
 
     // void specialization match_
     template <typename S, typename OkF, typename ErrF, typename X = R, typename = std::enable_if_t<std::is_void_v<X>>>
-    [[nodiscard]] constexpr auto match_(S&& s, OkF&& ok_func, ErrF&& err_func) & -> traits::invoke_result_t<OkF&&> {
+    [[nodiscard]] constexpr auto match_(S&& s, OkF&& ok_func, ErrF&& err_func) const -> match_t<OkF, ErrF, S&&> {
         if (is_ok()) {
             return ok_func();
         } else {
@@ -1077,6 +1821,62 @@ private:
     Storage storage_;
 };
 
+namespace detail {
+template <typename T>
+constexpr std::size_t payload_size_v = std::is_void_v<T> ? 0 : sizeof(std::conditional_t<std::is_void_v<T>, char, T>);
+
+// References are stored as pointers
+template <typename T>
+constexpr std::size_t payload_size_v<T&> = sizeof(T*);
+
+template <typename R, typename E, typename = void>
+struct PayloadLayout {
+    static constexpr std::size_t payload_size = std::max(payload_size_v<R>, payload_size_v<E>);
+    static constexpr std::size_t tag_size     = sizeof(ResultTag);
+};
+
+template <typename R, typename E>
+struct PayloadLayout<R, E, std::enable_if_t<niche::is_niche_v<R, E>>> {
+    static constexpr std::size_t payload_size = sizeof(typename niche::niche_traits<R, E>::storage_type);
+    static constexpr std::size_t tag_size     = 0;
+};
+
+// Laid out like the Result<T*, E> that stores the reference
+template <typename R, typename E>
+struct PayloadLayout<R, E, std::enable_if_t<!niche::is_niche_v<R, E> && std::is_reference_v<R>>>
+    : PayloadLayout<std::remove_reference_t<R>*, E> {};
+}  // namespace detail
+
+// layout_report<R, E> describes the memory footprint of a Result<R, E> at compile time so that layouts can be pinned
+// down with static_asserts, e.g. static_assert(layout_report<char, char>::size == 2).
+// The tag is always placed after the payload, niche Results (see niche::niche_traits) do not store a tag.
+template <typename R, typename E>
+struct layout_report {
+    static constexpr std::size_t size         = sizeof(Result<R, E>);
+    static constexpr std::size_t alignment    = alignof(Result<R, E>);
+    static constexpr std::size_t payload_size = detail::PayloadLayout<R, E>::payload_size;
+    static constexpr std::size_t tag_size     = detail::PayloadLayout<R, E>::tag_size;
+    static constexpr std::size_t padding      = size - payload_size - tag_size;
+    static constexpr bool is_niche            = niche::is_niche_v<R, E>;
+
+    friend std::ostream& operator<<(std::ostream& os, const layout_report&) {
+        os << "Size: " << size << "\tAlign: " << alignment << "\tPayload: " << payload_size << "\tTag: " << tag_size
+           << "\tPadding: " << padding << "\tNiche: " << is_niche;
+        return os;
+    }
+};
+
 }  // namespace result
+
+namespace traits {
+// A Result only holds its tag next to R or E, it can be relocated whenever both of them can.
+template <typename R, typename E>
+struct is_trivially_relocatable<result::Result<R, E>>
+    : std::bool_constant<is_trivially_relocatable_v<R> && is_trivially_relocatable_v<E>> {};
+}  // namespace traits
+
 }  // namespace utils
-}  // namespace cogle
\ No newline at end of file
+}  // namespace cogle
+
+#undef COGLE_CALL_SITE_PARAM
+#undef COGLE_COUNT_PROPAGATION
\ No newline at end of file
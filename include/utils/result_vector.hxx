@@ -0,0 +1,534 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <utils/compatibility.hxx>
+#include <utils/relocate.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) && defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+namespace cogle {
+namespace utils {
+namespace result {
+
+namespace detail {
+namespace bitmap {
+constexpr std::size_t WORD_BITS = 64;
+
+// All bits below bits, bits in [1, 64]
+constexpr std::uint64_t low_mask(const std::size_t bits) noexcept {
+    return bits >= WORD_BITS ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+}
+
+inline std::size_t popcount(const std::uint64_t word) noexcept {
+    return static_cast<std::size_t>(__builtin_popcountll(word));
+}
+
+inline std::size_t ctz(const std::uint64_t word) noexcept { return static_cast<std::size_t>(__builtin_ctzll(word)); }
+
+// The scalar fallbacks, also used for the words the vector loops leave over
+inline std::size_t count_scalar(const std::uint64_t* words, const std::size_t n) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        count += popcount(words[i]);
+    }
+    return count;
+}
+
+// Index of the first word that is not equal to flip, n if there is none. flip is 0 to look for set bits and all ones to
+// look for clear bits.
+inline std::size_t find_scalar(const std::uint64_t* words, const std::size_t n, const std::uint64_t flip) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (words[i] != flip) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#if defined(__AVX2__)
+// Nibble lookup popcount, four words at a time
+inline std::size_t count(const std::uint64_t* words, const std::size_t n) noexcept {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,  //
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i total        = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i v      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        const __m256i lo     = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, nibble));
+        const __m256i hi     = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        const __m256i counts = _mm256_add_epi8(lo, hi);
+        total                = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+
+    const auto sum = static_cast<std::size_t>(_mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) +
+                                              _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3));
+    return sum + count_scalar(words + i, n - i);
+}
+
+inline std::size_t find(const std::uint64_t* words, const std::size_t n, const std::uint64_t flip) noexcept {
+    const __m256i inverse = _mm256_set1_epi64x(static_cast<long long>(flip));
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i)), inverse);
+        if (!_mm256_testz_si256(v, v)) {
+            break;
+        }
+    }
+    return i + find_scalar(words + i, n - i, flip);
+}
+#elif defined(__SSE2__) && defined(__x86_64__)
+// Parallel bit count within each byte, two words at a time
+inline std::size_t count(const std::uint64_t* words, const std::size_t n) noexcept {
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0F);
+    __m128i total    = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        v         = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+        v         = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+        v         = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+        total     = _mm_add_epi64(total, _mm_sad_epu8(v, _mm_setzero_si128()));
+    }
+
+    const auto sum = static_cast<std::size_t>(_mm_cvtsi128_si64(total) +
+                                              _mm_cvtsi128_si64(_mm_unpackhi_epi64(total, total)));
+    return sum + count_scalar(words + i, n - i);
+}
+
+inline std::size_t find(const std::uint64_t* words, const std::size_t n, const std::uint64_t flip) noexcept {
+    const __m128i inverse = _mm_set1_epi64x(static_cast<long long>(flip));
+
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i)), inverse);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(v, _mm_setzero_si128())) != 0xFFFF) {
+            break;
+        }
+    }
+    return i + find_scalar(words + i, n - i, flip);
+}
+#else
+inline std::size_t count(const std::uint64_t* words, const std::size_t n) noexcept { return count_scalar(words, n); }
+
+inline std::size_t find(const std::uint64_t* words, const std::size_t n, const std::uint64_t flip) noexcept {
+    return find_scalar(words, n, flip);
+}
+#endif
+}  // namespace bitmap
+
+// Stands in for the column of results when R is void, only the number of results is kept
+struct VoidColumn {
+    void emplace_back() noexcept { ++size; }
+    void reserve(std::size_t) noexcept {}
+    void clear() noexcept { size = 0; }
+
+    std::size_t size = 0;
+};
+}  // namespace detail
+
+// A sequence of Results laid out as a structure of arrays for batch workloads. The tags are kept as a bitmap, one bit
+// per element that is set for an error, and the results and errors each in their own dense array in the order they
+// were appended. Looking for failures only reads the bitmap, 64 elements per word, and walking the results or the
+// errors is a linear pass over their array.
+//
+// Elements are appended and cannot change between holding a result and an error. Indexing hands out views that behave
+// like a Result, the payloads themselves can be modified through them.
+template <typename R, typename E>
+class ResultVector {
+    static_assert(!std::is_reference_v<R> && !std::is_reference_v<E>, "ResultVector cannot hold references");
+
+    using OkColumn  = std::conditional_t<std::is_void_v<R>, detail::VoidColumn, relocate::Buffer<R>>;
+    using ErrColumn = relocate::Buffer<E>;
+
+    static constexpr std::size_t WORD_BITS = detail::bitmap::WORD_BITS;
+    static constexpr std::uint64_t ALL_SET = ~std::uint64_t{0};
+
+public:
+    using value_type = Result<R, E>;
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // A view of one element with the accessors of Result, Const views only hand out const payloads
+    template <bool Const>
+    class basic_reference {
+        using Vector = std::conditional_t<Const, const ResultVector, ResultVector>;
+
+    public:
+        [[nodiscard]] bool is_ok() const noexcept { return !err_; }
+        [[nodiscard]] bool is_err() const noexcept { return err_; }
+        [[nodiscard]] explicit operator bool() const noexcept { return is_ok(); }
+
+        [[nodiscard]] std::size_t index() const noexcept { return index_; }
+
+        COGLE_TAG_RECORD(OK_RECORD, "Expected OK tag to be valid", "ResultVector::Ref::result");
+        COGLE_TAG_RECORD(ERR_RECORD, "Expected ERR tag to be valid", "ResultVector::Ref::error");
+
+        template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+        [[nodiscard]] auto& result() const noexcept {
+            detail::assert_ok(tag(), OK_RECORD);
+            return vector_->oks_[slot_];
+        }
+
+        [[nodiscard]] auto& error() const noexcept {
+            detail::assert_err(tag(), ERR_RECORD);
+            return vector_->errs_[slot_];
+        }
+
+        template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+        [[nodiscard]] auto& unwrap_unchecked() const noexcept {
+            ASSUME(is_ok());
+            return vector_->oks_[slot_];
+        }
+
+        [[nodiscard]] auto& error_unchecked() const noexcept {
+            ASSUME(is_err());
+            return vector_->errs_[slot_];
+        }
+
+        template <typename OkF, typename ErrF>
+        [[nodiscard]] decltype(auto) match(OkF&& ok_func, ErrF&& err_func) const {
+            if (is_ok()) {
+                if constexpr (std::is_void_v<R>) {
+                    return ok_func();
+                } else {
+                    return ok_func(unwrap_unchecked());
+                }
+            } else {
+                return err_func(error_unchecked());
+            }
+        }
+
+        // Copies the element out into a Result
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        operator Result<R, E>() const {
+            if (err_) {
+                return Result<R, E>{in_place_err, error_unchecked()};
+            }
+            if constexpr (std::is_void_v<R>) {
+                return Result<R, E>{in_place_ok};
+            } else {
+                return Result<R, E>{in_place_ok, unwrap_unchecked()};
+            }
+        }
+
+    private:
+        basic_reference(Vector& vector, const std::size_t index) noexcept
+            : vector_(&vector), index_(index), err_(vector.is_err_at(index)) {
+            const std::size_t errs_before = vector.errs_before(index);
+            slot_                         = err_ ? errs_before : index - errs_before;
+        }
+
+        [[nodiscard]] detail::ResultTag tag() const noexcept {
+            return err_ ? detail::ResultTag::ERR : detail::ResultTag::OK;
+        }
+
+        Vector* vector_;
+        std::size_t index_;
+        std::size_t slot_ = 0;
+        bool err_;
+
+        friend class ResultVector;
+    };
+
+    using reference       = basic_reference<false>;
+    using const_reference = basic_reference<true>;
+
+    template <bool Const>
+    class basic_iterator {
+        using Vector = std::conditional_t<Const, const ResultVector, ResultVector>;
+
+    public:
+        [[nodiscard]] basic_reference<Const> operator*() const noexcept {
+            return basic_reference<Const>{*vector_, index_};
+        }
+
+        basic_iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        [[nodiscard]] bool operator==(const basic_iterator& o) const noexcept { return index_ == o.index_; }
+        [[nodiscard]] bool operator!=(const basic_iterator& o) const noexcept { return index_ != o.index_; }
+
+    private:
+        basic_iterator(Vector& vector, const std::size_t index) noexcept : vector_(&vector), index_(index) {}
+
+        Vector* vector_;
+        std::size_t index_;
+
+        friend class ResultVector;
+    };
+
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    ResultVector() = default;
+
+    ResultVector(const ResultVector&)            = delete;
+    ResultVector& operator=(const ResultVector&) = delete;
+
+    ResultVector(ResultVector&& o) noexcept
+        : words_(std::move(o.words_)),
+          ranks_(std::move(o.ranks_)),
+          oks_(std::move(o.oks_)),
+          errs_(std::move(o.errs_)),
+          size_(std::exchange(o.size_, 0)) {
+        o.clear();
+    }
+
+    ResultVector& operator=(ResultVector&& o) noexcept {
+        if (this != &o) {
+            words_ = std::move(o.words_);
+            ranks_ = std::move(o.ranks_);
+            oks_   = std::move(o.oks_);
+            errs_  = std::move(o.errs_);
+            size_  = std::exchange(o.size_, 0);
+            o.clear();
+        }
+        return *this;
+    }
+
+    template <typename... Args>
+    void emplace_ok(Args&&... args) {
+        reserve_word();
+        oks_.emplace_back(std::forward<Args>(args)...);
+        append_bit(false);
+    }
+
+    template <typename... Args>
+    void emplace_err(Args&&... args) {
+        reserve_word();
+        errs_.emplace_back(std::forward<Args>(args)...);
+        append_bit(true);
+    }
+
+    void push_back(const Result<R, E>& result) { push_back_(result); }
+    void push_back(Result<R, E>&& result) { push_back_(std::move(result)); }
+
+    // Reserves room for size elements, of which expected_errs are errors
+    void reserve(const std::size_t size, const std::size_t expected_errs = 0) {
+        const std::size_t words = (size + WORD_BITS - 1) / WORD_BITS;
+        words_.reserve(words);
+        ranks_.reserve(words);
+        oks_.reserve(size - std::min(size, expected_errs));
+        errs_.reserve(expected_errs);
+    }
+
+    void clear() noexcept {
+        words_.clear();
+        ranks_.clear();
+        oks_.clear();
+        errs_.clear();
+        size_ = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    [[nodiscard]] reference operator[](const std::size_t idx) noexcept { return reference{*this, idx}; }
+    [[nodiscard]] const_reference operator[](const std::size_t idx) const noexcept {
+        return const_reference{*this, idx};
+    }
+
+    [[nodiscard]] iterator begin() noexcept { return iterator{*this, 0}; }
+    [[nodiscard]] iterator end() noexcept { return iterator{*this, size_}; }
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator{*this, 0}; }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator{*this, size_}; }
+
+    [[nodiscard]] std::size_t count_err() const noexcept { return errs_.size(); }
+    [[nodiscard]] std::size_t count_ok() const noexcept { return size_ - errs_.size(); }
+
+    // Number of errors among the elements [first, last)
+    [[nodiscard]] std::size_t count_err(std::size_t first, std::size_t last) const noexcept {
+        last = std::min(last, size_);
+        if (first >= last) {
+            return 0;
+        }
+
+        const std::size_t first_word = first / WORD_BITS;
+        const std::size_t last_word  = (last - 1) / WORD_BITS;
+        const std::uint64_t head     = words_[first_word] >> (first % WORD_BITS);
+        if (first_word == last_word) {
+            return detail::bitmap::popcount(head & detail::bitmap::low_mask(last - first));
+        }
+
+        const std::uint64_t tail = words_[last_word] & detail::bitmap::low_mask(last - last_word * WORD_BITS);
+        return detail::bitmap::popcount(head) +
+               detail::bitmap::count(words_.data() + first_word + 1, last_word - first_word - 1) +
+               detail::bitmap::popcount(tail);
+    }
+
+    [[nodiscard]] std::size_t count_ok(const std::size_t first, const std::size_t last) const noexcept {
+        const std::size_t end = std::min(last, size_);
+        return first >= end ? 0 : end - first - count_err(first, end);
+    }
+
+    // Index of the first error or result at or after from, npos if there is none
+    [[nodiscard]] std::size_t first_err(const std::size_t from = 0) const noexcept { return find(from, 0); }
+    [[nodiscard]] std::size_t first_ok(const std::size_t from = 0) const noexcept { return find(from, ALL_SET); }
+
+    // func(index, error) for every error in order
+    template <typename F>
+    void for_each_err(F&& func) {
+        for_each_err_(*this, std::forward<F>(func));
+    }
+
+    template <typename F>
+    void for_each_err(F&& func) const {
+        for_each_err_(*this, std::forward<F>(func));
+    }
+
+    // func(index, result) for every result in order, func(index) for a void R
+    template <typename F>
+    void for_each_ok(F&& func) {
+        for_each_ok_(*this, std::forward<F>(func));
+    }
+
+    template <typename F>
+    void for_each_ok(F&& func) const {
+        for_each_ok_(*this, std::forward<F>(func));
+    }
+
+    // The dense arrays of results and errors, in the order they were appended
+    template <typename U = R, typename = std::enable_if_t<!std::is_void_v<U>>>
+    [[nodiscard]] const U* ok_data() const noexcept {
+        return oks_.data();
+    }
+
+    [[nodiscard]] const E* err_data() const noexcept { return errs_.data(); }
+
+    // The tag bitmap, bit i % 64 of word i / 64 is set if element i is an error. Bits past size() are clear.
+    [[nodiscard]] const std::uint64_t* tag_words() const noexcept { return words_.data(); }
+    [[nodiscard]] std::size_t tag_word_count() const noexcept { return words_.size(); }
+
+private:
+    template <typename Res>
+    void push_back_(Res&& result) {
+        if (result.is_err()) {
+            emplace_err(std::forward<Res>(result).error_unchecked());
+        } else if constexpr (std::is_void_v<R>) {
+            emplace_ok();
+        } else {
+            emplace_ok(std::forward<Res>(result).unwrap_unchecked());
+        }
+    }
+
+    // Grows the bitmap ahead of the payload so that appending the bit cannot fail once the payload is in place
+    void reserve_word() {
+        if (size_ % WORD_BITS == 0 && words_.size() == words_.capacity()) {
+            const std::size_t capacity = std::max<std::size_t>(INITIAL_WORDS, words_.capacity() * 2);
+            words_.reserve(capacity);
+            ranks_.reserve(capacity);
+        }
+    }
+
+    void append_bit(const bool err) noexcept {
+        if (size_ % WORD_BITS == 0) {
+            // The current element is already in its column
+            words_.push_back(0);
+            ranks_.push_back(errs_.size() - (err ? 1 : 0));
+        }
+        if (err) {
+            words_.back() |= std::uint64_t{1} << (size_ % WORD_BITS);
+        }
+        ++size_;
+    }
+
+    [[nodiscard]] bool is_err_at(const std::size_t idx) const noexcept {
+        return ((words_[idx / WORD_BITS] >> (idx % WORD_BITS)) & 1) != 0;
+    }
+
+    // Number of errors before idx, which is also the position of idx in its column when it is an error
+    [[nodiscard]] std::size_t errs_before(const std::size_t idx) const noexcept {
+        const std::size_t word = idx / WORD_BITS;
+        return ranks_[word] + detail::bitmap::popcount(words_[word] & detail::bitmap::low_mask(idx % WORD_BITS));
+    }
+
+    // The bits past size_ are clear, looking for results they have to be masked out
+    [[nodiscard]] std::uint64_t word_bits(const std::size_t word, const std::uint64_t flip) const noexcept {
+        const std::uint64_t bits = words_[word] ^ flip;
+        return word + 1 == words_.size() ? bits & detail::bitmap::low_mask(size_ - word * WORD_BITS) : bits;
+    }
+
+    [[nodiscard]] std::size_t find(const std::size_t from, const std::uint64_t flip) const noexcept {
+        if (from >= size_) {
+            return npos;
+        }
+
+        std::size_t word   = from / WORD_BITS;
+        std::uint64_t bits = word_bits(word, flip) & ~detail::bitmap::low_mask(from % WORD_BITS);
+        if (bits == 0) {
+            ++word;
+            word += detail::bitmap::find(words_.data() + word, words_.size() - word, flip);
+            if (word == words_.size()) {
+                return npos;
+            }
+            bits = word_bits(word, flip);
+            if (bits == 0) {
+                return npos;
+            }
+        }
+        return word * WORD_BITS + detail::bitmap::ctz(bits);
+    }
+
+    // func(index) for every element whose bit differs from flip, runs of words without any are skipped
+    template <typename F>
+    void scan(const std::uint64_t flip, F&& func) const {
+        const std::size_t words = words_.size();
+        std::size_t word        = detail::bitmap::find(words_.data(), words, flip);
+        while (word < words) {
+            for (std::uint64_t bits = word_bits(word, flip); bits != 0; bits &= bits - 1) {
+                func(word * WORD_BITS + detail::bitmap::ctz(bits));
+            }
+            ++word;
+            word += detail::bitmap::find(words_.data() + word, words - word, flip);
+        }
+    }
+
+    template <typename Self, typename F>
+    static void for_each_err_(Self& self, F&& func) {
+        std::size_t slot = 0;
+        self.scan(0, [&](const std::size_t idx) { func(idx, self.errs_[slot++]); });
+    }
+
+    template <typename Self, typename F>
+    static void for_each_ok_(Self& self, F&& func) {
+        std::size_t slot = 0;
+        self.scan(ALL_SET, [&](const std::size_t idx) {
+            if constexpr (std::is_void_v<R>) {
+                func(idx);
+            } else {
+                func(idx, self.oks_[slot++]);
+            }
+        });
+    }
+
+    static constexpr std::size_t INITIAL_WORDS = 4;
+
+    std::vector<std::uint64_t> words_;
+    // Number of errors before each word of the bitmap
+    std::vector<std::size_t> ranks_;
+    OkColumn oks_;
+    ErrColumn errs_;
+    std::size_t size_ = 0;
+};
+
+}  // namespace result
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
@@ -0,0 +1,513 @@
+#pragma once
+
+// Streaming pipeline of stages returning Result, every stage running on a thread of its own.
+//
+//     auto ingest = make_stream<Line>(StreamOptions{}, parse, validate, write);
+//     for (std::vector<Line>& lines : reader) {
+//         if (!ingest.push_batch(lines)) {
+//             break;
+//         }
+//     }
+//     Result<void, StageError<Error>> done = ingest.finish();
+//
+// The first stage is called with the pushed items, every other one with the values of the stage before it, the last
+// stage consumes them and returns Result<void, E>. Stages are connected by bounded single producer single consumer
+// rings, a stage whose output ring is full waits for the next one to catch up, so a slow stage holds back the stages
+// before it and in the end push. Items cross a ring in batches of up to options.batch: a stage takes everything queued
+// rather than waiting for a full batch, then pays the synchronization of the ring and the update of its counters once
+// for the whole batch.
+//
+// With OnError::Stop the first error stops every stage, queued items are dropped and finish() returns the error with
+// the index of the failing stage. With OnError::Route the failing item is dropped, its error is queued on a side
+// channel drained by take_errors() and the stream goes on. As for ThreadPool::submit, stage functions must not throw.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <utils/abort.hxx>
+#include <utils/compatibility.hxx>
+#include <utils/futex.hxx>
+#include <utils/result.hxx>
+#include <vector>
+
+namespace cogle {
+namespace utils {
+namespace stream {
+
+enum class OnError {
+    // The first error ends the stream
+    Stop,
+    // Errors go to the side channel, the stream goes on
+    Route,
+};
+
+struct StreamOptions {
+    // Capacity of the ring in front of every stage, rounded up to a power of two
+    std::size_t capacity = 1024;
+    // Most items a stage takes from its ring at once
+    std::size_t batch = 64;
+    OnError on_error = OnError::Stop;
+};
+
+template <typename E>
+struct StageError {
+    // Index of the failing stage, in the order given to make_stream
+    std::size_t stage;
+    E error;
+};
+
+// Counters of one stage, received - produced - failed items are being processed or were dropped by a stopped stream
+struct StageCounters {
+    // Items taken from the input ring
+    std::uint64_t received;
+    // Items passed on to the next stage, or consumed by the last one
+    std::uint64_t produced;
+    std::uint64_t failed;
+    std::uint64_t batches;
+    // Items waiting in the input ring
+    std::size_t queued;
+};
+
+namespace detail {
+// Bounded ring between one producer and one consumer thread. Every side caches the index of the other one and only
+// reloads it when the ring looks full or empty. A side that has to wait yields for a while, then sleeps until the other
+// side signals progress, which it only does when it sees a sleeper.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(const std::size_t capacity) : mask_(round_up(capacity) - 1), slots_(new Slot[mask_ + 1]) {}
+
+    SpscRing(const SpscRing&)            = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    ~SpscRing() {
+        for (std::size_t index = head_.load(); index != tail_.load(); ++index) {
+            slot(index)->~T();
+        }
+    }
+
+    // Moves items into the ring, waiting while it is full, leaves items empty. False if the ring was cancelled, the
+    // items not moved yet are dropped.
+    bool push(std::vector<T>& items) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t done = 0;
+        while (done < items.size()) {
+            UNLIKELY_IF(tail - head_cache_ > mask_) {
+                const auto writable = [this, tail] {
+                    head_cache_ = head_.load(std::memory_order_acquire);
+                    return tail - head_cache_ <= mask_;
+                };
+                UNLIKELY_IF(!wait(producer_waiting_, writable_, writable)) {
+                    items.clear();
+                    return false;
+                }
+            }
+            const std::size_t count = std::min(mask_ + 1 - (tail - head_cache_), items.size() - done);
+            for (std::size_t i = 0; i < count; ++i) {
+                new (slot(tail + i)) T(std::move(items[done + i]));
+            }
+            tail += count;
+            done += count;
+            tail_.store(tail, std::memory_order_release);
+            signal(consumer_waiting_, readable_);
+        }
+        items.clear();
+        return true;
+    }
+
+    // Appends up to max items to out, waiting while the ring is empty. False once the ring is closed and empty, or
+    // cancelled.
+    bool pop(std::vector<T>& out, const std::size_t max) {
+        UNLIKELY_IF(cancelled_.load(std::memory_order_relaxed)) { return false; }
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        UNLIKELY_IF(tail_cache_ == head) {
+            const auto readable = [this, head] {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                return tail_cache_ != head || closed_.load(std::memory_order_acquire);
+            };
+            UNLIKELY_IF(!wait(consumer_waiting_, readable_, readable)) { return false; }
+            // Closed, the last items may have been pushed after tail was loaded
+            if (tail_cache_ == head) {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (tail_cache_ == head) {
+                    return false;
+                }
+            }
+        }
+        const std::size_t count = std::min(max, tail_cache_ - head);
+        for (std::size_t i = 0; i < count; ++i) {
+            T* item = slot(head + i);
+            out.push_back(std::move(*item));
+            item->~T();
+        }
+        head_.store(head + count, std::memory_order_release);
+        signal(producer_waiting_, writable_);
+        return true;
+    }
+
+    // Called by the producer after its last push
+    void close() noexcept {
+        closed_.store(true, std::memory_order_release);
+        signal(consumer_waiting_, readable_);
+    }
+
+    // Wakes both sides, push and pop fail from now on
+    void cancel() noexcept {
+        cancelled_.store(true, std::memory_order_release);
+        wake(readable_);
+        wake(writable_);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        return tail_.load(std::memory_order_relaxed) - head;
+    }
+
+private:
+    struct Slot {
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    static constexpr int SPINS = 64;
+
+    static std::size_t round_up(const std::size_t capacity) noexcept {
+        std::size_t size = 1;
+        while (size < capacity) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    [[nodiscard]] T* slot(const std::size_t index) const noexcept {
+        return std::launder(reinterpret_cast<T*>(slots_[index & mask_].storage));
+    }
+
+    // Waits until ready() holds, false if the ring is cancelled first
+    template <typename Ready>
+    bool wait(std::atomic<bool>& waiting, std::atomic<std::uint32_t>& progress, const Ready& ready) {
+        for (int idle = 0;; ++idle) {
+            if (ready()) {
+                return true;
+            }
+            if (cancelled_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            if (idle < SPINS) {
+                std::this_thread::yield();
+                continue;
+            }
+            // Pairs with the fence of signal, either the other side sees waiting or ready() sees its progress
+            const std::uint32_t seen = progress.load(std::memory_order_acquire);
+            waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!ready() && !cancelled_.load(std::memory_order_acquire)) {
+                futex::wait(progress, seen);
+            }
+            waiting.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    static void signal(std::atomic<bool>& waiting, std::atomic<std::uint32_t>& progress) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        UNLIKELY_IF(waiting.load(std::memory_order_relaxed)) { wake(progress); }
+    }
+
+    static void wake(std::atomic<std::uint32_t>& progress) noexcept {
+        progress.fetch_add(1, std::memory_order_release);
+        futex::wake_all(progress);
+    }
+
+    const std::size_t mask_;
+    const std::unique_ptr<Slot[]> slots_;
+
+    // Consumer side
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_ = 0;
+    std::atomic<bool> consumer_waiting_{false};
+    std::atomic<std::uint32_t> readable_{0};
+
+    // Producer side
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_ = 0;
+    std::atomic<bool> producer_waiting_{false};
+    std::atomic<std::uint32_t> writable_{0};
+
+    alignas(CACHE_LINE) std::atomic<bool> closed_{false};
+    std::atomic<bool> cancelled_{false};
+};
+
+// Written by the stage thread only, read by counters()
+struct alignas(CACHE_LINE) StageStats {
+    std::atomic<std::uint64_t> received{0};
+    std::atomic<std::uint64_t> produced{0};
+    std::atomic<std::uint64_t> failed{0};
+    std::atomic<std::uint64_t> batches{0};
+
+    static void add(std::atomic<std::uint64_t>& counter, const std::uint64_t count) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+};
+
+// The item types entering every stage, std::tuple<In, Out0, ..., OutN-2>
+template <typename In, typename... Fs>
+struct stage_items {
+    using type = std::tuple<>;
+};
+
+template <typename In, typename F>
+struct stage_items<In, F> {
+    using type = std::tuple<In>;
+};
+
+template <typename In, typename F, typename G, typename... Fs>
+struct stage_items<In, F, G, Fs...> {
+    using Out  = typename std::invoke_result_t<F&, In&&>::result_type;
+    using type = decltype(std::tuple_cat(std::declval<std::tuple<In>>(),
+                                         std::declval<typename stage_items<Out, G, Fs...>::type>()));
+};
+
+// The item type leaving stage I, nullptr_t for the last one
+template <std::size_t I, typename Items, bool = (I + 1 < std::tuple_size_v<Items>)>
+struct stage_output {
+    using type = std::tuple_element_t<I + 1, Items>;
+};
+
+template <std::size_t I, typename Items>
+struct stage_output<I, Items, false> {
+    using type = std::nullptr_t;
+};
+
+template <typename Items>
+struct stage_rings;
+
+template <typename... Ts>
+struct stage_rings<std::tuple<Ts...>> {
+    using type = std::tuple<SpscRing<Ts>...>;
+};
+}  // namespace detail
+
+template <typename In, typename E, typename... Fs>
+class Stream {
+    static_assert(sizeof...(Fs) > 0, "A stream needs at least one stage");
+
+    using Items = typename detail::stage_items<In, Fs...>::type;
+    using Rings = typename detail::stage_rings<Items>::type;
+
+public:
+    // Starts a thread per stage
+    Stream(const StreamOptions& options, Fs... stages)
+        : options_(options), stages_(std::move(stages)...), rings_(make_rings(std::make_index_sequence<STAGES>{})) {
+        COGLE_ASSERT(options.capacity > 0 && options.batch > 0, "StreamOptions capacity and batch must not be 0");
+        check(std::make_index_sequence<STAGES>{});
+        pending_.reserve(1);
+        threads_.reserve(STAGES);
+        start(std::make_index_sequence<STAGES>{});
+    }
+
+    Stream(const Stream&)            = delete;
+    Stream& operator=(const Stream&) = delete;
+
+    // Without finish(), cancels the stages and drops the items still queued
+    ~Stream() {
+        if (!threads_.empty()) {
+            cancel();
+            join();
+        }
+    }
+
+    // Number of stages
+    static constexpr std::size_t size() noexcept { return STAGES; }
+
+    // Pushes an item into the first stage, waiting while its ring is full. Pushing from a single thread at a time,
+    // false once the stream stopped. Every push synchronizes with the first stage, prefer push_batch.
+    bool push(In item) {
+        pending_.push_back(std::move(item));
+        return std::get<0>(rings_).push(pending_);
+    }
+
+    // Pushes all of items, in as many batches as the ring in front of the first stage needs, and leaves items empty
+    bool push_batch(std::vector<In>& items) { return std::get<0>(rings_).push(items); }
+
+    // Ends the input, waits for the stages to process what was pushed and returns the first error with OnError::Stop.
+    // To be called once, the stream takes no more items afterwards.
+    [[nodiscard]] result::Result<void, StageError<E>> finish() {
+        COGLE_ASSERT(!threads_.empty(), "Stream::finish() called twice");
+        std::get<0>(rings_).close();
+        join();
+        UNLIKELY_IF(options_.on_error == OnError::Stop && !errors_.empty()) {
+            return result::Result<void, StageError<E>>{result::in_place_err, std::move(errors_.front())};
+        }
+        return result::Result<void, StageError<E>>{result::in_place_ok};
+    }
+
+    // The errors routed since the last call, in the order stages reported them
+    [[nodiscard]] std::vector<StageError<E>> take_errors() {
+        std::lock_guard<std::mutex> lock{errors_mutex_};
+        return std::exchange(errors_, {});
+    }
+
+    // Counters of a stage, may be read from any thread while the stream runs
+    [[nodiscard]] StageCounters counters(const std::size_t stage) const noexcept {
+        const detail::StageStats& stats = stats_[stage];
+        std::size_t queued              = 0;
+        std::apply(
+            [stage, &queued](const auto&... rings) {
+                std::size_t index = 0;
+                static_cast<void>(((index++ == stage && (queued = rings.size(), true)) || ...));
+            },
+            rings_);
+        return StageCounters{stats.received.load(std::memory_order_relaxed),
+                             stats.produced.load(std::memory_order_relaxed),
+                             stats.failed.load(std::memory_order_relaxed),
+                             stats.batches.load(std::memory_order_relaxed), queued};
+    }
+
+private:
+    static constexpr std::size_t STAGES = sizeof...(Fs);
+
+    template <std::size_t... Is>
+    Rings make_rings(std::index_sequence<Is...>) const {
+        return Rings{(static_cast<void>(Is), options_.capacity)...};
+    }
+
+    template <std::size_t... Is>
+    static constexpr void check(std::index_sequence<Is...>) noexcept {
+        static_assert((... && traits::is_result_v<std::invoke_result_t<std::tuple_element_t<Is, std::tuple<Fs...>>&,
+                                                                       std::tuple_element_t<Is, Items>&&>>),
+                      "Every stage must return a Result");
+        static_assert(
+            (... && std::is_same_v<typename std::invoke_result_t<std::tuple_element_t<Is, std::tuple<Fs...>>&,
+                                                                 std::tuple_element_t<Is, Items>&&>::error_type,
+                                   E>),
+            "Every stage must return the error type of the stream");
+    }
+
+    template <std::size_t... Is>
+    void start(std::index_sequence<Is...>) {
+        (threads_.emplace_back([this] { run<Is>(); }), ...);
+    }
+
+    template <std::size_t I>
+    void run() {
+        using Item                = std::tuple_element_t<I, Items>;
+        using Out                 = typename detail::stage_output<I, Items>::type;
+        constexpr bool LAST       = I + 1 == STAGES;
+        auto& func                = std::get<I>(stages_);
+        auto& input               = std::get<I>(rings_);
+        detail::StageStats& stats = stats_[I];
+        static_assert(!LAST || std::is_void_v<typename std::invoke_result_t<decltype(func), Item&&>::result_type>,
+                      "The last stage must return Result<void, E>");
+
+        std::vector<Item> items;
+        std::vector<Out> outputs;
+        std::vector<StageError<E>> errors;
+        items.reserve(options_.batch);
+        if constexpr (!LAST) {
+            outputs.reserve(options_.batch);
+        }
+
+        while (input.pop(items, options_.batch)) {
+            // Stop leaves the rest of the batch unprocessed, only the items that were run are counted
+            std::uint64_t processed = 0;
+            std::uint64_t failed    = 0;
+            for (Item& item : items) {
+                ++processed;
+                auto result = std::invoke(func, std::move(item));
+                UNLIKELY_IF(result.is_err()) {
+                    ++failed;
+                    errors.push_back(StageError<E>{I, std::move(result).error_unchecked()});
+                    if (options_.on_error == OnError::Stop) {
+                        break;
+                    }
+                    continue;
+                }
+                if constexpr (!LAST) {
+                    outputs.push_back(std::move(result).unwrap_unchecked());
+                }
+            }
+
+            detail::StageStats::add(stats.received, processed);
+            detail::StageStats::add(stats.failed, failed);
+            detail::StageStats::add(stats.batches, 1);
+            items.clear();
+            if constexpr (LAST) {
+                detail::StageStats::add(stats.produced, processed - failed);
+            }
+
+            UNLIKELY_IF(!errors.empty() && !report(errors)) { return; }
+            if constexpr (!LAST) {
+                // Outputs only count once the next stage has them
+                const std::uint64_t produced = outputs.size();
+                if (!std::get<I + 1>(rings_).push(outputs)) {
+                    return;
+                }
+                detail::StageStats::add(stats.produced, produced);
+            }
+        }
+        if constexpr (!LAST) {
+            std::get<I + 1>(rings_).close();
+        }
+    }
+
+    // Routes the errors of a batch to the side channel, false if they stop the stream
+    bool report(std::vector<StageError<E>>& errors) {
+        std::lock_guard<std::mutex> lock{errors_mutex_};
+        if (options_.on_error == OnError::Route) {
+            std::move(errors.begin(), errors.end(), std::back_inserter(errors_));
+            errors.clear();
+            return true;
+        }
+        if (errors_.empty()) {
+            errors_.push_back(std::move(errors.front()));
+        }
+        errors.clear();
+        cancel();
+        return false;
+    }
+
+    void cancel() noexcept {
+        std::apply([](auto&... rings) { (rings.cancel(), ...); }, rings_);
+    }
+
+    void join() {
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+        threads_.clear();
+    }
+
+    const StreamOptions options_;
+    std::tuple<Fs...> stages_;
+    Rings rings_;
+    std::array<detail::StageStats, STAGES> stats_;
+
+    std::mutex errors_mutex_;
+    std::vector<StageError<E>> errors_;
+
+    std::vector<In> pending_;
+    std::vector<std::thread> threads_;
+};
+
+// make_stream<In, F, Fs...>(const StreamOptions& options, F&& first, Fs&&... rest) -> Stream<In, E, ...>
+// where first(In&&) -> Result<Out0, E>, the next stage takes Out0 and so on, and the last one returns Result<void, E>
+template <typename In, typename F, typename... Fs>
+[[nodiscard]] auto make_stream(const StreamOptions& options, F&& first, Fs&&... rest) {
+    using E = typename std::invoke_result_t<std::decay_t<F>&, In&&>::error_type;
+    return Stream<In, E, std::decay_t<F>, std::decay_t<Fs>...>(options, std::forward<F>(first),
+                                                               std::forward<Fs>(rest)...);
+}
+
+}  // namespace stream
+}  // namespace utils
+}  // namespace cogle
\ No newline at end of file
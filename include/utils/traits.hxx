@@ -7,6 +7,12 @@ namespace cogle {
 
 namespace utils {
 
+// Forward declare Result
+namespace result {
+template <typename R, typename E>
+class Result;
+}  // namespace result
+
 namespace traits {
 
 template <typename F, typename... Args>
@@ -28,6 +34,35 @@ struct is_comparable_with<
         std::declval<std::remove_const_t<U> const &>() != std::declval<std::remove_const_t<T> const &>())>>
     : std::true_type {};
 
+// A type is trivially relocatable when moving an object to a new address and destroying the source is equivalent to
+// copying its bytes and forgetting the source. Trivially copyable types always are, other types such as a handle that
+// owns a pointer can opt in by specializing is_trivially_relocatable. Types that point into themselves, e.g. the small
+// string buffer of libstdc++'s std::string, must not.
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>> {};
+
+// A void payload holds nothing and never prevents relocation
+template <>
+struct is_trivially_relocatable<void> : std::true_type {};
+
+// A reference payload is stored as a pointer
+template <typename T>
+struct is_trivially_relocatable<T&> : std::true_type {};
+
+template <typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+// True for Result<R, E>, however it is cv or reference qualified
+template <typename T>
+struct is_result : std::false_type {};
+
+template <typename R, typename E>
+struct is_result<result::Result<R, E>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_result_v = is_result<std::remove_cv_t<std::remove_reference_t<T>>>::value;
+
 template <typename>
 struct FirstArgStruct;
 
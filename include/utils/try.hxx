@@ -0,0 +1,113 @@
+#pragma once
+
+// Early return propagation for functions returning a Result, without coroutines.
+//
+//     Result<Config, std::string> load(const char* path) {
+//         std::string text = COGLE_TRY(read_file(path));
+//         COGLE_TRY(validate(text));
+//         return parse(text);
+//     }
+//
+// COGLE_TRY(expr) evaluates expr to a Result. An Ok yields its result, moved out of an rvalue Result and copied from an
+// lvalue one, or nothing for a void result. An Err makes the enclosing function return it, the error is converted to
+// the Result that function returns. The tag is tested once, neither path goes through the checked accessors.
+//
+// COGLE_TRY is an expression where GNU statement expressions are available (GCC and Clang), elsewhere it is a
+// statement that discards the result. Defining COGLE_TRY_PORTABLE selects the statement everywhere.
+// COGLE_TRY_ASSIGN(lhs, expr) is available everywhere:
+//
+//     COGLE_TRY_ASSIGN(auto fd, open_file(path));
+//     COGLE_TRY_ASSIGN(config.port, parse_port(text));
+
+#include <type_traits>
+#include <utility>
+#include <utils/compatibility.hxx>
+#include <utils/result.hxx>
+
+namespace cogle {
+namespace utils {
+namespace result {
+namespace detail {
+// The error of a failed COGLE_TRY on its way out of the enclosing function, converts to whichever Result that is.
+// Ref is what the Result hands out, a reference for regular storage and a value for niche storage.
+template <typename Ref>
+class TryErr {
+public:
+    explicit constexpr TryErr(Ref error) noexcept : error_(std::forward<Ref>(error)) {}
+
+    TryErr(const TryErr&)            = delete;
+    TryErr& operator=(const TryErr&) = delete;
+
+    template <typename Rv, typename Ev, typename = std::enable_if_t<std::is_constructible_v<Ev, Ref>>>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    constexpr operator Result<Rv, Ev>() && {
+        return Result<Rv, Ev>{in_place_err, std::forward<Ref>(error_)};
+    }
+
+private:
+    Ref error_;
+};
+
+template <typename Res>
+[[nodiscard]] constexpr auto try_err(Res&& result) noexcept {
+    return TryErr<decltype(std::forward<Res>(result).error_unchecked())>{std::forward<Res>(result).error_unchecked()};
+}
+
+template <typename Res>
+constexpr decltype(auto) try_value(Res&& result) noexcept {
+    if constexpr (std::is_void_v<typename std::remove_reference_t<Res>::result_type>) {
+        return;
+    } else {
+        return std::forward<Res>(result).unwrap_unchecked();
+    }
+}
+}  // namespace detail
+}  // namespace result
+}  // namespace utils
+}  // namespace cogle
+
+#define COGLE_TRY_CONCAT_(a, b) a##b
+#define COGLE_TRY_CONCAT(a, b)  COGLE_TRY_CONCAT_(a, b)
+#define COGLE_TRY_NAME          COGLE_TRY_CONCAT(cogle_try_result_, __COUNTER__)
+
+#if defined(COGLE_ERROR_COUNTERS)
+#define COGLE_TRY_COUNT_PROPAGATION()                                                                      \
+    ::cogle::utils::counters::count_propagation(true, ::cogle::utils::location::SourceLocation::current())
+#else
+#define COGLE_TRY_COUNT_PROPAGATION()
+#endif
+
+#define COGLE_TRY_RETURN_ERR(name)                                                          \
+    UNLIKELY_IF(!name.is_ok()) {                                                            \
+        COGLE_TRY_COUNT_PROPAGATION();                                                      \
+        return ::cogle::utils::result::detail::try_err(std::forward<decltype(name)>(name)); \
+    }
+
+#define COGLE_TRY_ASSIGN_(lhs, expr, name)                                              \
+    auto&& name = (expr);                                                               \
+    COGLE_TRY_RETURN_ERR(name)                                                          \
+    lhs = ::cogle::utils::result::detail::try_value(std::forward<decltype(name)>(name))
+
+#define COGLE_TRY_ASSIGN(lhs, ...) COGLE_TRY_ASSIGN_(lhs, (__VA_ARGS__), COGLE_TRY_NAME)
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(COGLE_TRY_PORTABLE)
+#define COGLE_HAS_TRY_EXPRESSION 1
+
+#define COGLE_TRY_(expr, name)                                                         \
+    __extension__({                                                                    \
+        auto&& name = (expr);                                                          \
+        COGLE_TRY_RETURN_ERR(name)                                                     \
+        ::cogle::utils::result::detail::try_value(std::forward<decltype(name)>(name)); \
+    })
+#else
+#define COGLE_HAS_TRY_EXPRESSION 0
+
+#define COGLE_TRY_(expr, name)     \
+    do {                           \
+        auto&& name = (expr);      \
+        COGLE_TRY_RETURN_ERR(name) \
+    } while (0)
+#endif
+
+// Variadic so that expressions with unparenthesized commas, e.g. template arguments, can be passed
+#define COGLE_TRY(...) COGLE_TRY_((__VA_ARGS__), COGLE_TRY_NAME)
\ No newline at end of file
@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+
+"""Codegen regression checks for the header only library.
+
+Every snippet file contains annotations of the form
+
+    // CODEGEN: <function> [check ...]
+
+where <function> is an extern "C" function defined in the snippet and each check is one of
+
+    no-calls        the function body contains no call or tail call
+    max-insns=N     the function body has at most N instructions
+    forbid=REGEX    REGEX does not appear in the function body
+    xfail           the property checks are known to fail, an unexpected pass is reported as an error
+
+Only the hot body of a function is inspected, code the compiler has moved into a separate .cold section is not.
+Besides the property checks the instruction count and code size of every annotated function is compared against a
+stored baseline and the check fails if either has grown.
+"""
+
+import argparse
+import json
+import logging
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+logging.basicConfig(level=logging.INFO, format="%(message)s")
+
+EXIT_CODE_SUCCESS = 0
+EXIT_CODE_FAIL = 1
+
+OPT_LEVELS = ["-O2", "-O3"]
+CXX_STANDARD = "-std=c++17"
+
+ANNOTATION_RE = re.compile(r"^\s*//\s*CODEGEN:\s*(\w+)(.*)$")
+CALL_RE = re.compile(r"^\s*(call|jmp)[a-z]*\s+\*?([^\s,]+)")
+LOCAL_LABEL_PREFIX = ".L"
+
+
+class Annotation:
+    def __init__(self, function: str, checks: List[str]):
+        self.function = function
+        self.no_calls = False
+        self.max_insns: Optional[int] = None
+        self.forbid: List[str] = []
+        self.xfail = False
+
+        for check in checks:
+            if check == "no-calls":
+                self.no_calls = True
+            elif check == "xfail":
+                self.xfail = True
+            elif check.startswith("max-insns="):
+                self.max_insns = int(check.split("=", 1)[1])
+            elif check.startswith("forbid="):
+                self.forbid.append(check.split("=", 1)[1])
+            else:
+                raise ValueError(f"Unknown codegen check '{check}' for {function}")
+
+
+def parse_annotations(snippet: Path) -> List[Annotation]:
+    annotations = []
+    with open(snippet, "r") as f:
+        for line in f:
+            match = ANNOTATION_RE.match(line)
+            if match:
+                annotations.append(Annotation(match.group(1), match.group(2).split()))
+    return annotations
+
+
+def compiler_id(compiler: str) -> str:
+    version = subprocess.run([compiler, "--version"], check=True, stdout=subprocess.PIPE).stdout.decode("UTF-8")
+    major = subprocess.run([compiler, "-dumpversion"], check=True,
+                           stdout=subprocess.PIPE).stdout.decode("UTF-8").strip().split(".")[0]
+    family = "clang" if "clang" in version.lower() else "gcc"
+    return f"{family}-{major}"
+
+
+def compile_snippet(compiler: str, opt: str, include_dir: str, snippet: Path, out_dir: str) -> Tuple[str, str]:
+    asm_file = os.path.join(out_dir, f"{snippet.stem}{opt}.s")
+    obj_file = os.path.join(out_dir, f"{snippet.stem}{opt}.o")
+    base_cmd = [compiler, CXX_STANDARD, opt, "-DNDEBUG", f"-I{include_dir}", str(snippet)]
+
+    subprocess.run(base_cmd + ["-S", "-o", asm_file], check=True)
+    subprocess.run(base_cmd + ["-c", "-o", obj_file], check=True)
+
+    return asm_file, obj_file
+
+
+def function_bodies(asm_file: str) -> Dict[str, List[str]]:
+    """Maps each global label to the instructions that follow it until the end of the function."""
+    bodies: Dict[str, List[str]] = dict()
+    current: Optional[str] = None
+
+    with open(asm_file, "r") as f:
+        for raw in f:
+            line = raw.rstrip()
+            stripped = line.strip()
+
+            if not line.startswith((" ", "\t")) and stripped.endswith(":"):
+                label = stripped[:-1]
+                if not label.startswith("."):
+                    current = label
+                    bodies[current] = []
+                continue
+
+            if current is None:
+                continue
+
+            if stripped.startswith(".cfi_endproc") or stripped.startswith(".size"):
+                current = None
+                continue
+
+            if not stripped or stripped.startswith(".") or stripped.endswith(":") or stripped.startswith("#"):
+                continue
+
+            bodies[current].append(stripped)
+
+    return bodies
+
+
+def symbol_sizes(nm: str, obj_file: str) -> Dict[str, int]:
+    output = subprocess.run([nm, "-S", "--defined-only", obj_file], check=True,
+                            stdout=subprocess.PIPE).stdout.decode("UTF-8")
+    sizes = dict()
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) == 4:
+            sizes[parts[3]] = int(parts[1], 16)
+    return sizes
+
+
+def check_properties(annotation: Annotation, body: List[str]) -> List[str]:
+    failures = []
+
+    if annotation.no_calls:
+        for insn in body:
+            match = CALL_RE.match(insn)
+            if match and not match.group(2).startswith(LOCAL_LABEL_PREFIX):
+                failures.append(f"expected no calls but found '{insn}'")
+                break
+
+    if annotation.max_insns is not None and len(body) > annotation.max_insns:
+        failures.append(f"expected at most {annotation.max_insns} instructions but found {len(body)}")
+
+    for pattern in annotation.forbid:
+        regex = re.compile(pattern)
+        for insn in body:
+            if regex.search(insn):
+                failures.append(f"forbidden pattern '{pattern}' found in '{insn}'")
+                break
+
+    return failures
+
+
+def run(args) -> int:
+    baseline_path = Path(args.baseline)
+    baseline = dict()
+    if baseline_path.exists():
+        with open(baseline_path, "r") as f:
+            baseline = json.load(f)
+
+    failed = False
+    measured = dict()
+
+    with tempfile.TemporaryDirectory() as out_dir:
+        for compiler in args.compiler:
+            cid = compiler_id(compiler)
+
+            for opt in OPT_LEVELS:
+                for snippet in args.snippets:
+                    snippet = Path(snippet)
+                    asm_file, obj_file = compile_snippet(compiler, opt, args.include, snippet, out_dir)
+                    bodies = function_bodies(asm_file)
+                    sizes = symbol_sizes(args.nm, obj_file)
+
+                    for annotation in parse_annotations(snippet):
+                        key = f"{cid}/{opt}/{annotation.function}"
+
+                        if annotation.function not in bodies:
+                            logging.error(f"FAIL {key}: function not found in generated assembly")
+                            failed = True
+                            continue
+
+                        body = bodies[annotation.function]
+                        current = {"insns": len(body), "bytes": sizes.get(annotation.function, 0)}
+                        measured[key] = current
+
+                        failures = check_properties(annotation, body)
+                        if annotation.xfail and failures:
+                            logging.info(f"XFAIL {key}: {failures[0]}")
+                        elif annotation.xfail:
+                            logging.error(f"XPASS {key}: checks now pass, remove the xfail marker")
+                            failed = True
+                        elif failures:
+                            for failure in failures:
+                                logging.error(f"FAIL {key}: {failure}")
+                            failed = True
+
+                        if args.update_baseline:
+                            continue
+
+                        expected = baseline.get(key)
+                        if expected is None:
+                            logging.info(f"NEW {key}: {current} has no baseline, run with --update-baseline")
+                            continue
+
+                        for metric in ["insns", "bytes"]:
+                            if current[metric] > expected[metric]:
+                                logging.error(f"FAIL {key}: {metric} regressed from {expected[metric]} to "
+                                              f"{current[metric]}")
+                                failed = True
+                            elif current[metric] < expected[metric]:
+                                logging.info(f"IMPROVED {key}: {metric} went from {expected[metric]} to "
+                                             f"{current[metric]}, consider updating the baseline")
+
+    if args.update_baseline:
+        # Keep entries for compilers that are not available on this machine
+        baseline.update(measured)
+        with open(baseline_path, "w") as f:
+            json.dump(baseline, f, indent=4, sort_keys=True)
+            f.write("\n")
+        logging.info(f"Updated baseline {baseline_path}")
+        return EXIT_CODE_SUCCESS
+
+    return EXIT_CODE_FAIL if failed else EXIT_CODE_SUCCESS
+
+
+def parse_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--compiler", action="append", required=True, help="C++ compiler, may be repeated")
+    parser.add_argument("--include", required=True, help="Library include directory")
+    parser.add_argument("--baseline", required=True, help="Baseline JSON file")
+    parser.add_argument("--nm", default="nm", help="nm used to measure code size")
+    parser.add_argument("--update-baseline", action="store_true", help="Rewrite the baseline with current values")
+    parser.add_argument("snippets", nargs="+", help="Snippet source files")
+    return parser.parse_args()
+
+
+if __name__ == "__main__":
+    sys.exit(run(parse_args()))
\ No newline at end of file
@@ -0,0 +1,81 @@
+// Canonical Result hot paths checked by check_codegen.py, see the CODEGEN annotations.
+#include <utils/result.hxx>
+#include <utils/try.hxx>
+
+using namespace cogle::utils::result;
+using cogle::utils::niche::Errno;
+
+struct NotFound {};
+
+// CODEGEN: codegen_is_ok no-calls max-insns=3
+extern "C" bool codegen_is_ok(const Result<int, int>& r) { return r.is_ok(); }
+
+// CODEGEN: codegen_is_ok_by_value no-calls max-insns=4
+extern "C" bool codegen_is_ok_by_value(Result<int, int> r) { return r.is_ok(); }
+
+// CODEGEN: codegen_void_is_ok no-calls max-insns=4
+extern "C" bool codegen_void_is_ok(Result<void, int> r) { return r.is_ok(); }
+
+// CODEGEN: codegen_niche_is_ok no-calls max-insns=4
+extern "C" bool codegen_niche_is_ok(Result<int, Errno> r) { return r.is_ok(); }
+
+// CODEGEN: codegen_make_ok_or_err no-calls
+extern "C" Result<int, int> codegen_make_ok_or_err(int v) {
+    if (v < 0) {
+        return Err<int>{-v};
+    }
+    return Ok<int>{v};
+}
+
+// CODEGEN: codegen_result no-calls max-insns=4 forbid=_ZSt4cout forbid=ostream forbid=_ZSt9terminate
+extern "C" int codegen_result(const Result<int, int>& r) { return r.result(); }
+
+// CODEGEN: codegen_result_after_check forbid=_ZSt4cout forbid=ostream forbid=_ZSt9terminate
+extern "C" int codegen_result_after_check(const Result<int, int>& r) {
+    if (r) {
+        return r.result();
+    }
+    return -1;
+}
+
+// CODEGEN: codegen_map no-calls
+extern "C" Result<int, int> codegen_map(Result<int, int> r) {
+    return r.map([](int v) { return v + 1; });
+}
+
+// CODEGEN: codegen_and_then no-calls
+extern "C" Result<int, int> codegen_and_then(Result<int, int> r) {
+    return r.and_then([](int v) { return Result<int, int>{Ok<int>{v * 2}}; });
+}
+
+// CODEGEN: codegen_match no-calls
+extern "C" int codegen_match(Result<int, int> r) {
+    return r.match([](int v) { return v; }, [](int e) { return -e; });
+}
+
+// CODEGEN: codegen_unwrap_unchecked no-calls max-insns=2
+extern "C" int codegen_unwrap_unchecked(const Result<int, int>& r) { return r.unwrap_unchecked(); }
+
+// CODEGEN: codegen_error_unchecked no-calls max-insns=2
+extern "C" int codegen_error_unchecked(const Result<int, int>& r) { return r.error_unchecked(); }
+
+// CODEGEN: codegen_assert_static_record no-calls max-insns=4
+extern "C" int codegen_assert_static_record(int v) {
+    COGLE_ASSERT(v > 0, "Expected a positive value");
+    return v;
+}
+
+// CODEGEN: codegen_reference_lookup no-calls max-insns=6
+extern "C" int codegen_reference_lookup(Result<const int&, NotFound> r) { return r ? *r : -1; }
+
+// Written by hand an early return tests the tag again in error() and keeps the abort path, COGLE_TRY tests it once
+// CODEGEN: codegen_early_return no-calls
+extern "C" Result<long, int> codegen_early_return(Result<int, int> r) {
+    if (!r) {
+        return Err<int>{r.error()};
+    }
+    return Ok<long>{r.result() + 1L};
+}
+
+// CODEGEN: codegen_try no-calls forbid=_ZN5cogle5utils5abort
+extern "C" Result<long, int> codegen_try(Result<int, int> r) { return Ok<long>{COGLE_TRY(std::move(r)) + 1L}; }
\ No newline at end of file
@@ -0,0 +1,19 @@
+// Result hot paths with COGLE_RESULT_UNCHECKED, the tag checks become optimizer assumptions.
+#define COGLE_RESULT_UNCHECKED
+#include <utils/result.hxx>
+
+using namespace cogle::utils::result;
+
+// CODEGEN: codegen_unchecked_result no-calls max-insns=2
+extern "C" int codegen_unchecked_result(const Result<int, int>& r) { return r.result(); }
+
+// CODEGEN: codegen_unchecked_error no-calls max-insns=2
+extern "C" int codegen_unchecked_error(const Result<int, int>& r) { return r.error(); }
+
+// CODEGEN: codegen_unchecked_result_after_check no-calls
+extern "C" int codegen_unchecked_result_after_check(const Result<int, int>& r) {
+    if (r) {
+        return r.result();
+    }
+    return -1;
+}
\ No newline at end of file
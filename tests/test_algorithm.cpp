@@ -0,0 +1,211 @@
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/algorithm.hxx"
+#include "utils/result.hxx"
+
+namespace {
+
+using namespace cogle::utils::result;
+namespace algorithm = cogle::utils::algorithm;
+
+// Small chunks so that a few thousand elements are spread over several threads
+constexpr algorithm::Parallel PAR{4, 16};
+
+std::vector<Result<int, std::string>> make(const std::size_t n, const std::vector<std::size_t>& failing = {}) {
+    std::vector<Result<int, std::string>> results;
+    results.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        bool fails = false;
+        for (const auto idx : failing) {
+            fails = fails || idx == i;
+        }
+        if (fails) {
+            results.emplace_back(in_place_err, "error " + std::to_string(i));
+        } else {
+            results.emplace_back(in_place_ok, static_cast<int>(i));
+        }
+    }
+    return results;
+}
+
+TEST_CASE("Algorithm Collect", "[algorithm]") {
+    SECTION("All Results") {
+        const auto results   = make(5000);
+        const auto seq       = algorithm::collect(results);
+        const auto par       = algorithm::collect(PAR, results);
+        const auto expect_ok = [](const auto& collected) {
+            REQUIRE(collected.is_ok());
+            REQUIRE(collected.result().size() == 5000);
+            for (std::size_t i = 0; i < 5000; ++i) {
+                REQUIRE(collected.result()[i] == static_cast<int>(i));
+            }
+        };
+        expect_ok(seq);
+        expect_ok(par);
+    }
+
+    SECTION("First Error") {
+        const auto results = make(5000, {4321, 1234, 3000});
+        REQUIRE(algorithm::collect(results).error() == "error 1234");
+        for (int run = 0; run < 20; ++run) {
+            REQUIRE(algorithm::collect(PAR, results).error() == "error 1234");
+        }
+    }
+
+    SECTION("Empty") {
+        const std::vector<Result<int, std::string>> results;
+        REQUIRE(algorithm::collect(results).result().empty());
+        REQUIRE(algorithm::collect(PAR, results).result().empty());
+    }
+
+    SECTION("Void") {
+        std::vector<Result<void, int>> results(100, Result<void, int>{in_place_ok});
+        REQUIRE(algorithm::collect(results).is_ok());
+        REQUIRE(algorithm::collect(PAR, results).is_ok());
+
+        results[70] = Result<void, int>{in_place_err, 70};
+        results[90] = Result<void, int>{in_place_err, 90};
+        REQUIRE(algorithm::collect(results).error() == 70);
+        REQUIRE(algorithm::collect(PAR, results).error() == 70);
+    }
+
+    SECTION("Moves From An Rvalue Range") {
+        std::vector<Result<std::unique_ptr<int>, std::string>> results;
+        for (int i = 0; i < 100; ++i) {
+            results.emplace_back(in_place_ok, std::make_unique<int>(i));
+        }
+        auto collected = algorithm::collect(PAR, std::move(results));
+        REQUIRE(collected.is_ok());
+        REQUIRE(*collected.result()[99] == 99);
+    }
+
+    SECTION("Forward Range") {
+        std::list<Result<int, std::string>> results{Result<int, std::string>{in_place_ok, 1},
+                                                    Result<int, std::string>{in_place_ok, 2}};
+        REQUIRE(algorithm::collect(results).result() == std::vector<int>{1, 2});
+        results.emplace_back(in_place_err, "bad");
+        REQUIRE(algorithm::collect(results).error() == "bad");
+    }
+}
+
+TEST_CASE("Algorithm Try Transform", "[algorithm]") {
+    std::vector<int> values(5000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i);
+    }
+    const auto half = [](const int value) -> Result<double, std::string> {
+        if (value % 1000 == 999) {
+            return Result<double, std::string>{in_place_err, "odd " + std::to_string(value)};
+        }
+        return Result<double, std::string>{in_place_ok, value / 2.0};
+    };
+
+    SECTION("Results") {
+        std::vector<int> small(values.begin(), values.begin() + 999);
+        const auto seq = algorithm::try_transform(small, half);
+        const auto par = algorithm::try_transform(PAR, small, half);
+        REQUIRE(seq.result() == par.result());
+        REQUIRE(par.result()[998] == 499.0);
+    }
+
+    SECTION("First Error") {
+        REQUIRE(algorithm::try_transform(values, half).error() == "odd 999");
+        REQUIRE(algorithm::try_transform(PAR, values, half).error() == "odd 999");
+    }
+
+    SECTION("Stops Early") {
+        std::atomic<std::size_t> calls{0};
+        const auto counted = [&](const int value) {
+            ++calls;
+            return half(value);
+        };
+
+        REQUIRE(algorithm::try_transform(values, counted).is_err());
+        REQUIRE(calls == 1000);
+
+        calls = 0;
+        REQUIRE(algorithm::try_transform(algorithm::Parallel{4, 64}, values, counted).is_err());
+        // Threads stop at the next cache line once the error is known, far less than the whole range
+        REQUIRE(calls < values.size());
+    }
+
+    SECTION("Exceptions") {
+        const auto throws = [](const int value) -> Result<int, std::string> {
+            if (value == 2500) {
+                throw std::runtime_error("thrown");
+            }
+            return Result<int, std::string>{in_place_ok, value};
+        };
+        REQUIRE_THROWS_AS(algorithm::try_transform(PAR, values, throws), std::runtime_error);
+    }
+
+    SECTION("Bools") {
+        const auto odd = [](const int value) { return Result<bool, std::string>{in_place_ok, value % 3 == 1}; };
+        const auto seq = algorithm::try_transform(values, odd);
+        const auto par = algorithm::try_transform(PAR, values, odd);
+        REQUIRE(seq.result() == par.result());
+        REQUIRE(par.result()[4]);
+    }
+}
+
+TEST_CASE("Algorithm Partition", "[algorithm]") {
+    const std::vector<std::size_t> failing{0, 17, 18, 19, 400, 4999};
+
+    const auto check = [&](const algorithm::Partition<int, std::string>& partition) {
+        REQUIRE(partition.errs.size() == failing.size());
+        REQUIRE(partition.oks.size() == 5000 - failing.size());
+        for (std::size_t i = 0; i < failing.size(); ++i) {
+            REQUIRE(partition.errs[i] == "error " + std::to_string(failing[i]));
+        }
+        for (std::size_t i = 1; i < partition.oks.size(); ++i) {
+            REQUIRE(partition.oks[i - 1] < partition.oks[i]);
+        }
+    };
+
+    SECTION("Sequential") {
+        auto results = make(5000, failing);
+        check(algorithm::partition(results));
+        // Partitioning an lvalue copies, the range is left as it was
+        REQUIRE(results[17].error() == "error 17");
+        check(algorithm::partition(std::move(results)));
+    }
+
+    SECTION("Parallel") {
+        auto results = make(5000, failing);
+        check(algorithm::partition(PAR, results));
+        check(algorithm::partition(algorithm::Parallel{1, 1}, results));
+        check(algorithm::partition(PAR, std::move(results)));
+    }
+
+    SECTION("Bools") {
+        // Threads write neighbouring elements of std::vector<bool> outputs
+        std::vector<Result<bool, bool>> results;
+        for (std::size_t i = 0; i < 5000; ++i) {
+            if (i % 3 == 0) {
+                results.emplace_back(in_place_err, i % 2 == 0);
+            } else {
+                results.emplace_back(in_place_ok, i % 5 == 0);
+            }
+        }
+        const auto seq = algorithm::partition(results);
+        const auto par = algorithm::partition(PAR, results);
+        REQUIRE(seq.oks == par.oks);
+        REQUIRE(seq.errs == par.errs);
+        REQUIRE(par.errs.size() == 1667);
+    }
+
+    SECTION("Empty") {
+        const std::vector<Result<int, std::string>> results;
+        REQUIRE(algorithm::partition(PAR, results).oks.empty());
+        REQUIRE(algorithm::partition(results).errs.empty());
+    }
+}
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/channel.hxx"
+#include "utils/result.hxx"
+
+namespace {
+
+using namespace cogle::utils::result;
+using namespace cogle::utils::channel;
+
+using Item = Result<int, std::string>;
+
+Item ok(const int value) { return Item{in_place_ok, value}; }
+
+Item err(const std::string& error) { return Item{in_place_err, error}; }
+
+TEST_CASE("Channel Send And Receive", "[channel]") {
+    SECTION("Capacity") {
+        REQUIRE(Channel<int, int>{0}.capacity() == 2);
+        REQUIRE(Channel<int, int>{5}.capacity() == 8);
+        REQUIRE(Channel<int, int>{64}.capacity() == 64);
+    }
+
+    SECTION("Values And Errors In Order") {
+        Channel<int, std::string> channel{4};
+        REQUIRE(channel.send(ok(1)).is_ok());
+        REQUIRE(channel.send(err("two")).is_ok());
+        REQUIRE(channel.send(ok(3)).is_ok());
+
+        REQUIRE(channel.recv().result() == 1);
+        auto second = channel.recv();
+        REQUIRE(second.is_err());
+        REQUIRE(!second.error().closed());
+        REQUIRE(second.error().error() == "two");
+        REQUIRE(channel.recv().result() == 3);
+    }
+
+    SECTION("Close Drains Then Fails") {
+        Channel<int, std::string> channel{4};
+        REQUIRE(channel.send(ok(1)).is_ok());
+        channel.close();
+        REQUIRE(channel.send(ok(2)).is_err());
+
+        REQUIRE(channel.recv().result() == 1);
+        REQUIRE(channel.recv().error().closed());
+        REQUIRE(channel.recv().error().closed());
+
+        std::vector<Item> out;
+        REQUIRE(channel.recv_batch(out, 8).is_err());
+        REQUIRE(out.empty());
+    }
+
+    SECTION("Batches") {
+        Channel<int, std::string> channel{8};
+        std::vector<Item> items;
+        for (int i = 0; i < 6; ++i) {
+            items.push_back(i == 4 ? err("four") : ok(i));
+        }
+        REQUIRE(channel.send_batch(items).is_ok());
+        REQUIRE(items.empty());
+
+        std::vector<Item> out;
+        REQUIRE(channel.recv_batch(out, 4).result() == 4);
+        REQUIRE(channel.recv_batch(out, 4).result() == 2);
+        REQUIRE(out.size() == 6);
+        REQUIRE(out[3].result() == 3);
+        REQUIRE(out[4].error() == "four");
+        REQUIRE(out[5].result() == 5);
+    }
+
+    SECTION("Batches Of Any Size") {
+        Channel<int, std::string> channel{4};
+        REQUIRE(channel.send(ok(1)).is_ok());
+        REQUIRE(channel.send(ok(2)).is_ok());
+
+        std::vector<Item> out;
+        REQUIRE(channel.recv_batch(out, static_cast<std::size_t>(-1)).result() == 2);
+        REQUIRE(out[1].result() == 2);
+    }
+
+    SECTION("Items Left At Destruction") {
+        auto shared = std::make_shared<int>(1);
+        {
+            Channel<std::shared_ptr<int>, int> channel{4};
+            REQUIRE(channel.send(Result<std::shared_ptr<int>, int>{in_place_ok, shared}).is_ok());
+            REQUIRE(channel.send(Result<std::shared_ptr<int>, int>{in_place_ok, shared}).is_ok());
+            REQUIRE(shared.use_count() == 3);
+        }
+        REQUIRE(shared.use_count() == 1);
+    }
+}
+
+TEST_CASE("Channel Threads", "[channel]") {
+    constexpr int PRODUCERS = 4;
+    constexpr int CONSUMERS = 3;
+    constexpr int ITEMS     = 20000;
+
+    SECTION("Blocking Send Larger Than The Channel") {
+        Channel<int, std::string> channel{4};
+        std::vector<Item> items;
+        for (int i = 0; i < 1000; ++i) {
+            items.push_back(ok(i));
+        }
+        bool sent = false;
+        std::thread producer{[&channel, &items, &sent] {
+            sent = channel.send_batch(items).is_ok();
+            channel.close();
+        }};
+
+        int expected = 0;
+        for (auto next = channel.recv(); next.is_ok(); next = channel.recv()) {
+            REQUIRE(next.result() == expected++);
+        }
+        producer.join();
+        REQUIRE(sent);
+        REQUIRE(expected == 1000);
+    }
+
+    SECTION("Every Item Is Received Once") {
+        Channel<int, std::string> channel{64};
+        std::vector<std::atomic<int>> seen(PRODUCERS * ITEMS);
+        std::atomic<int> errors{0};
+        std::atomic<int> failed_sends{0};
+
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < PRODUCERS; ++producer) {
+            producers.emplace_back([&channel, &failed_sends, producer] {
+                std::vector<Item> batch;
+                for (int i = 0; i < ITEMS; ++i) {
+                    const int value = producer * ITEMS + i;
+                    Item item       = value % 100 == 0 ? err(std::to_string(value)) : ok(value);
+                    // Odd producers send one by one, even ones in batches
+                    if (producer % 2 == 1) {
+                        failed_sends += channel.send(std::move(item)).is_err();
+                        continue;
+                    }
+                    batch.push_back(std::move(item));
+                    if (batch.size() == 37) {
+                        failed_sends += channel.send_batch(batch).is_err();
+                    }
+                }
+                failed_sends += channel.send_batch(batch).is_err();
+            });
+        }
+
+        std::vector<std::thread> consumers;
+        for (int consumer = 0; consumer < CONSUMERS; ++consumer) {
+            consumers.emplace_back([&channel, &seen, &errors, consumer] {
+                const auto take = [&seen, &errors](const Item& item) {
+                    const int value = item.is_ok() ? item.result() : std::stoi(item.error());
+                    errors += item.is_err();
+                    ++seen[static_cast<std::size_t>(value)];
+                };
+                if (consumer == 0) {
+                    for (auto next = channel.recv(); !(next.is_err() && next.error().closed()); next = channel.recv()) {
+                        take(next.is_ok() ? ok(next.result()) : err(next.error().error()));
+                    }
+                    return;
+                }
+                std::vector<Item> out;
+                while (channel.recv_batch(out, 16).is_ok()) {
+                    for (const auto& item : out) {
+                        take(item);
+                    }
+                    out.clear();
+                }
+            });
+        }
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        channel.close();
+        for (auto& consumer : consumers) {
+            consumer.join();
+        }
+
+        REQUIRE(failed_sends == 0);
+        REQUIRE(errors == PRODUCERS * ITEMS / 100);
+        for (const auto& count : seen) {
+            REQUIRE(count == 1);
+        }
+    }
+}
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/coroutine.hxx"
+#include "utils/result.hxx"
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+namespace {
+
+using namespace cogle::utils::result;
+using cogle::utils::coroutine::ArenaScope;
+using cogle::utils::coroutine::FrameArena;
+
+// Counts how often it is moved or copied
+struct Counted {
+    explicit Counted(int v) : value(v) {}
+    Counted(const Counted& o) : value(o.value) { ++copies; }
+    Counted(Counted&& o) noexcept : value(o.value) { ++moves; }
+
+    static void reset() { copies = moves = 0; }
+
+    int value;
+
+    static inline int copies = 0;
+    static inline int moves  = 0;
+};
+
+Result<int, std::string> parse(int value) {
+    if (value < 0) {
+        return Err<std::string>{"negative"};
+    }
+    return Ok{value};
+}
+
+Result<int, std::string> sum(int a, int b) {
+    const int x = co_await parse(a);
+    const int y = co_await parse(b);
+    co_return x + y;
+}
+
+Result<void, std::string> check(int value, int& reached) {
+    if (value > 100) {
+        co_await Err<std::string>{"too large"};
+    }
+    reached = co_await sum(value, value);
+    co_return;
+}
+
+Result<std::string, std::string> describe(int value) {
+    const Result<int, std::string> parsed = parse(value);
+    const int& ref = co_await parsed;
+    co_return Ok{std::to_string(ref)};
+}
+
+Result<int, std::size_t> length(int value) {
+    // The error of the awaited Result is converted to the error of the coroutine
+    using Text      = Result<std::string, std::size_t>;
+    const Text text = value < 0 ? Text{Err<std::size_t>{7}} : Text{Ok{std::to_string(value)}};
+    co_return static_cast<int>((co_await text).size());
+}
+
+Result<int, Counted> relay(Result<int, Counted>&& source) {
+    co_return co_await std::move(source);
+}
+
+Result<int, std::string> throws() {
+    co_await parse(1);
+    throw std::runtime_error{"thrown"};
+}
+
+Result<std::size_t, std::string> depth(int levels, const FrameArena& arena) {
+    if (levels == 0) {
+        co_return arena.used();
+    }
+    co_return co_await depth(levels - 1, arena);
+}
+
+TEST_CASE("Coroutine co_await", "[coroutine]") {
+    SECTION("Ok results are unwrapped") {
+        const auto result = sum(2, 3);
+        REQUIRE(result.is_ok());
+        REQUIRE(result.result() == 5);
+    }
+    SECTION("The first error ends the coroutine") {
+        REQUIRE(sum(-1, 3).error() == "negative");
+        REQUIRE(sum(1, -3).error() == "negative");
+    }
+    SECTION("Void coroutines") {
+        int reached = 0;
+        REQUIRE(check(4, reached).is_ok());
+        REQUIRE(reached == 8);
+
+        reached = 0;
+        REQUIRE(check(200, reached).error() == "too large");
+        REQUIRE(check(-4, reached).error() == "negative");
+        REQUIRE(reached == 0);
+    }
+    SECTION("Lvalue Results are borrowed") {
+        REQUIRE(describe(12).result() == "12");
+        REQUIRE(describe(-12).error() == "negative");
+    }
+    SECTION("Errors are converted") {
+        REQUIRE(length(1234).result() == 4);
+        REQUIRE(length(-1).error() == 7);
+    }
+    SECTION("Errors are moved") {
+        Counted::reset();
+        REQUIRE(relay(Result<int, Counted>{in_place_err, 3}).error().value == 3);
+        REQUIRE(Counted::copies == 0);
+    }
+    SECTION("Exceptions propagate") { REQUIRE_THROWS_AS(throws(), std::runtime_error); }
+}
+
+TEST_CASE("Coroutine Frame Arena", "[coroutine]") {
+    alignas(std::max_align_t) std::byte buffer[16 * 1024];
+    FrameArena arena{buffer, sizeof(buffer)};
+
+    SECTION("Frames are taken from the installed arena and released") {
+        ArenaScope scope{arena};
+
+        const auto used = depth(8, arena);
+        REQUIRE(used.result() > 0);
+        REQUIRE(arena.used() == 0);
+    }
+    SECTION("Without an arena frames are taken from the heap") {
+        REQUIRE(depth(8, arena).result() == 0);
+    }
+    SECTION("Frames that do not fit fall back to the heap") {
+        alignas(std::max_align_t) std::byte small[16];
+        FrameArena tiny{small, sizeof(small)};
+        ArenaScope scope{tiny};
+
+        REQUIRE(sum(2, 3).result() == 5);
+        REQUIRE(tiny.used() == 0);
+    }
+    SECTION("Scopes nest") {
+        alignas(std::max_align_t) std::byte other[4 * 1024];
+        FrameArena inner{other, sizeof(other)};
+
+        ArenaScope outer_scope{arena};
+        {
+            ArenaScope inner_scope{inner};
+            REQUIRE(FrameArena::current() == &inner);
+            REQUIRE(depth(2, inner).result() > 0);
+        }
+        REQUIRE(FrameArena::current() == &arena);
+    }
+}
+
+}  // namespace
+
+#endif
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/error_counters.hxx"
+
+namespace {
+
+using namespace cogle::utils::counters;
+using cogle::utils::location::SourceLocation;
+
+// The site table is process wide, every test uses its own file name so that sites of other tests can be ignored
+SiteCount find_site(const char* file, const int line) {
+    SiteCount found{SourceLocation{}, 0, 0};
+    ErrorCounters::for_each([&](const SiteCount& count) {
+        if (count.location == SourceLocation::current(file, count.location.function_name(), line, 0)) {
+            found = count;
+        }
+    });
+    return found;
+}
+
+TEST_CASE("ErrorCounters Counting", "[counters]") {
+    ErrorCounters::reset();
+
+    SECTION("Errors are counted per site") {
+        static constexpr auto first  = SourceLocation::current("counting.cpp", "parse", 10, 0);
+        static constexpr auto second = SourceLocation::current("counting.cpp", "parse", 20, 0);
+
+        for (int i = 0; i < 3; ++i) {
+            count_err(first);
+        }
+        count_err(second);
+
+        REQUIRE(find_site("counting.cpp", 10).errors == 3);
+        REQUIRE(find_site("counting.cpp", 20).errors == 1);
+        REQUIRE(find_site("counting.cpp", 10).propagations == 0);
+    }
+    SECTION("Only failed propagations are counted") {
+        static constexpr auto site = SourceLocation::current("counting.cpp", "chain", 30, 0);
+
+        count_propagation(true, site);
+        count_propagation(false, site);
+        count_propagation(true, site);
+
+        const auto count = find_site("counting.cpp", 30);
+        REQUIRE(count.propagations == 2);
+        REQUIRE(count.errors == 0);
+    }
+    SECTION("Copies of the same location share a site") {
+        // Distinct arrays, unlike string literals, are guaranteed to live at different addresses
+        static constexpr char file[]      = "sharing.cpp";
+        static constexpr char file_copy[] = "sharing.cpp";
+
+        count_err(SourceLocation::current(file, "parse", 10, 0));
+        count_err(SourceLocation::current(file_copy, "parse", 10, 0));
+
+        REQUIRE(find_site("sharing.cpp", 10).errors == 2);
+    }
+    SECTION("Sites with colliding keys are counted apart") {
+        static constexpr auto first  = SourceLocation::current("collide.cpp", "f162789", 1, 0);
+        static constexpr auto second = SourceLocation::current("collide.cpp", "f379192", 1, 0);
+        STATIC_REQUIRE(first.hash() == second.hash());
+
+        count_err(first);
+        count_err(second);
+        count_err(second);
+
+        std::vector<SiteCount> found;
+        ErrorCounters::for_each([&found](const SiteCount& count) {
+            if (std::string(count.location.file_name()) == "collide.cpp") {
+                found.push_back(count);
+            }
+        });
+        REQUIRE(found.size() == 2);
+        REQUIRE(found[0].errors + found[1].errors == 3);
+        REQUIRE(found[0].errors != found[1].errors);
+    }
+    SECTION("reset zeroes the counters but keeps the sites") {
+        static constexpr auto site = SourceLocation::current("counting.cpp", "reset", 40, 0);
+
+        count_err(site);
+        REQUIRE(find_site("counting.cpp", 40).errors == 1);
+
+        ErrorCounters::reset();
+        const auto count = find_site("counting.cpp", 40);
+        REQUIRE(std::string(count.location.function_name()) == "reset");
+        REQUIRE(count.errors == 0);
+    }
+}
+
+TEST_CASE("ErrorCounters Threads", "[counters]") {
+    ErrorCounters::reset();
+
+    static constexpr auto site      = SourceLocation::current("threads.cpp", "worker", 1, 0);
+    static constexpr auto COUNT     = 10000;
+    static constexpr auto N_THREADS = 8;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < N_THREADS; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < COUNT; ++i) {
+                count_err(site);
+                count_propagation(true, site);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // All shards are summed up
+    const auto count = find_site("threads.cpp", 1);
+    REQUIRE(count.errors == COUNT * N_THREADS);
+    REQUIRE(count.propagations == COUNT * N_THREADS);
+}
+
+TEST_CASE("ErrorCounters Snapshot", "[counters]") {
+    static constexpr auto first  = SourceLocation::current("snapshot.cpp", "a", 1, 0);
+    static constexpr auto second = SourceLocation::current("snapshot.cpp", "b", 2, 0);
+    count_err(first);
+    count_err(second);
+
+    SiteCount out[1]{};
+    const auto total = ErrorCounters::snapshot(out, 1);
+    REQUIRE(total >= 2);
+    REQUIRE(out[0].location.file_name() != nullptr);
+
+    std::vector<SiteCount> all(total, SiteCount{SourceLocation{}, 0, 0});
+    REQUIRE(ErrorCounters::snapshot(all.data(), all.size()) == total);
+    REQUIRE(ErrorCounters::dropped() == 0);
+}
+
+}  // namespace
\ No newline at end of file
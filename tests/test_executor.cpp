@@ -0,0 +1,230 @@
+#include <atomic>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/executor.hxx"
+#include "utils/result.hxx"
+
+namespace {
+
+using namespace cogle::utils::result;
+using namespace cogle::utils::executor;
+namespace executor = cogle::utils::executor;
+
+Result<int, std::string> ok(const int value) { return Result<int, std::string>{in_place_ok, value}; }
+
+Result<int, std::string> err(const std::string& error) { return Result<int, std::string>{in_place_err, error}; }
+
+// Forks through the pool, the waiting tasks run the others while they wait
+Result<long, std::string> fib(ThreadPool& pool, const int n) {
+    if (n < 2) {
+        return Result<long, std::string>{in_place_ok, n};
+    }
+    auto left  = pool.submit([&pool, n] { return fib(pool, n - 1); });
+    auto right = fib(pool, n - 2);
+    return std::move(left).get().and_then(
+        [&right](const long value) { return right.map([value](const long other) { return value + other; }); });
+}
+
+TEST_CASE("Executor Work Deque", "[executor]") {
+    struct Counted final : executor::detail::Task {
+        void run() noexcept override {}
+    };
+    std::vector<Counted> tasks(10000);
+
+    SECTION("Owner Pops Last In First Out, Thieves First In First Out") {
+        executor::detail::WorkDeque deque{4};
+        for (std::size_t i = 0; i < 10; ++i) {
+            deque.push(&tasks[i]);
+        }
+        REQUIRE(deque.steal() == &tasks[0]);
+        REQUIRE(deque.pop() == &tasks[9]);
+        REQUIRE(deque.steal() == &tasks[1]);
+        for (std::size_t i = 8; i >= 2; --i) {
+            REQUIRE(deque.pop() == &tasks[i]);
+        }
+        REQUIRE(deque.empty());
+        REQUIRE(deque.pop() == nullptr);
+        REQUIRE(deque.steal() == nullptr);
+    }
+
+    SECTION("Every Task Is Taken Once") {
+        executor::detail::WorkDeque deque{16};
+        std::atomic<bool> done{false};
+        std::vector<std::vector<executor::detail::Task*>> stolen(3);
+        std::vector<std::thread> thieves;
+        for (auto& taken : stolen) {
+            thieves.emplace_back([&deque, &done, &taken] {
+                while (!done.load() || !deque.empty()) {
+                    if (executor::detail::Task* task = deque.steal()) {
+                        taken.push_back(task);
+                    }
+                }
+            });
+        }
+
+        std::vector<executor::detail::Task*> popped;
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            deque.push(&tasks[i]);
+            if (i % 3 == 0) {
+                if (executor::detail::Task* task = deque.pop()) {
+                    popped.push_back(task);
+                }
+            }
+        }
+        done = true;
+        for (auto& thief : thieves) {
+            thief.join();
+        }
+
+        std::set<executor::detail::Task*> seen(popped.begin(), popped.end());
+        std::size_t total = popped.size();
+        for (const auto& taken : stolen) {
+            seen.insert(taken.begin(), taken.end());
+            total += taken.size();
+        }
+        REQUIRE(total == tasks.size());
+        REQUIRE(seen.size() == tasks.size());
+    }
+}
+
+TEST_CASE("Executor Submit", "[executor]") {
+    ThreadPool pool{4};
+    REQUIRE(pool.size() == 4);
+
+    SECTION("Results And Errors") {
+        REQUIRE(pool.submit([] { return ok(42); }).get().result() == 42);
+        REQUIRE(pool.submit([] { return err("failed"); }).get().error() == "failed");
+
+        std::atomic<int> ran{0};
+        auto done = pool.submit([&ran] {
+            ++ran;
+            return Result<void, std::string>{in_place_ok};
+        });
+        REQUIRE(std::move(done).get().is_ok());
+        REQUIRE(ran == 1);
+    }
+
+    SECTION("Many Tasks") {
+        std::vector<Future<int, std::string>> futures;
+        for (int i = 0; i < 10000; ++i) {
+            futures.push_back(pool.submit([i] { return i % 1000 == 999 ? err(std::to_string(i)) : ok(i); }));
+        }
+        long sum   = 0;
+        int errors = 0;
+        for (auto& future : futures) {
+            auto result = std::move(future).get();
+            if (result.is_ok()) {
+                sum += result.result();
+            } else {
+                ++errors;
+            }
+            REQUIRE(!future.valid());
+        }
+        REQUIRE(errors == 10);
+        REQUIRE(sum == 10000L * 9999 / 2 - (999 + 1999 + 2999 + 3999 + 4999 + 5999 + 6999 + 7999 + 8999 + 9999));
+    }
+
+    SECTION("Fork Join") {
+        REQUIRE(fib(pool, 20).result() == 6765);
+
+        ThreadPool single{1};
+        REQUIRE(fib(single, 15).result() == 610);
+    }
+
+    SECTION("Destruction Runs Pending Tasks") {
+        std::atomic<int> ran{0};
+        {
+            ThreadPool scoped{2};
+            for (int i = 0; i < 100; ++i) {
+                static_cast<void>(scoped.submit([&ran] {
+                    ++ran;
+                    return Result<void, int>{in_place_ok};
+                }));
+            }
+        }
+        REQUIRE(ran == 100);
+    }
+}
+
+TEST_CASE("Executor Future Combinators", "[executor]") {
+    ThreadPool pool{2};
+
+    SECTION("Chains") {
+        auto future = pool.submit([] { return ok(20); })
+                          .map([](const int value) { return value + 1; })
+                          .and_then([](const int value) { return ok(value * 2); })
+                          .map([](const int value) { return std::to_string(value); });
+        REQUIRE(std::move(future).get().result() == "42");
+
+        auto failed = pool.submit([] { return err("parse"); })
+                          .map([](const int value) { return value + 1; })
+                          .map_err([](const std::string& error) { return error.size(); });
+        REQUIRE(std::move(failed).get().error() == 5);
+
+        auto recovered = pool.submit([] { return err("parse"); }).or_else([](const std::string&) { return ok(7); });
+        REQUIRE(std::move(recovered).get().result() == 7);
+
+        auto whole = pool.submit([] { return ok(1); }).then([](Result<int, std::string>&& result) {
+            return Result<bool, int>{in_place_ok, result.is_ok()};
+        });
+        REQUIRE(std::move(whole).get().result());
+    }
+
+    SECTION("Continuations Run On The Completing Thread") {
+        std::atomic<bool> gate{false};
+        std::thread::id task_thread;
+        std::thread::id continuation_thread;
+
+        auto future = pool.submit([&] {
+                              task_thread = std::this_thread::get_id();
+                              while (!gate.load()) {
+                                  std::this_thread::yield();
+                              }
+                              return ok(1);
+                          })
+                          .map([&](const int value) {
+                              continuation_thread = std::this_thread::get_id();
+                              return value;
+                          });
+        gate = true;
+        REQUIRE(std::move(future).get().result() == 1);
+        REQUIRE(continuation_thread == task_thread);
+        REQUIRE(continuation_thread != std::this_thread::get_id());
+    }
+
+    SECTION("Continuations Of A Ready Future Run Inline") {
+        auto future = pool.submit([] { return ok(1); });
+        future.wait();
+        REQUIRE(future.is_ready());
+
+        std::thread::id continuation_thread;
+        auto next = std::move(future).map([&](const int value) {
+            continuation_thread = std::this_thread::get_id();
+            return value;
+        });
+        REQUIRE(continuation_thread == std::this_thread::get_id());
+        REQUIRE(std::move(next).get().result() == 1);
+    }
+
+    SECTION("Match") {
+        std::atomic<int> oks{0};
+        std::atomic<int> errs{0};
+        const auto on_ok  = [&oks](const int value) { oks += value; };
+        const auto on_err = [&errs](const std::string&) { ++errs; };
+
+        pool.submit([] { return ok(3); }).match(on_ok, on_err);
+        pool.submit([] { return err("x"); }).match(on_ok, on_err);
+        while (oks.load() != 3 || errs.load() != 1) {
+            std::this_thread::yield();
+        }
+        REQUIRE(oks == 3);
+        REQUIRE(errs == 1);
+    }
+}
+
+}  // namespace
\ No newline at end of file
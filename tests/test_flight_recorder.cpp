@@ -0,0 +1,189 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/flight_recorder.hxx"
+
+namespace {
+
+using namespace cogle::utils::recorder;
+using cogle::utils::location::SourceLocation;
+
+const std::string RECORDER_PATH = (std::filesystem::temp_directory_path() / "cogle_flight_recorder_test.bin").native();
+
+// Maps the recorder file a second time, read only, the way the dump tool would after a crash. A private mapping can be
+// written to without changing the file.
+struct ReadBack {
+    explicit ReadBack(const bool writable = false) {
+        const int fd = ::open(RECORDER_PATH.c_str(), O_RDONLY);
+        REQUIRE(fd != -1);
+        size = static_cast<std::size_t>(::lseek(fd, 0, SEEK_END));
+        base = writable ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)
+                        : ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        REQUIRE(base != MAP_FAILED);
+    }
+
+    ~ReadBack() { ::munmap(base, size); }
+
+    std::vector<Entry> entries(const std::uint32_t ring) const {
+        std::vector<Entry> ret;
+        view().for_each_entry(ring, [&ret](const Entry& e) { ret.push_back(e); });
+        return ret;
+    }
+
+    RecordingView view() const { return RecordingView{base, size}; }
+
+    Entry& entry(const std::uint32_t ring, const std::uint32_t slot) const {
+        auto* header = reinterpret_cast<unsigned char*>(const_cast<RingHeader*>(&view().ring(ring)));
+        return reinterpret_cast<Entry*>(header + sizeof(RingHeader))[slot];
+    }
+
+    void* base;
+    std::size_t size;
+};
+
+struct LargeError {
+    std::array<unsigned char, 64> bytes;
+};
+
+TEST_CASE("FlightRecorder Open", "[recorder]") {
+    SECTION("Capacity must be a power of two") {
+        REQUIRE(FlightRecorder::open(RECORDER_PATH.c_str(), 3) == EINVAL);
+        REQUIRE(FlightRecorder::open(RECORDER_PATH.c_str(), 0) == EINVAL);
+        REQUIRE(FlightRecorder::open(RECORDER_PATH.c_str(), 4, 0) == EINVAL);
+        REQUIRE_FALSE(FlightRecorder::is_open());
+    }
+    SECTION("Only one recorder can be open") {
+        REQUIRE(FlightRecorder::open(RECORDER_PATH.c_str(), 4, 2) == 0);
+        REQUIRE(FlightRecorder::is_open());
+        REQUIRE(FlightRecorder::open(RECORDER_PATH.c_str(), 4, 2) == EBUSY);
+        FlightRecorder::close();
+        REQUIRE_FALSE(FlightRecorder::is_open());
+    }
+    SECTION("Missing directory reports errno") {
+        REQUIRE(FlightRecorder::open("/nonexistent_cogle_dir/recorder.bin") == ENOENT);
+    }
+    SECTION("Nothing is recorded while closed") {
+        record_err(5, SourceLocation::current());
+        REQUIRE_FALSE(FlightRecorder::is_open());
+    }
+}
+
+TEST_CASE("FlightRecorder Record", "[recorder]") {
+    REQUIRE(FlightRecorder::open(RECORDER_PATH.c_str(), 4, 2) == 0);
+
+    SECTION("Err entries keep location and payload") {
+        record_err(42, SourceLocation::current("src/parser.cpp", "parse", 17, 3));
+        FlightRecorder::close();
+
+        ReadBack rb{};
+        REQUIRE(rb.view().valid());
+        REQUIRE(rb.view().ring_count() == 1);
+
+        const auto entries = rb.entries(0);
+        REQUIRE(entries.size() == 1);
+        REQUIRE(entries[0].kind == EntryKind::ERR);
+        REQUIRE(entries[0].line == 17);
+        REQUIRE(entries[0].column == 3);
+        REQUIRE(std::string(entries[0].file) == "src/parser.cpp");
+        REQUIRE(std::string(entries[0].function) == "parse");
+        REQUIRE(entries[0].error_size == sizeof(int));
+        REQUIRE(entries[0].payload_size == sizeof(int));
+
+        int payload = 0;
+        std::memcpy(&payload, entries[0].payload, sizeof(payload));
+        REQUIRE(payload == 42);
+    }
+    SECTION("Assert entries keep the message") {
+        record_assert("Expected OK tag to be valid", SourceLocation::current("result.hxx", "assert_ok", 5, 0));
+        FlightRecorder::close();
+
+        ReadBack rb{};
+        const auto entries = rb.entries(0);
+        REQUIRE(entries.size() == 1);
+        REQUIRE(entries[0].kind == EntryKind::ASSERT);
+        REQUIRE(std::string(reinterpret_cast<const char*>(entries[0].payload), entries[0].payload_size) ==
+                "Expected OK tag to be valid");
+    }
+    SECTION("Long names and payloads are truncated") {
+        const std::string long_file = std::string(100, 'd') + "/tail_of_the_path.cpp";
+        const std::string long_func = std::string(100, 'f');
+        record_err(LargeError{}, SourceLocation::current(long_file.c_str(), long_func.c_str(), 1, 0));
+        record_err(std::string{"not trivially copyable"}, SourceLocation::current("a.cpp", "b", 2, 0));
+        FlightRecorder::close();
+
+        ReadBack rb{};
+        const auto entries = rb.entries(0);
+        REQUIRE(entries.size() == 2);
+        REQUIRE(std::string(entries[0].file) == long_file.substr(long_file.size() - (FILE_CAPACITY - 1)));
+        REQUIRE(std::string(entries[0].function) == long_func.substr(0, FUNCTION_CAPACITY - 1));
+        REQUIRE(entries[0].error_size == sizeof(LargeError));
+        REQUIRE(entries[0].payload_size == PAYLOAD_CAPACITY);
+        REQUIRE(entries[1].error_size == 0);
+        REQUIRE(entries[1].payload_size == 0);
+    }
+    SECTION("Rings keep the newest entries") {
+        for (int i = 1; i <= 6; ++i) {
+            record_err(i, SourceLocation::current("loop.cpp", "loop", static_cast<int>(i), 0));
+        }
+        FlightRecorder::close();
+
+        ReadBack rb{};
+        REQUIRE(rb.view().ring(0).head.load() == 6);
+        const auto entries = rb.entries(0);
+        REQUIRE(entries.size() == 4);
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            REQUIRE(entries[i].line == i + 3);
+        }
+    }
+    SECTION("Entries being written are skipped") {
+        for (int i = 1; i <= 6; ++i) {
+            record_err(i, SourceLocation::current("loop.cpp", "loop", static_cast<int>(i), 0));
+        }
+        FlightRecorder::close();
+
+        // The fifth entry overwrote slot 0, clearing its sequence leaves it as a crash while overwriting it would
+        ReadBack rb{true};
+        rb.entry(0, 0).sequence = 0;
+        const auto entries = rb.entries(0);
+        REQUIRE(entries.size() == 3);
+        REQUIRE(entries[0].line == 3);
+        REQUIRE(entries[1].line == 4);
+        REQUIRE(entries[2].line == 6);
+    }
+    SECTION("Every thread records into its own ring") {
+        record_err(1, SourceLocation::current());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 2; ++t) {
+            threads.emplace_back([]() {
+                for (int i = 0; i < 3; ++i) {
+                    record_err(i, SourceLocation::current());
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        FlightRecorder::close();
+
+        // Three threads but only two rings, the last thread to claim a ring is not recorded
+        ReadBack rb{};
+        REQUIRE(rb.view().header().threads.load() == 3);
+        REQUIRE(rb.view().ring_count() == 2);
+        REQUIRE(rb.entries(0).size() + rb.entries(1).size() == 4);
+        REQUIRE(rb.view().ring(0).thread_id != rb.view().ring(1).thread_id);
+    }
+}
+
+}  // namespace
\ No newline at end of file
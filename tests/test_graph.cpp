@@ -0,0 +1,204 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/executor.hxx"
+#include "utils/graph.hxx"
+#include "utils/result.hxx"
+
+namespace {
+
+using namespace cogle::utils::result;
+using namespace cogle::utils::executor;
+
+template <typename R>
+Result<R, std::string> ok(R value) {
+    return Result<R, std::string>{in_place_ok, std::move(value)};
+}
+
+template <typename R>
+Result<R, std::string> err(std::string error) {
+    return Result<R, std::string>{in_place_err, std::move(error)};
+}
+
+TEST_CASE("Graph Dependencies", "[graph]") {
+    ThreadPool pool{4};
+
+    SECTION("Diamond") {
+        Graph<std::string> graph;
+        auto a = graph.add([] { return ok(20); });
+        auto b = graph.add([] { return ok(std::string{"x"}); });
+        auto c = graph.add([](const int value, const std::string& text) { return ok(text + std::to_string(value)); },
+                           a, b);
+        auto d = graph.add([](const int value, const std::string& text) { return ok(text.size() + size_t(value)); },
+                           a, c);
+
+        REQUIRE(graph.size() == 4);
+        REQUIRE(a.id() == 0);
+        REQUIRE(d.id() == 3);
+        REQUIRE(graph.run(pool).is_ok());
+        REQUIRE(c.value() == "x20");
+        REQUIRE(d.value() == 23);
+    }
+
+    SECTION("Void Nodes Only Order") {
+        std::vector<int> order;
+        Graph<std::string> graph;
+        auto first = graph.add([&order] {
+            order.push_back(1);
+            return Result<void, std::string>{in_place_ok};
+        });
+        auto second = graph.add(
+            [&order] {
+                order.push_back(2);
+                return ok(2);
+            },
+            first);
+        auto third = graph.add(
+            [&order](const int value) {
+                order.push_back(value + 1);
+                return Result<void, std::string>{in_place_ok};
+            },
+            first, second);
+
+        REQUIRE(graph.run(pool).is_ok());
+        REQUIRE(order == std::vector<int>{1, 2, 3});
+        REQUIRE(third.has_value());
+    }
+
+    SECTION("Wide And Deep") {
+        Graph<std::string> graph;
+        std::vector<NodeRef<long, std::string>> layer;
+        for (long i = 0; i < 100; ++i) {
+            layer.push_back(graph.add([i] { return ok(i); }));
+        }
+        // Each node of the next layers sums two nodes of the previous one
+        for (int depth = 0; depth < 20; ++depth) {
+            std::vector<NodeRef<long, std::string>> next;
+            for (std::size_t i = 0; i < layer.size(); ++i) {
+                next.push_back(graph.add([](const long x, const long y) { return ok(x + y); }, layer[i],
+                                         layer[(i + 1) % layer.size()]));
+            }
+            layer = std::move(next);
+        }
+
+        for (int run = 0; run < 10; ++run) {
+            REQUIRE(graph.run(pool).is_ok());
+            long total = 0;
+            for (const auto& node : layer) {
+                total += node.value();
+            }
+            REQUIRE(total == 4950L << 20);
+        }
+    }
+
+    SECTION("Run From A Worker") {
+        ThreadPool single{1};
+        auto outer = single.submit([&single] {
+            Graph<std::string> graph;
+            auto a = graph.add([] { return ok(1); });
+            auto b = graph.add([](const int value) { return ok(value + 1); }, a);
+            return graph.run(single).map([&b] { return b.value(); }).map_err([](auto error) { return error.error; });
+        });
+        REQUIRE(std::move(outer).get().result() == 2);
+    }
+
+    SECTION("Over Aligned Results") {
+        struct alignas(64) Line {
+            int value;
+        };
+
+        using Res = Result<Line, std::string>;
+
+        Graph<std::string> graph;
+        auto first = graph.add([] { return Res{in_place_ok, Line{1}}; });
+        std::vector<NodeRef<Line, std::string>> lines;
+        for (int i = 0; i < 100; ++i) {
+            lines.push_back(graph.add([](const Line& line) { return Res{in_place_ok, Line{line.value + 1}}; }, first));
+        }
+        REQUIRE(graph.run(pool).is_ok());
+        for (const auto& line : lines) {
+            REQUIRE(reinterpret_cast<std::uintptr_t>(&line.value()) % alignof(Line) == 0);
+            REQUIRE(line.value().value == 2);
+        }
+    }
+
+    SECTION("Empty") {
+        Graph<std::string> graph;
+        REQUIRE(graph.run(pool).is_ok());
+    }
+}
+
+TEST_CASE("Graph Errors", "[graph]") {
+    ThreadPool pool{4};
+
+    std::atomic<int> descendants{0};
+    bool fail = true;
+
+    Graph<std::string> graph;
+    auto a = graph.add([] { return ok(1); });
+    auto b = graph.add([&fail] { return fail ? err<int>("b failed") : ok(2); });
+    auto c = graph.add(
+        [&descendants](const int x, const int y) {
+            ++descendants;
+            return ok(x + y);
+        },
+        a, b);
+    auto d = graph.add(
+        [&descendants](const int x) {
+            ++descendants;
+            return ok(x * 2);
+        },
+        c);
+
+    SECTION("First Error Is Reported With Its Node") {
+        auto result = graph.run(pool);
+        REQUIRE(result.is_err());
+        REQUIRE(result.error().node == b.id());
+        REQUIRE(result.error().error == "b failed");
+        REQUIRE(descendants == 0);
+        REQUIRE(!b.has_value());
+        REQUIRE(!c.has_value());
+        REQUIRE(!d.has_value());
+    }
+
+    SECTION("Runs Again After An Error") {
+        REQUIRE(graph.run(pool).is_err());
+        fail = false;
+        REQUIRE(graph.run(pool).is_ok());
+        REQUIRE(d.value() == 6);
+        REQUIRE(descendants == 2);
+
+        fail = true;
+        REQUIRE(graph.run(pool).error().node == b.id());
+        REQUIRE(!b.has_value());
+        REQUIRE(!d.has_value());
+    }
+
+    SECTION("Nodes Not Depending On The Error Still Run") {
+        auto e = graph.add([] { return ok(3); });
+        auto f = graph.add([](const int x) { return ok(x + 1); }, e);
+        auto g = graph.add([](const int x) { return ok(x * 10); }, a);
+
+        REQUIRE(graph.run(pool).error().node == b.id());
+        REQUIRE(descendants == 0);
+        REQUIRE(!c.has_value());
+        REQUIRE(f.value() == 4);
+        REQUIRE(g.value() == 10);
+    }
+
+    SECTION("Independent Failures Report One") {
+        Graph<std::string> many;
+        for (int i = 0; i < 50; ++i) {
+            static_cast<void>(many.add([i] { return err<int>(std::to_string(i)); }));
+        }
+        auto result = many.run(pool);
+        REQUIRE(result.is_err());
+        REQUIRE(result.error().error == std::to_string(result.error().node));
+    }
+}
+
+}  // namespace
\ No newline at end of file
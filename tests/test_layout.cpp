@@ -0,0 +1,128 @@
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/result.hxx"
+
+namespace {
+
+using namespace cogle::utils::result;
+
+struct Empty {};
+struct OtherEmpty {};
+
+TEST_CASE("Result Layout Tag", "[result][layout]") {
+    SECTION("ResultTag is a single byte") { STATIC_REQUIRE(sizeof(detail::ResultTag) == 1); }
+    SECTION("Result<char, char> tag is placed after the payload") {
+        constexpr char a = 'a';
+        Result<char, char> result{Ok<char>{a}};
+
+        unsigned char bytes[sizeof(result)];
+        std::memcpy(bytes, &result, sizeof(result));
+
+        REQUIRE(bytes[0] == static_cast<unsigned char>(a));
+        REQUIRE(bytes[1] == static_cast<unsigned char>(detail::ResultTag::OK));
+    }
+}
+
+TEST_CASE("Result Layout Report", "[result][layout]") {
+    SECTION("Result<char, char>") {
+        using report = layout_report<char, char>;
+
+        STATIC_REQUIRE(report::size == 2);
+        STATIC_REQUIRE(report::alignment == 1);
+        STATIC_REQUIRE(report::payload_size == 1);
+        STATIC_REQUIRE(report::tag_size == 1);
+        STATIC_REQUIRE(report::padding == 0);
+        STATIC_REQUIRE_FALSE(report::is_niche);
+    }
+    SECTION("Result<int, int>") {
+        using report = layout_report<int, int>;
+
+        STATIC_REQUIRE(report::size == 8);
+        STATIC_REQUIRE(report::payload_size == 4);
+        STATIC_REQUIRE(report::padding == 3);
+    }
+    SECTION("Result<void, char>") {
+        using report = layout_report<void, char>;
+
+        STATIC_REQUIRE(report::size == 2);
+        STATIC_REQUIRE(report::padding == 0);
+    }
+    SECTION("Result<double, Empty>") {
+        using report = layout_report<double, Empty>;
+
+        STATIC_REQUIRE(report::size == sizeof(double) + alignof(double));
+        STATIC_REQUIRE(report::payload_size == sizeof(double));
+    }
+    SECTION("Result<std::string, int>") {
+        using report = layout_report<std::string, int>;
+
+        STATIC_REQUIRE(report::size == sizeof(std::string) + alignof(std::string));
+        STATIC_REQUIRE(report::padding == alignof(std::string) - 1);
+    }
+    SECTION("Result<char, char> report can be printed") {
+        std::stringstream ss;
+        ss << layout_report<char, char>{};
+
+        REQUIRE(ss.str() == "Size: 2\tAlign: 1\tPayload: 1\tTag: 1\tPadding: 0\tNiche: 0");
+    }
+}
+
+TEST_CASE("Result Layout Empty Elision", "[result][layout]") {
+    SECTION("Result<void, Empty> is a single byte") {
+        using report = layout_report<void, Empty>;
+
+        STATIC_REQUIRE(report::size == 1);
+        STATIC_REQUIRE(report::is_niche);
+        STATIC_REQUIRE(report::tag_size == 0);
+    }
+    SECTION("Result<Empty, OtherEmpty> is a single byte") { STATIC_REQUIRE(sizeof(Result<Empty, OtherEmpty>) == 1); }
+    SECTION("Result<void, Empty> Ok and Err") {
+        Result<void, Empty> ok{Ok<void>{}};
+        Result<void, Empty> err{Err<Empty>{Empty{}}};
+
+        REQUIRE(ok.is_ok());
+        REQUIRE(err.is_err());
+
+        auto matched = err.match([]() { return 0; }, [](Empty) { return 1; });
+        REQUIRE(matched == 1);
+    }
+    SECTION("Result<Empty, OtherEmpty> Ok and Err") {
+        Result<Empty, OtherEmpty> ok{Ok<Empty>{Empty{}}};
+        Result<Empty, OtherEmpty> err{Err<OtherEmpty>{OtherEmpty{}}};
+
+        REQUIRE(ok.is_ok());
+        REQUIRE(err.is_err());
+
+        auto mapped = ok.map([](Empty) { return 10; });
+        REQUIRE(mapped.is_ok());
+        REQUIRE(mapped.result() == 10);
+    }
+}
+
+TEST_CASE("Result Layout References", "[result][layout]") {
+    SECTION("Result<const std::string&, Empty> uses the null pointer") {
+        using report = layout_report<const std::string&, Empty>;
+
+        STATIC_REQUIRE(report::size == sizeof(void*));
+        STATIC_REQUIRE(report::is_niche);
+        STATIC_REQUIRE(report::tag_size == 0);
+    }
+    SECTION("Result<std::string&, char> tags the pointer") {
+        using report = layout_report<std::string&, char>;
+
+        STATIC_REQUIRE(report::size == sizeof(void*));
+        STATIC_REQUIRE(report::tag_size == 0);
+    }
+    SECTION("Result<std::string&, std::string> stores a pointer next to the error") {
+        using report = layout_report<std::string&, std::string>;
+
+        STATIC_REQUIRE(report::size == sizeof(std::string) + alignof(std::string));
+        STATIC_REQUIRE(report::payload_size == sizeof(std::string));
+        STATIC_REQUIRE(report::tag_size == 1);
+    }
+}
+
+}  // namespace
\ No newline at end of file
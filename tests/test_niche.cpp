@@ -0,0 +1,223 @@
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <sys/types.h>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/result.hxx"
+
+namespace {
+
+enum class IoError : unsigned char { NONE = 0, TIMEOUT = 1, CLOSED = 2, RESET = 3 };
+
+struct alignas(8) Node {
+    int value;
+};
+
+struct alignas(8) Untagged {
+    int value;
+};
+
+// Only declared, a Result may still point to it
+struct Opaque;
+
+}  // namespace
+
+namespace cogle {
+namespace utils {
+namespace niche {
+template <>
+struct niche_traits<void, IoError> : EnumSentinelNiche<IoError, IoError::NONE> {};
+
+template <>
+struct niche_traits<Node*, int> : PointerTagNiche<Node, int> {};
+
+template <>
+struct niche_traits<const Node*, IoError> : PointerTagNiche<const Node, IoError> {};
+}  // namespace niche
+}  // namespace utils
+}  // namespace cogle
+
+namespace {
+
+using namespace cogle::utils::result;
+using cogle::utils::niche::Errno;
+
+TEST_CASE("Niche Result Sizes", "[result][niche]") {
+    SECTION("Result<int, Errno> is the size of an int") {
+        STATIC_REQUIRE(cogle::utils::niche::is_niche_v<int, Errno>);
+        STATIC_REQUIRE(sizeof(Result<int, Errno>) == sizeof(int));
+        STATIC_REQUIRE(sizeof(Result<ssize_t, Errno>) == sizeof(ssize_t));
+    }
+    SECTION("Result<T*, E> is the size of a pointer") {
+        STATIC_REQUIRE(cogle::utils::niche::is_niche_v<Node*, int>);
+        STATIC_REQUIRE(sizeof(Result<Node*, int>) == sizeof(Node*));
+        STATIC_REQUIRE(sizeof(Result<const Node*, IoError>) == sizeof(Node*));
+    }
+    SECTION("Result<void, Enum> with a sentinel is the size of the enum") {
+        STATIC_REQUIRE(sizeof(Result<void, IoError>) == sizeof(IoError));
+    }
+    SECTION("Types without a niche keep a separate tag") {
+        STATIC_REQUIRE_FALSE(cogle::utils::niche::is_niche_v<int, int>);
+        STATIC_REQUIRE_FALSE(cogle::utils::niche::is_niche_v<char*, int>);
+        STATIC_REQUIRE_FALSE(cogle::utils::niche::is_niche_v<void*, int>);
+        STATIC_REQUIRE_FALSE(cogle::utils::niche::is_niche_v<Node*, std::string>);
+        STATIC_REQUIRE_FALSE(cogle::utils::niche::is_niche_v<Untagged*, int>);
+        STATIC_REQUIRE_FALSE(cogle::utils::niche::is_niche_v<Opaque*, int>);
+        STATIC_REQUIRE(sizeof(Result<Opaque*, int>) > sizeof(Opaque*));
+        STATIC_REQUIRE(sizeof(Result<int, int>) > sizeof(int));
+    }
+    SECTION("Niche Results are trivially copyable") {
+        STATIC_REQUIRE(std::is_trivially_copyable_v<Result<int, Errno>>);
+        STATIC_REQUIRE(std::is_trivially_copyable_v<Result<Node*, int>>);
+        STATIC_REQUIRE(std::is_trivially_copyable_v<Result<void, IoError>>);
+    }
+}
+
+TEST_CASE("Niche Result<int, Errno>", "[result][niche]") {
+    SECTION("Ok round trip") {
+        constexpr int fd = 3;
+        Result<int, Errno> result{Ok<int>{fd}};
+
+        REQUIRE(result.is_ok());
+        REQUIRE_FALSE(result.is_err());
+        REQUIRE(result.result() == fd);
+        REQUIRE(*result == fd);
+    }
+    SECTION("Ok of zero is still Ok") {
+        Result<int, Errno> result{Ok<int>{0}};
+
+        REQUIRE(result.is_ok());
+        REQUIRE(result.result() == 0);
+    }
+    SECTION("Err round trip") {
+        Result<int, Errno> result{Err<Errno>{Errno{ENOENT}}};
+
+        REQUIRE(result.is_err());
+        REQUIRE_FALSE(result.is_ok());
+        REQUIRE(result.error() == Errno{ENOENT});
+    }
+    SECTION("Result<ssize_t, Errno> Err round trip") {
+        Result<ssize_t, Errno> result{Err<Errno>{Errno{EAGAIN}}};
+
+        REQUIRE(result.is_err());
+        REQUIRE(result.error().value == EAGAIN);
+    }
+    SECTION("and_then, map and match") {
+        Result<int, Errno> result{Ok<int>{10}};
+
+        auto mapped = result.map([](int fd) { return fd * 2; });
+        REQUIRE(mapped.is_ok());
+        REQUIRE(mapped.result() == 20);
+
+        auto chained = result.and_then([](int) { return Result<int, Errno>{Err<Errno>{Errno{EBADF}}}; });
+        REQUIRE(chained.is_err());
+        REQUIRE(chained.error() == Errno{EBADF});
+
+        auto matched = chained.match([](int) { return 0; }, [](Errno e) { return e.value; });
+        REQUIRE(matched == EBADF);
+    }
+    SECTION("copy and move") {
+        Result<int, Errno> result{Err<Errno>{Errno{EINTR}}};
+        Result<int, Errno> result_cpy{Ok<int>{1}};
+
+        result_cpy = result;
+        REQUIRE(result_cpy.is_err());
+        REQUIRE(result_cpy.error() == Errno{EINTR});
+
+        Result<int, Errno> result_mv{std::move(result_cpy)};
+        REQUIRE(result_mv.is_err());
+        REQUIRE(result_mv.error() == Errno{EINTR});
+    }
+}
+
+TEST_CASE("Niche Result<T*, E>", "[result][niche]") {
+    SECTION("Ok round trip") {
+        Node node{42};
+        Result<Node*, int> result{Ok<Node*>{&node}};
+
+        REQUIRE(result.is_ok());
+        REQUIRE(result.result() == &node);
+        REQUIRE(result.result()->value == 42);
+    }
+    SECTION("nullptr is a valid Ok") {
+        Result<Node*, int> result{Ok<Node*>{nullptr}};
+
+        REQUIRE(result.is_ok());
+        REQUIRE(result.result() == nullptr);
+    }
+    SECTION("Err round trip with negative values") {
+        constexpr int err = -12345;
+        Result<Node*, int> result{Err<int>{err}};
+
+        REQUIRE(result.is_err());
+        REQUIRE(result.error() == err);
+    }
+    SECTION("Err round trip with enum values") {
+        Result<const Node*, IoError> result{Err<IoError>{IoError::RESET}};
+
+        REQUIRE(result.is_err());
+        REQUIRE(result.error() == IoError::RESET);
+    }
+    SECTION("map") {
+        Node node{7};
+        Result<Node*, int> result{Ok<Node*>{&node}};
+
+        auto mapped = result.map([](Node* n) { return n->value; });
+        REQUIRE(mapped.is_ok());
+        REQUIRE(mapped.result() == 7);
+    }
+}
+
+TEST_CASE("Result Of A Pointer Without A Niche", "[result][niche]") {
+    SECTION("Incomplete pointee") {
+        Opaque* const handle = reinterpret_cast<Opaque*>(std::uintptr_t{0x1000});
+        Result<Opaque*, int> result{Ok<Opaque*>{handle}};
+
+        REQUIRE(result.is_ok());
+        REQUIRE(result.result() == handle);
+        STATIC_REQUIRE(std::is_same_v<decltype(result.result()), Opaque*&>);
+
+        Result<Opaque*, int> failed{Err<int>{3}};
+        REQUIRE(failed.error() == 3);
+    }
+    SECTION("Reference to an incomplete type") {
+        Opaque& ref = *reinterpret_cast<Opaque*>(std::uintptr_t{0x1000});
+        Result<Opaque&, int> result{in_place_ok, ref};
+
+        STATIC_REQUIRE_FALSE(cogle::utils::niche::is_niche_v<Opaque&, int>);
+        REQUIRE(&result.result() == &ref);
+    }
+    SECTION("Accessors keep returning references") {
+        Untagged value{5};
+        Result<Untagged*, int> result{Ok<Untagged*>{&value}};
+
+        STATIC_REQUIRE(std::is_same_v<decltype(result.result()), Untagged*&>);
+        REQUIRE(result.result()->value == 5);
+    }
+}
+
+TEST_CASE("Niche Result<void, Enum>", "[result][niche]") {
+    SECTION("Ok round trip") {
+        Result<void, IoError> result{Ok<void>{}};
+
+        REQUIRE(result.is_ok());
+        REQUIRE_FALSE(result.is_err());
+    }
+    SECTION("Err round trip") {
+        Result<void, IoError> result{Err<IoError>{IoError::TIMEOUT}};
+
+        REQUIRE(result.is_err());
+        REQUIRE(result.error() == IoError::TIMEOUT);
+    }
+    SECTION("and_then") {
+        Result<void, IoError> result{Ok<void>{}};
+
+        auto chained = result.and_then([]() { return Result<void, IoError>{Err<IoError>{IoError::CLOSED}}; });
+        REQUIRE(chained.is_err());
+        REQUIRE(chained.error() == IoError::CLOSED);
+    }
+}
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/pipeline.hxx"
+#include "utils/result.hxx"
+
+namespace {
+
+using namespace cogle::utils::result;
+using namespace cogle::utils::pipeline;
+
+// Counts how often it is moved or copied
+struct Counted {
+    explicit Counted(std::string m) : message(std::move(m)) {}
+    Counted(const Counted& o) : message(o.message) { ++copies; }
+    Counted(Counted&& o) noexcept : message(std::move(o.message)) { ++moves; }
+
+    static void reset() { copies = moves = 0; }
+
+    std::string message;
+
+    static inline int copies = 0;
+    static inline int moves  = 0;
+};
+
+Result<int, Counted> half(int value) {
+    if (value % 2 != 0) {
+        return Err{Counted{"odd"}};
+    }
+    return Ok{value / 2};
+}
+
+Result<int, std::string> parse(const std::string& input) {
+    if (input.empty()) {
+        return Err<std::string>{"empty"};
+    }
+    return Ok{static_cast<int>(input.size())};
+}
+
+TEST_CASE("Pipeline Ok Path", "[pipeline]") {
+    Result<int, std::string> source = parse("abcd");
+
+    Result<std::string, std::string> out = source | then([](int v) { return Result<int, std::string>{Ok{v * 3}}; }) |
+                                           map([](int v) { return std::to_string(v); }) |
+                                           map_err([](std::string&& e) { return e + "!"; });
+
+    REQUIRE(out.is_ok());
+    REQUIRE(out.result() == "12");
+    REQUIRE(source.is_ok());
+    REQUIRE(source.result() == 4);
+}
+
+TEST_CASE("Pipeline Err Path", "[pipeline]") {
+    SECTION("Stages after the failing then are skipped") {
+        int calls = 0;
+
+        auto out = (parse("ab") | then([](int) { return Result<int, std::string>{Err<std::string>{"bad"}}; }) |
+                    map([&calls](int v) {
+                        ++calls;
+                        return v;
+                    }) |
+                    map_err([](std::string&& e) { return e.size(); }))
+                       .run();
+
+        STATIC_REQUIRE(std::is_same_v<decltype(out), Result<int, std::size_t>>);
+        REQUIRE(out.is_err());
+        REQUIRE(out.error() == 3);
+        REQUIRE(calls == 0);
+    }
+
+    SECTION("Errors of the source are mapped") {
+        Result<int, std::string> out = parse("") | map([](int v) { return v + 1; }) |
+                                       map_err([](const std::string& e) { return "parse: " + e; });
+
+        REQUIRE(out.is_err());
+        REQUIRE(out.error() == "parse: empty");
+    }
+
+    SECTION("Error of an lvalue source is left untouched") {
+        Result<int, std::string> source = parse("");
+
+        Result<int, std::string> out = source | map_err([](std::string&& e) { return e + "!"; });
+
+        REQUIRE(out.error() == "empty!");
+        REQUIRE(source.error() == "empty");
+    }
+}
+
+TEST_CASE("Pipeline Single Error Move", "[pipeline]") {
+    auto identity = [](int v) { return v; };
+
+    SECTION("From an rvalue source") {
+        Result<int, Counted> source = Err{Counted{"source"}};
+        Counted::reset();
+
+        Result<int, Counted> out = std::move(source) | map(identity) | then(half) | map(identity) | then(half);
+
+        REQUIRE(out.error().message == "source");
+        REQUIRE(Counted::moves == 1);
+        REQUIRE(Counted::copies == 0);
+    }
+
+    SECTION("From a failing stage") {
+        Counted::reset();
+        auto failed = half(1);
+        const int stage_moves = Counted::moves;
+        Counted::reset();
+
+        Result<int, Counted> out = Result<int, Counted>{Ok{6}} | then(half) | then(half) | map(identity) |
+                                   then(half) | map(identity);
+
+        REQUIRE(out.error().message == "odd");
+        REQUIRE(Counted::moves == stage_moves + 1);
+        REQUIRE(Counted::copies == 0);
+    }
+
+    SECTION("From an lvalue source") {
+        const Result<int, Counted> source = Err{Counted{"source"}};
+        Counted::reset();
+
+        Result<int, Counted> out = source | map(identity) | then(half);
+
+        REQUIRE(out.error().message == "source");
+        REQUIRE(Counted::moves == 0);
+        REQUIRE(Counted::copies == 1);
+    }
+}
+
+TEST_CASE("Pipeline Composed Stages", "[pipeline]") {
+    auto positive = then([](const int& v) {
+        return v > 0 ? Result<void, std::string>{Ok<void>{}} : Result<void, std::string>{Err<std::string>{"negative"}};
+    });
+    auto validated = std::move(positive) | map([]() { return 7; });
+
+    SECTION("Void results in between") {
+        Result<int, std::string> ok_out = Result<int, std::string>{Ok{1}} | validated;
+        REQUIRE(ok_out.result() == 7);
+
+        Result<int, std::string> err_out = Result<int, std::string>{Ok{-1}} | validated;
+        REQUIRE(err_out.error() == "negative");
+    }
+
+    SECTION("Void sources") {
+        int seen = 0;
+
+        Result<void, std::string> out = Result<void, std::string>{Ok<void>{}} | map([&seen]() { seen = 1; });
+
+        REQUIRE(out.is_ok());
+        REQUIRE(seen == 1);
+    }
+}
+
+TEST_CASE("Pipeline Constexpr", "[pipeline]") {
+    constexpr Result<int, int> out = Result<int, int>{Ok{1}} | map([](int v) { return v + 1; }) |
+                                     then([](int v) { return Result<int, int>{Ok{v * 2}}; });
+    STATIC_REQUIRE(out.result() == 4);
+
+    constexpr Result<int, long> err = Result<int, int>{Err{3}} | map([](int v) { return v + 1; }) |
+                                      map_err([](int e) { return static_cast<long>(e) * 10; });
+    STATIC_REQUIRE(err.error() == 30);
+}
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <memory>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/relocate.hxx"
+#include "utils/result.hxx"
+
+namespace {
+
+// Owns a pointer and opts into trivial relocation, counts how often it is moved or copied
+struct Handle {
+    explicit Handle(int v) : value(std::make_unique<int>(v)) {}
+    Handle(const Handle& o) : value(std::make_unique<int>(*o.value)) { ++copies; }
+    Handle(Handle&& o) noexcept : value(std::move(o.value)) { ++moves; }
+
+    static void reset() { copies = moves = 0; }
+
+    std::unique_ptr<int> value;
+
+    static inline int copies = 0;
+    static inline int moves  = 0;
+};
+
+}  // namespace
+
+template <>
+struct cogle::utils::traits::is_trivially_relocatable<Handle> : std::true_type {};
+
+namespace {
+
+using namespace cogle::utils::result;
+using cogle::utils::relocate::Buffer;
+using cogle::utils::traits::is_trivially_relocatable_v;
+
+TEST_CASE("Trivially Relocatable Trait", "[relocate]") {
+    STATIC_REQUIRE(is_trivially_relocatable_v<int>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<void>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<const Handle>);
+    STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<std::string>);
+
+    STATIC_REQUIRE(is_trivially_relocatable_v<Result<int, int>>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<Result<void, Handle>>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<Result<Handle, int>>);
+    STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<Result<Handle, std::string>>);
+}
+
+TEST_CASE("Relocate Buffer", "[relocate]") {
+    SECTION("Growth relocates without moving") {
+        Buffer<Result<Handle, int>> buffer;
+        Handle::reset();
+        for (int i = 0; i < 100; ++i) {
+            if (i % 3 == 0) {
+                buffer.emplace_back(in_place_err, i);
+            } else {
+                buffer.emplace_back(in_place_ok, i);
+            }
+        }
+
+        REQUIRE(buffer.size() == 100);
+        REQUIRE(buffer.capacity() >= 100);
+        REQUIRE(Handle::moves == 0);
+        REQUIRE(Handle::copies == 0);
+        for (int i = 0; i < 100; ++i) {
+            if (i % 3 == 0) {
+                REQUIRE(buffer[static_cast<std::size_t>(i)].error() == i);
+            } else {
+                REQUIRE(*buffer[static_cast<std::size_t>(i)].result().value == i);
+            }
+        }
+    }
+    SECTION("Erase closes the gap") {
+        Buffer<Result<Handle, int>> buffer;
+        for (int i = 0; i < 10; ++i) {
+            buffer.emplace_back(in_place_ok, i);
+        }
+
+        Handle::reset();
+        auto it = buffer.erase(buffer.begin() + 2, buffer.begin() + 5);
+        REQUIRE(*it->result().value == 5);
+        REQUIRE(buffer.size() == 7);
+        buffer.erase(buffer.begin());
+        REQUIRE(Handle::moves == 0);
+
+        const int expected[] = {1, 5, 6, 7, 8, 9};
+        REQUIRE(buffer.size() == 6);
+        for (std::size_t i = 0; i < buffer.size(); ++i) {
+            REQUIRE(*buffer[i].result().value == expected[i]);
+        }
+    }
+    SECTION("Types that are not relocatable are moved") {
+        Buffer<Result<std::string, std::string>> buffer;
+        for (int i = 0; i < 20; ++i) {
+            std::string value = std::string(40, 'a') + std::to_string(i);
+            buffer.push_back(Result<std::string, std::string>{Ok<std::string>{std::move(value)}});
+        }
+        buffer.erase(buffer.begin(), buffer.begin() + 10);
+        buffer.pop_back();
+
+        REQUIRE(buffer.size() == 9);
+        REQUIRE(buffer[0].result() == std::string(40, 'a') + "10");
+        REQUIRE(buffer[8].result() == std::string(40, 'a') + "18");
+    }
+    SECTION("An argument may refer to an element while growing") {
+        Buffer<std::string> buffer;
+        buffer.reserve(1);
+        buffer.emplace_back("first");
+        buffer.emplace_back(buffer[0]);
+        REQUIRE(buffer[1] == "first");
+    }
+    SECTION("Move") {
+        Buffer<Result<int, int>> buffer;
+        buffer.emplace_back(in_place_ok, 1);
+
+        Buffer<Result<int, int>> moved{std::move(buffer)};
+        REQUIRE(buffer.empty());
+        REQUIRE(moved.size() == 1);
+        REQUIRE(moved[0].result() == 1);
+    }
+}
+
+}  // namespace
\ No newline at end of file
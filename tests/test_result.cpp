@@ -1,5 +1,8 @@
+#include <cerrno>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "catch2/catch_test_macros.hpp"
@@ -82,8 +85,9 @@ TEST_CASE("Result Construct Ok", "[result]") {
 
         result_bar = std::move(result_foo);
 
-        REQUIRE_FALSE(result_foo.is_ok());
-        REQUIRE_FALSE(result_foo.is_err());
+        // Trivially copyable Results are left untouched when moved from
+        REQUIRE(result_foo.is_ok());
+        REQUIRE(result_foo.result() == a);
 
         REQUIRE(result_bar.is_ok());
         REQUIRE(result_bar.result() == a);
@@ -130,7 +134,8 @@ TEST_CASE("Result Construct Ok", "[result]") {
         REQUIRE(result_cpy.is_ok());
         REQUIRE_FALSE(result_cpy.is_err());
 
-        REQUIRE_FALSE(result.is_ok());
+        // Trivially copyable Results are left untouched when moved from
+        REQUIRE(result.is_ok());
         REQUIRE_FALSE(result.is_err());
     }
 }
@@ -195,8 +200,9 @@ TEST_CASE("Result Construct Err", "[result]") {
 
         result_bar = std::move(result_foo);
 
-        REQUIRE_FALSE(result_foo.is_ok());
-        REQUIRE_FALSE(result_foo.is_err());
+        // Trivially copyable Results are left untouched when moved from
+        REQUIRE(result_foo.is_err());
+        REQUIRE(result_foo.error() == test_int);
 
         REQUIRE_FALSE(result_bar.is_ok());
         REQUIRE(result_bar.is_err());
@@ -257,8 +263,9 @@ TEST_CASE("Result Construct Err", "[result]") {
 
         result_bar = std::move(result_foo);
 
-        REQUIRE_FALSE(result_foo.is_ok());
-        REQUIRE_FALSE(result_foo.is_err());
+        // Trivially copyable Results are left untouched when moved from
+        REQUIRE(result_foo.is_err());
+        REQUIRE(result_foo.error() == test_int);
 
         REQUIRE_FALSE(result_bar.is_ok());
         REQUIRE(result_bar.is_err());
@@ -602,4 +609,538 @@ TEST_CASE("Result * Operator") {
     }
 }
 
-}  // namespace
+TEST_CASE("Result Trivially Copyable", "[result]") {
+    SECTION("Result<int, int> is trivially copyable") {
+        STATIC_REQUIRE(std::is_trivially_copyable_v<Result<int, int>>);
+        STATIC_REQUIRE(std::is_trivially_copy_constructible_v<Result<int, int>>);
+        STATIC_REQUIRE(std::is_trivially_move_constructible_v<Result<int, int>>);
+        STATIC_REQUIRE(std::is_trivially_destructible_v<Result<int, int>>);
+    }
+    SECTION("Result<void, int> is trivially copyable") {
+        STATIC_REQUIRE(std::is_trivially_copyable_v<Result<void, int>>);
+        STATIC_REQUIRE(std::is_trivially_move_assignable_v<Result<void, int>>);
+    }
+    SECTION("Non trivial payloads are not trivially copyable") {
+        STATIC_REQUIRE_FALSE(std::is_trivially_copyable_v<Result<std::string, int>>);
+        STATIC_REQUIRE_FALSE(std::is_trivially_copyable_v<Result<int, ErrorStruct>>);
+        STATIC_REQUIRE_FALSE(std::is_trivially_copyable_v<Result<void, ErrorStruct>>);
+    }
+}
+
+
+TEST_CASE("Result Unchecked Access", "[result]") {
+    SECTION("Result<int, int> unwrap_unchecked") {
+        constexpr Result<int, int> result{Ok<int>{5}};
+        STATIC_REQUIRE(result.unwrap_unchecked() == 5);
+
+        Result<int, int> mutable_result{Ok<int>{1}};
+        if (mutable_result) {
+            mutable_result.unwrap_unchecked() = 2;
+        }
+        REQUIRE(mutable_result.result() == 2);
+    }
+    SECTION("Result<int, int> error_unchecked") {
+        constexpr Result<int, int> result{Err<int>{7}};
+        STATIC_REQUIRE(result.error_unchecked() == 7);
+    }
+    SECTION("Result<std::string, std::string> rvalue access") {
+        Result<std::string, std::string> ok_result{Ok<std::string>{"ok"}};
+        REQUIRE(ok_result.is_ok());
+        std::string ok = std::move(ok_result).unwrap_unchecked();
+        REQUIRE(ok == "ok");
+
+        Result<std::string, std::string> err_result{Err<std::string>{"err"}};
+        REQUIRE(err_result.is_err());
+        std::string err = std::move(err_result).error_unchecked();
+        REQUIRE(err == "err");
+    }
+    SECTION("Result<void, int> error_unchecked") {
+        const Result<void, int> result{Err<int>{3}};
+        REQUIRE(result.error_unchecked() == 3);
+    }
+}
+
+// Throws on copy construction once armed, copy assignment never throws
+struct ThrowOnCopy {
+    explicit ThrowOnCopy(int v) : value(v) {}
+    ThrowOnCopy(const ThrowOnCopy& o) : value(o.value), armed(o.armed) {
+        if (armed) {
+            throw std::runtime_error("copy");
+        }
+    }
+    ThrowOnCopy& operator=(const ThrowOnCopy& o) = default;
+
+    int value;
+    bool armed{false};
+};
+
+// Throws on move construction once armed, copies never throw but are not marked noexcept
+struct ThrowOnMove {
+    explicit ThrowOnMove(int v) : value(v) {}
+    ThrowOnMove(const ThrowOnMove& o) : value(o.value), armed(o.armed) {}
+    ThrowOnMove(ThrowOnMove&& o) : value(o.value), armed(o.armed) {
+        if (armed) {
+            throw std::runtime_error("move");
+        }
+    }
+    ThrowOnMove& operator=(const ThrowOnMove& o) = default;
+
+    int value;
+    bool armed{false};
+};
+
+TEST_CASE("Result Assignment Reuses Storage", "[result]") {
+    SECTION("Ok to Ok keeps the vector buffer") {
+        Result<std::vector<int>, int> dst{Ok<std::vector<int>>{std::vector<int>(64, 1)}};
+        const int* buffer = dst.result().data();
+
+        const Result<std::vector<int>, int> src{Ok<std::vector<int>>{std::vector<int>(8, 2)}};
+        dst = src;
+        REQUIRE(dst.result().size() == 8);
+        REQUIRE(dst.result().data() == buffer);
+        REQUIRE(dst.result().capacity() >= 64);
+    }
+    SECTION("Err to Err keeps the string buffer") {
+        Result<int, std::string> dst{Err<std::string>{std::string(100, 'a')}};
+        const char* buffer = dst.error().data();
+
+        const Result<int, std::string> src{Err<std::string>{std::string(50, 'b')}};
+        dst = src;
+        REQUIRE(dst.error() == std::string(50, 'b'));
+        REQUIRE(dst.error().data() == buffer);
+    }
+    SECTION("Changing state") {
+        Result<std::string, std::string> result{Ok<std::string>{"ok"}};
+        const Result<std::string, std::string> err{Err<std::string>{"err"}};
+
+        result = err;
+        REQUIRE(result.is_err());
+        REQUIRE(result.error() == "err");
+
+        result = Result<std::string, std::string>{Ok<std::string>{"again"}};
+        REQUIRE(result.is_ok());
+        REQUIRE(result.result() == "again");
+    }
+    SECTION("Self assignment") {
+        Result<std::string, int> result{Ok<std::string>{"self"}};
+        auto& alias = result;
+
+        result = alias;
+        REQUIRE(result.result() == "self");
+        result = std::move(alias);
+        REQUIRE(result.result() == "self");
+    }
+    SECTION("Result<void, std::string>") {
+        Result<void, std::string> result{Err<std::string>{std::string(100, 'a')}};
+        const char* buffer = result.error().data();
+
+        const Result<void, std::string> src{Err<std::string>{std::string(50, 'b')}};
+        result = src;
+        REQUIRE(result.error().data() == buffer);
+
+        result = Result<void, std::string>{Ok<void>{}};
+        REQUIRE(result.is_ok());
+        result = Result<void, std::string>{Err<std::string>{"err"}};
+        REQUIRE(result.error() == "err");
+    }
+    SECTION("Strong guarantee when the state changes") {
+        ThrowOnCopy armed{2};
+        armed.armed = true;
+
+        Result<std::string, ThrowOnCopy> result{Ok<std::string>{"kept"}};
+        Result<std::string, ThrowOnCopy> err{Err<ThrowOnCopy>{ThrowOnCopy{1}}};
+        err.error().armed = true;
+
+        REQUIRE_THROWS(result = err);
+        REQUIRE(result.is_ok());
+        REQUIRE(result.result() == "kept");
+
+        // Same state goes through the non throwing copy assignment
+        Result<std::string, ThrowOnCopy> other{Err<ThrowOnCopy>{ThrowOnCopy{3}}};
+        other = err;
+        REQUIRE(other.error().value == 1);
+    }
+    SECTION("Basic guarantee when moving the new value in throws") {
+        Result<std::string, ThrowOnMove> result{Ok<std::string>{"lost"}};
+        Result<std::string, ThrowOnMove> err{in_place_err, 1};
+        err.error().armed = true;
+
+        // The copy is built aside, the old value destroyed and moving the copy in throws
+        REQUIRE_THROWS(result = err);
+        REQUIRE_FALSE(result.is_ok());
+        REQUIRE_FALSE(result.is_err());
+
+        result = Result<std::string, ThrowOnMove>{Ok<std::string>{"again"}};
+        REQUIRE(result.result() == "again");
+    }
+}
+
+// Counts how it was constructed, copied and moved
+struct Tracked {
+    Tracked(int a, int b) : value(a + b) { ++constructions; }
+    Tracked(const Tracked& o) : value(o.value) { ++copies; }
+    Tracked(Tracked&& o) noexcept : value(o.value) { ++moves; }
+
+    static void reset() { constructions = copies = moves = 0; }
+
+    int value;
+
+    static inline int constructions = 0;
+    static inline int copies        = 0;
+    static inline int moves         = 0;
+};
+
+struct Pinned {
+    explicit Pinned(int v) : value(v) {}
+    Pinned(const Pinned&) = delete;
+    Pinned(Pinned&&)      = delete;
+
+    int value;
+};
+
+Result<Tracked, Tracked> make_tracked(bool ok) {
+    if (ok) {
+        return EmplaceOk{1, 2};
+    }
+    return EmplaceErr{3, 4};
+}
+
+Result<Pinned, std::string> make_pinned(bool ok) {
+    if (ok) {
+        return EmplaceOk{5};
+    }
+    return EmplaceErr{3u, 'e'};
+}
+
+TEST_CASE("Result In Place Construction", "[result]") {
+    SECTION("in_place_ok and in_place_err") {
+        constexpr Result<int, int> ok{in_place_ok, 1};
+        STATIC_REQUIRE(ok.result() == 1);
+        constexpr Result<int, int> err{in_place_err, 2};
+        STATIC_REQUIRE(err.error() == 2);
+
+        const Result<std::string, std::string> str{in_place_ok, 3u, 'a'};
+        REQUIRE(str.result() == "aaa");
+        const Result<std::string, std::string> str_err{in_place_err, "err"};
+        REQUIRE(str_err.error() == "err");
+    }
+    SECTION("Result<void, E>") {
+        const Result<void, int> ok{in_place_ok};
+        REQUIRE(ok.is_ok());
+        const Result<void, int> err{in_place_err, 4};
+        REQUIRE(err.error() == 4);
+
+        const Result<void, std::string> ok_str = EmplaceOk{};
+        REQUIRE(ok_str.is_ok());
+        const Result<void, std::string> err_str = EmplaceErr{2u, 'b'};
+        REQUIRE(err_str.error() == "bb");
+    }
+    SECTION("Niche storage") {
+        using cogle::utils::niche::Errno;
+
+        constexpr Result<int, Errno> ok = EmplaceOk{5};
+        STATIC_REQUIRE(ok.result() == 5);
+        constexpr Result<int, Errno> err = EmplaceErr{Errno{EINVAL}};
+        STATIC_REQUIRE(err.error() == Errno{EINVAL});
+    }
+    SECTION("One construction on the return path") {
+        Tracked::reset();
+        const auto ok = make_tracked(true);
+        REQUIRE(ok.result().value == 3);
+        REQUIRE(Tracked::constructions == 1);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+
+        Tracked::reset();
+        const auto err = make_tracked(false);
+        REQUIRE(err.error().value == 7);
+        REQUIRE(Tracked::constructions == 1);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+    }
+    SECTION("Non movable payload") {
+        REQUIRE(make_pinned(true).result().value == 5);
+        REQUIRE(make_pinned(false).error() == "eee");
+    }
+    SECTION("Arguments are forwarded") {
+        std::string lvalue{"copied"};
+        const Result<std::string, int> copied = EmplaceOk{lvalue};
+        REQUIRE(lvalue == "copied");
+        REQUIRE(copied.result() == "copied");
+
+        const Result<std::string, int> moved = EmplaceOk{std::move(lvalue)};
+        REQUIRE(moved.result() == "copied");
+
+        auto owned                                            = std::make_unique<int>(6);
+        const Result<std::unique_ptr<int>, std::string> unique = EmplaceOk{std::move(owned)};
+        REQUIRE(*unique.result() == 6);
+        REQUIRE(owned == nullptr);
+    }
+}
+
+int add_one(const int& v) { return v + 1; }
+
+// Overloaded functor accepted by both branches of a match
+struct Describe {
+    std::string operator()(const std::string& v) const { return "ok " + v; }
+    std::string operator()(int e) const { return "err " + std::to_string(e); }
+};
+
+TEST_CASE("Result Reference Taking Callables", "[result]") {
+    SECTION("Observing an lvalue does not copy the payload") {
+        Result<Tracked, Tracked> result{in_place_ok, 1, 2};
+        Tracked::reset();
+
+        const auto mapped = result.map([](const Tracked& t) { return t.value; });
+        REQUIRE(mapped.result() == 3);
+        const auto chained = result.and_then([](const Tracked& t) { return Result<int, Tracked>{Ok<int>{t.value}}; });
+        REQUIRE(chained.result() == 3);
+        const auto matched = result.match([](const Tracked& t) { return t.value; }, [](const Tracked&) { return -1; });
+        REQUIRE(matched == 3);
+
+        const auto& const_result = result;
+        REQUIRE(const_result.map([](const Tracked& t) { return t.value; }).result() == 3);
+
+        Result<Tracked, Tracked> err{in_place_err, 2, 2};
+        REQUIRE(err.match([](const Tracked&) { return -1; }, [](const Tracked& t) { return t.value; }) == 4);
+
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+    }
+    SECTION("Mutable references") {
+        Result<std::string, int> result{Ok<std::string>{"abc"}};
+        const auto size = result.map([](std::string& v) {
+            v += "d";
+            return v.size();
+        });
+        REQUIRE(size.result() == 4);
+        REQUIRE(result.result() == "abcd");
+
+        result >> [](std::string& v) { v.clear(); };
+        REQUIRE(result.result().empty());
+    }
+    SECTION("Rvalue references move the payload out") {
+        Result<std::unique_ptr<int>, int> result{Ok<std::unique_ptr<int>>{std::make_unique<int>(5)}};
+        auto moved = std::move(result).map([](std::unique_ptr<int>&& v) { return std::move(v); });
+        REQUIRE(*moved.result() == 5);
+
+        Result<std::string, std::string> err{Err<std::string>{"err"}};
+        const auto taken = std::move(err).match([](std::string&&) { return std::string{}; },
+                                                [](std::string&& e) { return std::move(e); });
+        REQUIRE(taken == "err");
+    }
+    SECTION("Generic lambdas") {
+        const Result<std::string, int> result{Ok<std::string>{"abc"}};
+        REQUIRE(result.map([](const auto& v) { return v.size(); }).result() == 3);
+        REQUIRE(result.match([](auto&& v) { return v.size(); }, [](auto) { return std::size_t{0}; }) == 3);
+
+        const Result<void, int> void_result{Err<int>{2}};
+        REQUIRE(void_result.match([]() { return 0; }, [](const auto& e) { return e; }) == 2);
+    }
+    SECTION("Function pointers and overloaded functors") {
+        const Result<int, int> result{Ok<int>{1}};
+        REQUIRE(result.map(add_one).result() == 2);
+        REQUIRE(result.map(&add_one).result() == 2);
+
+        const Result<std::string, int> ok{Ok<std::string>{"value"}};
+        const Result<std::string, int> err{Err<int>{3}};
+        REQUIRE(ok.match(Describe{}, Describe{}) == "ok value");
+        REQUIRE(err.match(Describe{}, Describe{}) == "err 3");
+    }
+    SECTION("Niche storage passes decoded values") {
+        using cogle::utils::niche::Errno;
+
+        constexpr Result<int, Errno> result{Ok<int>{4}};
+        STATIC_REQUIRE(result.map([](const int& v) { return v * 2; }).result() == 8);
+        STATIC_REQUIRE(result.match([](const auto& v) { return v; }, [](const Errno& e) { return -e.value; }) == 4);
+    }
+}
+
+struct NotFound {};
+
+struct Entry {
+    std::string name;
+    int values[32];
+};
+
+TEST_CASE("Result Reference Payloads", "[result]") {
+    std::vector<Entry> entries{Entry{"first", {1}}, Entry{"second", {2}}};
+
+    const auto find = [&entries](const std::string& name) -> Result<Entry&, std::string> {
+        for (auto& entry : entries) {
+            if (entry.name == name) {
+                return Ok<Entry&>{entry};
+            }
+        }
+        return Err<std::string>{"missing " + name};
+    };
+
+    SECTION("The referent is not copied") {
+        auto found = find("second");
+        REQUIRE(found.is_ok());
+        REQUIRE(&found.result() == &entries[1]);
+        REQUIRE(&*found == &entries[1]);
+        REQUIRE(&std::move(found).result() == &entries[1]);
+
+        found.result().values[0] = 20;
+        REQUIRE(entries[1].values[0] == 20);
+
+        REQUIRE(find("third").error() == "missing third");
+    }
+    SECTION("Combinators receive the reference") {
+        const auto name = find("first").map([](Entry& entry) { return entry.name; });
+        REQUIRE(name.result() == "first");
+
+        auto value = find("first").map([](Entry& entry) -> int& { return entry.values[0]; });
+        value.result() = 10;
+        REQUIRE(entries[0].values[0] == 10);
+
+        const auto chained = find("first").and_then([](const Entry& entry) {
+            return Result<const std::string&, std::string>{Ok<const std::string&>{entry.name}};
+        });
+        REQUIRE(&chained.result() == &entries[0].name);
+
+        const auto matched = find("none").match([](const Entry&) { return 0; }, [](const std::string&) { return 1; });
+        REQUIRE(matched == 1);
+    }
+    SECTION("Null pointer niche") {
+        const Entry& entry = entries[0];
+        constexpr auto lookup = [](const Entry* e) -> Result<const Entry&, NotFound> {
+            if (e == nullptr) {
+                return Err<NotFound>{NotFound{}};
+            }
+            return EmplaceOk{*e};
+        };
+
+        REQUIRE(&lookup(&entry).result() == &entry);
+        REQUIRE(lookup(nullptr).is_err());
+    }
+    SECTION("Temporaries are not bound in place") {
+        using Ref = Result<const std::string&, int>;
+
+        STATIC_REQUIRE(std::is_constructible_v<Ref, in_place_ok_t, const std::string&>);
+        STATIC_REQUIRE(std::is_constructible_v<Ref, in_place_ok_t, std::string&>);
+        STATIC_REQUIRE_FALSE(std::is_constructible_v<Ref, in_place_ok_t, std::string>);
+        STATIC_REQUIRE_FALSE(std::is_constructible_v<Ref, in_place_ok_t, const char (&)[8]>);
+        STATIC_REQUIRE_FALSE(std::is_constructible_v<Ref, EmplaceOk<const char (&)[8]>>);
+        STATIC_REQUIRE_FALSE(std::is_constructible_v<Ref, EmplaceOk<std::string>>);
+        STATIC_REQUIRE(std::is_constructible_v<Ref, EmplaceOk<std::string&>>);
+    }
+    SECTION("Copies share the referent") {
+        const auto found = find("first");
+        auto copy        = found;
+        copy.result().name += "!";
+        REQUIRE(found.result().name == "first!");
+
+        Result<Entry&, std::string> other{in_place_ok, entries[1]};
+        other = found;
+        REQUIRE(&other.result() == &entries[0]);
+        REQUIRE(entries[1].name == "second");
+    }
+    SECTION("Ok<R&> compares the referents") {
+        const std::string a{"value"};
+        const std::string b{"value"};
+        REQUIRE(Ok<const std::string&>{a} == Ok<const std::string&>{b});
+        REQUIRE(Ok<const std::string&>{a} == Ok<std::string>{"value"});
+        REQUIRE(Ok<const std::string&>{a} != Ok<std::string>{"other"});
+        REQUIRE(Ok<std::string>{"value"} == Ok<const std::string&>{b});
+    }
+}
+
+TEST_CASE("Result Error Side Combinators", "[result]") {
+    SECTION("map_err(...)") {
+        Result<int, int> err{Err{2}};
+        const auto mapped = err.map_err([](int e) { return std::to_string(e * 10); });
+        STATIC_REQUIRE(std::is_same_v<decltype(mapped), const Result<int, std::string>>);
+        REQUIRE(mapped.error() == "20");
+
+        Result<void, int> ok{Ok<void>{}};
+        REQUIRE(ok.map_err([](int) { return 'x'; }).is_ok());
+
+        constexpr auto constant = Result<int, int>{Ok{4}}.map_err([](int e) { return e + 1L; });
+        STATIC_REQUIRE(constant.result() == 4);
+    }
+    SECTION("or_else(...)") {
+        auto recover = [](const std::string& e) -> Result<int, int> {
+            if (e == "missing") {
+                return Ok{0};
+            }
+            return Err{static_cast<int>(e.size())};
+        };
+
+        Result<int, std::string> missing{Err<std::string>{"missing"}};
+        REQUIRE(missing.or_else(recover).result() == 0);
+
+        Result<int, std::string> broken{Err<std::string>{"broken"}};
+        REQUIRE(broken.or_else(recover).error() == 6);
+
+        Result<int, std::string> ok{Ok{3}};
+        REQUIRE(ok.or_else(recover).result() == 3);
+    }
+    SECTION("unwrap_or(...) and value_or(...)") {
+        const Result<std::string, int> ok{Ok<std::string>{"value"}};
+        const Result<std::string, int> err{Err{1}};
+
+        REQUIRE(ok.unwrap_or("fallback") == "value");
+        REQUIRE(err.unwrap_or("fallback") == "fallback");
+        REQUIRE(ok.value_or("fallback") == "value");
+        REQUIRE(err.value_or("fallback") == "fallback");
+
+        STATIC_REQUIRE(Result<int, int>{Err{1}}.unwrap_or(7) == 7);
+    }
+    SECTION("unwrap_or_else(...) is lazy") {
+        int calls = 0;
+        auto fallback = [&calls](int e) {
+            ++calls;
+            return std::to_string(e);
+        };
+
+        Result<std::string, int> ok{Ok<std::string>{"value"}};
+        REQUIRE(ok.unwrap_or_else(fallback) == "value");
+        REQUIRE(calls == 0);
+
+        Result<std::string, int> err{Err{5}};
+        REQUIRE(err.unwrap_or_else(fallback) == "5");
+        REQUIRE(calls == 1);
+
+        REQUIRE(err.unwrap_or_else([]() { return std::string{"none"}; }) == "none");
+    }
+    SECTION("Rvalues move the payload out") {
+        Result<Tracked, int> ok{in_place_ok, 1, 2};
+        Tracked::reset();
+        REQUIRE(std::move(ok).unwrap_or(Tracked{0, 0}).value == 3);
+        REQUIRE(Tracked::copies == 0);
+
+        Result<Tracked, int> ok_else{in_place_ok, 1, 2};
+        Tracked::reset();
+        REQUIRE(std::move(ok_else).unwrap_or_else([](int) { return Tracked{0, 0}; }).value == 3);
+        REQUIRE(Tracked::constructions == 0);
+        REQUIRE(Tracked::copies == 0);
+
+        Result<Tracked, int> ok_map{in_place_ok, 1, 2};
+        Tracked::reset();
+        REQUIRE(std::move(ok_map).map_err([](int e) { return e; }).result().value == 3);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 1);
+
+        Result<int, Tracked> err{in_place_err, 3, 4};
+        Tracked::reset();
+        REQUIRE(std::move(err).map_err([](Tracked&& e) { return std::move(e); }).error().value == 7);
+        REQUIRE(Tracked::copies == 0);
+
+        Result<int, Tracked> recovered{in_place_err, 3, 4};
+        Tracked::reset();
+        REQUIRE(std::move(recovered).or_else([](Tracked&& e) { return Result<int, Tracked>{Ok{e.value}}; }).result() ==
+                7);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+    }
+    SECTION("Lvalues copy the payload") {
+        const Result<Tracked, int> ok{in_place_ok, 1, 2};
+        Tracked::reset();
+        REQUIRE(ok.value_or(Tracked{0, 0}).value == 3);
+        REQUIRE(Tracked::copies == 1);
+    }
+}
+
+}  // namespace
\ No newline at end of file
@@ -109,7 +109,8 @@ TEST_CASE("ResultStorage Trivial Destruction [result][ResultStorage]") {
         detail::ResultStorage<char, int> storage{ok};
         detail::ResultStorage<char, int> storage_mv{std::move(storage)};
 
-        REQUIRE(storage.get_tag() == detail::ResultTag::INVALID);
+        // Trivially copyable storage is left untouched when moved from
+        REQUIRE(storage.get_tag() == detail::ResultTag::OK);
 
         REQUIRE(storage_mv.get_tag() == detail::ResultTag::OK);
         REQUIRE(storage_mv.get_result() == test_char_a);
@@ -122,7 +123,8 @@ TEST_CASE("ResultStorage Trivial Destruction [result][ResultStorage]") {
         detail::ResultStorage<char, int> storage{err};
         detail::ResultStorage<char, int> storage_mv{std::move(storage)};
 
-        REQUIRE(storage.get_tag() == detail::ResultTag::INVALID);
+        // Trivially copyable storage is left untouched when moved from
+        REQUIRE(storage.get_tag() == detail::ResultTag::ERR);
 
         REQUIRE(storage_mv.get_tag() == detail::ResultTag::ERR);
         REQUIRE(storage_mv.get_error() == test_int);
@@ -195,7 +197,8 @@ TEST_CASE("ResultStorage Trivial Destruction [result][ResultStorage]") {
 
         storage_b = std::move(storage_a);
 
-        REQUIRE(storage_a.get_tag() == detail::ResultTag::INVALID);
+        // Trivially copyable storage is left untouched when moved from
+        REQUIRE(storage_a.get_tag() == detail::ResultTag::OK);
 
         REQUIRE(storage_b.get_tag() == detail::ResultTag::OK);
         REQUIRE(storage_b.get_result() == test_char_a);
@@ -218,7 +221,8 @@ TEST_CASE("ResultStorage Trivial Destruction [result][ResultStorage]") {
 
         storage_200 = std::move(storage_100);
 
-        REQUIRE(storage_100.get_tag() == detail::ResultTag::INVALID);
+        // Trivially copyable storage is left untouched when moved from
+        REQUIRE(storage_100.get_tag() == detail::ResultTag::ERR);
 
         REQUIRE(storage_200.get_tag() == detail::ResultTag::ERR);
         REQUIRE(storage_200.get_error() == test_int_100);
@@ -838,7 +842,8 @@ TEST_CASE("ResultStorage Trivial Destruction [result][ResultStorage] void Result
         detail::ResultStorage<void, int> storage{ok};
         detail::ResultStorage<void, int> storage_mv{std::move(storage)};
 
-        REQUIRE(storage.get_tag() == detail::ResultTag::INVALID);
+        // Trivially copyable storage is left untouched when moved from
+        REQUIRE(storage.get_tag() == detail::ResultTag::OK);
 
         REQUIRE(storage_mv.get_tag() == detail::ResultTag::OK);
     }
@@ -850,7 +855,8 @@ TEST_CASE("ResultStorage Trivial Destruction [result][ResultStorage] void Result
         detail::ResultStorage<char, int> storage{err};
         detail::ResultStorage<char, int> storage_mv{std::move(storage)};
 
-        REQUIRE(storage.get_tag() == detail::ResultTag::INVALID);
+        // Trivially copyable storage is left untouched when moved from
+        REQUIRE(storage.get_tag() == detail::ResultTag::ERR);
 
         REQUIRE(storage_mv.get_tag() == detail::ResultTag::ERR);
         REQUIRE(storage_mv.get_error() == test_int);
@@ -912,7 +918,8 @@ TEST_CASE("ResultStorage Trivial Destruction [result][ResultStorage] void Result
 
         storage_bar = std::move(storage_foo);
 
-        REQUIRE(storage_foo.get_tag() == detail::ResultTag::INVALID);
+        // Trivially copyable storage is left untouched when moved from
+        REQUIRE(storage_foo.get_tag() == detail::ResultTag::OK);
         REQUIRE(storage_bar.get_tag() == detail::ResultTag::OK);
     }
     SECTION("ResultStorage<void, int> move assignment operator construction [Err]") {
@@ -931,7 +938,8 @@ TEST_CASE("ResultStorage Trivial Destruction [result][ResultStorage] void Result
 
         storage_bar = std::move(storage_foo);
 
-        REQUIRE(storage_foo.get_tag() == detail::ResultTag::INVALID);
+        // Trivially copyable storage is left untouched when moved from
+        REQUIRE(storage_foo.get_tag() == detail::ResultTag::ERR);
         REQUIRE(storage_bar.get_tag() == detail::ResultTag::ERR);
     }
 }
@@ -0,0 +1,200 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/result.hxx"
+#include "utils/result_vector.hxx"
+
+namespace {
+
+using namespace cogle::utils::result;
+namespace bitmap = cogle::utils::result::detail::bitmap;
+
+// Deterministic pattern with runs of results and scattered errors
+bool fails(const std::size_t i) { return (i * 2654435761u) % 97 < 3 || (i >= 300 && i < 340); }
+
+ResultVector<int, std::string> make(const std::size_t n) {
+    ResultVector<int, std::string> vector;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (fails(i)) {
+            vector.emplace_err("error " + std::to_string(i));
+        } else {
+            vector.emplace_ok(static_cast<int>(i));
+        }
+    }
+    return vector;
+}
+
+TEST_CASE("Result Vector Access", "[result_vector]") {
+    auto vector = make(1000);
+
+    REQUIRE(vector.size() == 1000);
+    for (std::size_t i = 0; i < vector.size(); ++i) {
+        const auto element = vector[i];
+        REQUIRE(element.index() == i);
+        REQUIRE(element.is_err() == fails(i));
+        if (fails(i)) {
+            REQUIRE(element.error() == "error " + std::to_string(i));
+        } else {
+            REQUIRE(element.result() == static_cast<int>(i));
+        }
+    }
+
+    SECTION("Views convert to Result") {
+        const Result<int, std::string> ok = vector[1];
+        REQUIRE(ok.result() == 1);
+
+        const std::size_t err_idx       = vector.first_err();
+        const Result<int, std::string> err = vector[err_idx];
+        REQUIRE(err.error() == "error " + std::to_string(err_idx));
+    }
+    SECTION("Views modify the payloads") {
+        vector[1].result() = 100;
+        REQUIRE(vector[1].result() == 100);
+        REQUIRE(vector[1].match([](int v) { return v; }, [](const std::string&) { return -1; }) == 100);
+    }
+    SECTION("Iteration visits every element") {
+        std::size_t idx = 0;
+        for (const auto element : vector) {
+            REQUIRE(element.is_ok() == !fails(idx));
+            ++idx;
+        }
+        REQUIRE(idx == vector.size());
+    }
+    SECTION("push_back splits the Result") {
+        ResultVector<int, std::string> other;
+        other.push_back(Result<int, std::string>{Ok{1}});
+        other.push_back(Result<int, std::string>{Err<std::string>{"e"}});
+        REQUIRE(other.count_ok() == 1);
+        REQUIRE(other.count_err() == 1);
+        REQUIRE(other.ok_data()[0] == 1);
+        REQUIRE(other.err_data()[0] == "e");
+    }
+}
+
+TEST_CASE("Result Vector Scans", "[result_vector]") {
+    for (const std::size_t n : {0, 1, 63, 64, 65, 127, 128, 129, 255, 256, 700, 1000}) {
+        const auto vector = make(n);
+
+        std::size_t errs = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            errs += fails(i) ? 1 : 0;
+        }
+        REQUIRE(vector.count_err() == errs);
+        REQUIRE(vector.count_ok() == n - errs);
+        REQUIRE(vector.count_err(0, n) == errs);
+
+        for (const std::size_t first : {std::size_t{0}, std::size_t{1}, std::size_t{63}, std::size_t{64}, n / 3}) {
+            for (const std::size_t last : {first, first + 1, first + 64, first + 200, n}) {
+                std::size_t expected = 0;
+                for (std::size_t i = first; i < std::min(last, n); ++i) {
+                    expected += fails(i) ? 1 : 0;
+                }
+                REQUIRE(vector.count_err(first, last) == expected);
+                REQUIRE(vector.count_ok(first, last) == (first < std::min(last, n) ? std::min(last, n) - first : 0) -
+                                                             expected);
+            }
+
+            std::size_t next_err = ResultVector<int, std::string>::npos;
+            std::size_t next_ok  = ResultVector<int, std::string>::npos;
+            for (std::size_t i = n; i-- > first;) {
+                (fails(i) ? next_err : next_ok) = i;
+            }
+            REQUIRE(vector.first_err(first) == next_err);
+            REQUIRE(vector.first_ok(first) == next_ok);
+        }
+
+        std::vector<std::size_t> err_indices;
+        vector.for_each_err([&](std::size_t idx, const std::string& error) {
+            REQUIRE(error == "error " + std::to_string(idx));
+            err_indices.push_back(idx);
+        });
+        std::size_t oks = 0;
+        vector.for_each_ok([&](std::size_t idx, int value) {
+            REQUIRE(value == static_cast<int>(idx));
+            ++oks;
+        });
+        REQUIRE(err_indices.size() == errs);
+        REQUIRE(oks == n - errs);
+    }
+}
+
+TEST_CASE("Result Vector Bitmap Kernels", "[result_vector]") {
+    std::vector<std::uint64_t> words(37);
+    std::uint64_t state = 0x9E3779B97F4A7C15u;
+    for (auto& word : words) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        word = state;
+    }
+
+    for (std::size_t n = 0; n <= words.size(); ++n) {
+        REQUIRE(bitmap::count(words.data(), n) == bitmap::count_scalar(words.data(), n));
+    }
+
+    std::vector<std::uint64_t> sparse(37, 0);
+    std::vector<std::uint64_t> dense(37, ~std::uint64_t{0});
+    for (std::size_t hit = 0; hit < sparse.size(); ++hit) {
+        sparse[hit] = 1;
+        dense[hit]  = 0;
+        for (std::size_t n = 0; n <= sparse.size(); ++n) {
+            REQUIRE(bitmap::find(sparse.data(), n, 0) == bitmap::find_scalar(sparse.data(), n, 0));
+            REQUIRE(bitmap::find(dense.data(), n, ~std::uint64_t{0}) ==
+                    bitmap::find_scalar(dense.data(), n, ~std::uint64_t{0}));
+        }
+        sparse[hit] = 0;
+        dense[hit]  = ~std::uint64_t{0};
+    }
+}
+
+TEST_CASE("Result Vector Payloads", "[result_vector]") {
+    SECTION("Void results") {
+        ResultVector<void, int> vector;
+        for (int i = 0; i < 130; ++i) {
+            if (i % 10 == 0) {
+                vector.emplace_err(i);
+            } else {
+                vector.emplace_ok();
+            }
+        }
+
+        REQUIRE(vector.count_err() == 13);
+        REQUIRE(vector[10].error() == 10);
+        REQUIRE(vector[11].is_ok());
+
+        std::size_t oks = 0;
+        vector.for_each_ok([&](std::size_t) { ++oks; });
+        REQUIRE(oks == 117);
+
+        const Result<void, int> converted = vector[20];
+        REQUIRE(converted.error() == 20);
+    }
+    SECTION("Move only payloads") {
+        ResultVector<std::unique_ptr<int>, std::string> vector;
+        vector.reserve(100, 10);
+        for (int i = 0; i < 100; ++i) {
+            vector.emplace_ok(std::make_unique<int>(i));
+        }
+        vector.push_back(Result<std::unique_ptr<int>, std::string>{Ok{std::make_unique<int>(100)}});
+
+        REQUIRE(*vector[100].result() == 100);
+        REQUIRE(vector.first_err() == decltype(vector)::npos);
+    }
+    SECTION("Moves leave an empty vector") {
+        auto vector = make(200);
+        auto moved  = std::move(vector);
+
+        REQUIRE(moved.size() == 200);
+        REQUIRE(vector.size() == 0);
+        REQUIRE(vector.first_err() == decltype(vector)::npos);
+
+        vector.emplace_err("again");
+        REQUIRE(vector.first_err() == 0);
+    }
+}
+
+}  // namespace
\ No newline at end of file
@@ -35,14 +35,18 @@ TEST_CASE("SourceLocation Tests [SourceLocation]") {
         auto current = SourceLocation::current();
 
         REQUIRE(current.line() == line);
-        REQUIRE(current.column() == 0);
+        if constexpr (detail::HAS_BUILTIN_COLUMN) {
+            REQUIRE(current.column() > 0);
+        } else {
+            REQUIRE(current.column() == 0);
+        }
 
         // TODO not having string here fails in Catch2 only on clang
         REQUIRE(std::string(current.file_name()) == std::string(file));
         REQUIRE(std::string(current.function_name()) == std::string(func));
 
         std::ostringstream expected_os{};
-        expected_os << "File: " << file << "\tFunc: " << func << "\tLine: " << line << "\tCol: " << 0;
+        expected_os << "File: " << file << "\tFunc: " << func << "\tLine: " << line << "\tCol: " << current.column();
 
         std::ostringstream out{};
         out << current;
@@ -51,4 +55,46 @@ TEST_CASE("SourceLocation Tests [SourceLocation]") {
     }
 }
 
+
+TEST_CASE("SourceLocation Records [SourceLocation]") {
+    SECTION("SourceLocation hash and equality") {
+        constexpr auto first  = SourceLocation::current("file.cpp", "func", 10, 2);
+        constexpr auto same   = SourceLocation::current("file.cpp", "func", 10, 2);
+        constexpr auto column = SourceLocation::current("file.cpp", "func", 10, 3);
+        constexpr auto file   = SourceLocation::current("other.cpp", "func", 10, 2);
+
+        STATIC_REQUIRE(first == same);
+        STATIC_REQUIRE(first.hash() == same.hash());
+        STATIC_REQUIRE(first != column);
+        STATIC_REQUIRE(first.hash() != column.hash());
+        STATIC_REQUIRE(first != file);
+        STATIC_REQUIRE(first.hash() != file.hash());
+    }
+
+    SECTION("Equal locations with distinct strings hash equally") {
+        const std::string file_name{"file.cpp"};
+        const std::string func_name{"func"};
+        const auto copy = SourceLocation::current(file_name.c_str(), func_name.c_str(), 10, 2);
+
+        REQUIRE(copy == SourceLocation::current("file.cpp", "func", 10, 2));
+        REQUIRE(copy.hash() == SourceLocation::current("file.cpp", "func", 10, 2).hash());
+    }
+
+    SECTION("COGLE_CURRENT_LOCATION() static records") {
+        auto site = []() { return COGLE_CURRENT_LOCATION(); };
+
+        const SourceLocation* first  = site();
+        const SourceLocation* second = site();
+        auto line                    = __builtin_LINE() + 1;  // If you move this line you better move the macro
+        const SourceLocation* other  = COGLE_CURRENT_LOCATION();
+
+        // Every call site owns exactly one record
+        REQUIRE(first == second);
+        REQUIRE(first != other);
+        REQUIRE(other->line() == line);
+        REQUIRE(std::string(other->file_name()) == std::string(__builtin_FILE()));
+        REQUIRE(std::string(other->function_name()) == std::string(__func__));
+    }
+}
+
 }  // namespace
\ No newline at end of file
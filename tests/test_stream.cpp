@@ -0,0 +1,177 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/result.hxx"
+#include "utils/stream.hxx"
+
+namespace {
+
+using namespace cogle::utils::result;
+using namespace cogle::utils::stream;
+
+template <typename R>
+Result<R, std::string> ok(R value) {
+    return Result<R, std::string>{in_place_ok, std::move(value)};
+}
+
+Result<void, std::string> done() { return Result<void, std::string>{in_place_ok}; }
+
+Result<int, std::string> fail_on(const int value, const int bad) {
+    if (value % bad == 0) {
+        return Result<int, std::string>{in_place_err, std::to_string(value)};
+    }
+    return ok(value);
+}
+
+TEST_CASE("Stream Stages", "[stream]") {
+    SECTION("Items Keep Their Order") {
+        std::vector<std::size_t> sizes;
+        auto stream = make_stream<int>(
+            StreamOptions{}, [](const int value) { return ok(value * 2); },
+            [](const int value) { return ok(std::to_string(value)); },
+            [&sizes](const std::string& text) {
+                sizes.push_back(text.size());
+                return done();
+            });
+        REQUIRE(stream.size() == 3);
+
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(stream.push(i));
+        }
+        REQUIRE(stream.finish().is_ok());
+
+        REQUIRE(sizes.size() == 1000);
+        REQUIRE(sizes[0] == 1);
+        REQUIRE(sizes[5] == 2);
+        REQUIRE(sizes[50] == 3);
+        REQUIRE(sizes[999] == 4);
+        for (std::size_t stage = 0; stage < stream.size(); ++stage) {
+            REQUIRE(stream.counters(stage).received == 1000);
+            REQUIRE(stream.counters(stage).produced == 1000);
+            REQUIRE(stream.counters(stage).failed == 0);
+            REQUIRE(stream.counters(stage).queued == 0);
+        }
+    }
+
+    SECTION("Small Rings Hold Back The Producer") {
+        StreamOptions options;
+        options.capacity = 4;
+        options.batch    = 3;
+
+        long sum = 0;
+        auto stream =
+            make_stream<long>(options, [](const long value) { return ok(value + 1); },
+                              [&sum](const long value) {
+                                  sum += value;
+                                  return done();
+                              });
+
+        std::vector<long> batch;
+        for (long i = 0; i < 100000; i += 10) {
+            for (long j = i; j < i + 10; ++j) {
+                batch.push_back(j);
+            }
+            REQUIRE(stream.push_batch(batch));
+            REQUIRE(batch.empty());
+            REQUIRE(stream.counters(1).queued <= 4);
+        }
+        REQUIRE(stream.finish().is_ok());
+        REQUIRE(sum == 100000L * 100001 / 2);
+        REQUIRE(stream.counters(0).batches >= 100000 / 3);
+    }
+
+    SECTION("Destruction Without Finish") {
+        std::vector<int> seen;
+        {
+            auto stream = make_stream<int>(StreamOptions{}, [&seen](const int value) {
+                seen.push_back(value);
+                return done();
+            });
+            for (int i = 0; i < 100; ++i) {
+                REQUIRE(stream.push(i));
+            }
+        }
+        REQUIRE(seen.size() <= 100);
+    }
+}
+
+TEST_CASE("Stream Errors", "[stream]") {
+    SECTION("Stop") {
+        StreamOptions options;
+        options.capacity = 16;
+
+        std::vector<int> written;
+        auto stream = make_stream<int>(
+            options, [](const int value) { return ok(value); },
+            [](const int value) { return fail_on(value + 1, 500); },
+            [&written](const int value) {
+                written.push_back(value);
+                return done();
+            });
+
+        int pushed = 0;
+        while (pushed < 100000 && stream.push(pushed)) {
+            ++pushed;
+        }
+        // The stream stops long before its input, the rings only hold a few items
+        REQUIRE(pushed < 100000);
+
+        auto result = stream.finish();
+        REQUIRE(result.is_err());
+        REQUIRE(result.error().stage == 1);
+        REQUIRE(result.error().error == "500");
+        // Items after the failing one are not counted, even those popped in the same batch. The outputs of that batch
+        // are dropped, only what reached the last stage counts as produced.
+        REQUIRE(stream.counters(1).received == 500);
+        REQUIRE(stream.counters(1).produced <= 499);
+        REQUIRE(stream.counters(1).failed == 1);
+        REQUIRE(stream.counters(2).received + stream.counters(2).queued == stream.counters(1).produced);
+        REQUIRE(written.size() == stream.counters(2).produced);
+        REQUIRE(written.size() <= 498);
+        for (std::size_t i = 0; i < written.size(); ++i) {
+            REQUIRE(written[i] == static_cast<int>(i) + 1);
+        }
+    }
+
+    SECTION("Route") {
+        StreamOptions options;
+        options.on_error = OnError::Route;
+
+        std::vector<int> written;
+        auto stream = make_stream<int>(
+            options, [](const int value) { return fail_on(value, 3); },
+            [](const int value) { return fail_on(value, 5); },
+            [&written](const int value) {
+                written.push_back(value);
+                return done();
+            });
+
+        std::vector<int> batch;
+        for (int i = 1; i <= 150; ++i) {
+            batch.push_back(i);
+        }
+        REQUIRE(stream.push_batch(batch));
+        REQUIRE(stream.finish().is_ok());
+
+        // 50 multiples of 3, 30 of 5 of which 10 are multiples of 3 too
+        REQUIRE(written.size() == 80);
+        REQUIRE(stream.counters(0).failed == 50);
+        REQUIRE(stream.counters(1).received == 100);
+        REQUIRE(stream.counters(1).failed == 20);
+
+        auto errors = stream.take_errors();
+        REQUIRE(errors.size() == 70);
+        std::size_t first = 0;
+        for (const auto& error : errors) {
+            const int value = std::stoi(error.error);
+            REQUIRE(value % (error.stage == 0 ? 3 : 5) == 0);
+            first += error.stage == 0;
+        }
+        REQUIRE(first == 50);
+        REQUIRE(stream.take_errors().empty());
+    }
+}
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include <memory>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+#include "utils/result.hxx"
+#include "utils/try.hxx"
+
+namespace {
+
+using namespace cogle::utils::result;
+
+// Counts how often it is moved or copied
+struct Counted {
+    explicit Counted(int v) : value(v) {}
+    Counted(const Counted& o) : value(o.value) { ++copies; }
+    Counted(Counted&& o) noexcept : value(o.value) { ++moves; }
+
+    static void reset() { copies = moves = 0; }
+
+    int value;
+
+    static inline int copies = 0;
+    static inline int moves  = 0;
+};
+
+Result<Counted, Counted> make(bool ok) {
+    if (ok) {
+        return Result<Counted, Counted>{in_place_ok, 1};
+    }
+    return Result<Counted, Counted>{in_place_err, 2};
+}
+
+Result<std::unique_ptr<int>, std::string> allocate(bool ok) {
+    if (ok) {
+        return Ok{std::make_unique<int>(4)};
+    }
+    return Err<std::string>{"allocate"};
+}
+
+Result<void, std::string> check(bool ok) {
+    if (ok) {
+        return Ok<void>{};
+    }
+    return Err<std::string>{"check"};
+}
+
+Result<int, Counted> assign_counted(bool ok) {
+    COGLE_TRY_ASSIGN(Counted counted, make(ok));
+    return Ok{counted.value};
+}
+
+Result<int, Counted> assign_borrowed(const Result<Counted, Counted>& source) {
+    COGLE_TRY_ASSIGN(Counted counted, source);
+    return Ok{counted.value};
+}
+
+Result<int, std::string> assign_chain(bool allocated, bool checked) {
+    COGLE_TRY_ASSIGN(std::unique_ptr<int> value, allocate(allocated));
+    COGLE_TRY(check(checked));
+    return Ok{*value};
+}
+
+Result<long, std::string> assign_converted(bool ok) {
+    // Only the error type has to be convertible, the result type of the enclosing function is unrelated
+    int target = 0;
+    COGLE_TRY_ASSIGN(target, Result<int, const char*>{ok ? Result<int, const char*>{Ok{3}}
+                                                         : Result<int, const char*>{Err<const char*>{"converted"}}});
+    return Ok{static_cast<long>(target)};
+}
+
+TEST_CASE("Try Assign", "[try]") {
+    SECTION("Ok moves the result out once") {
+        Counted::reset();
+        REQUIRE(assign_counted(true).result() == 1);
+        REQUIRE(Counted::moves == 1);
+        REQUIRE(Counted::copies == 0);
+    }
+    SECTION("Err moves the error out once") {
+        Counted::reset();
+        REQUIRE(assign_counted(false).error().value == 2);
+        REQUIRE(Counted::moves == 1);
+        REQUIRE(Counted::copies == 0);
+    }
+    SECTION("Lvalue Results are copied from") {
+        const Result<Counted, Counted> ok{in_place_ok, 5};
+        const Result<Counted, Counted> err{in_place_err, 6};
+        Counted::reset();
+
+        REQUIRE(assign_borrowed(ok).result() == 5);
+        REQUIRE(assign_borrowed(err).error().value == 6);
+        REQUIRE(Counted::copies == 2);
+        REQUIRE(Counted::moves == 0);
+        REQUIRE(ok.result().value == 5);
+    }
+    SECTION("Move only results and void results") {
+        REQUIRE(assign_chain(true, true).result() == 4);
+        REQUIRE(assign_chain(false, true).error() == "allocate");
+        REQUIRE(assign_chain(true, false).error() == "check");
+    }
+    SECTION("Errors are converted") {
+        REQUIRE(assign_converted(true).result() == 3);
+        REQUIRE(assign_converted(false).error() == std::string{"converted"});
+    }
+}
+
+#if COGLE_HAS_TRY_EXPRESSION
+Result<int, Counted> try_counted(bool ok) {
+    Counted counted = COGLE_TRY(make(ok));
+    return Ok{counted.value};
+}
+
+Result<int, std::string> try_chain(bool allocated, bool checked) {
+    auto value = COGLE_TRY(allocate(allocated));
+    COGLE_TRY(check(checked));
+    return Ok{*value + COGLE_TRY(Result<int, std::string>{Ok{COGLE_TRY(Result<int, std::string>{Ok{1}})}})};
+}
+
+TEST_CASE("Try Expression", "[try]") {
+    SECTION("Ok moves the result out once") {
+        Counted::reset();
+        REQUIRE(try_counted(true).result() == 1);
+        REQUIRE(Counted::moves == 1);
+        REQUIRE(Counted::copies == 0);
+    }
+    SECTION("Err moves the error out once") {
+        Counted::reset();
+        REQUIRE(try_counted(false).error().value == 2);
+        REQUIRE(Counted::moves == 1);
+        REQUIRE(Counted::copies == 0);
+    }
+    SECTION("Move only results, void results and nesting") {
+        REQUIRE(try_chain(true, true).result() == 5);
+        REQUIRE(try_chain(false, true).error() == "allocate");
+        REQUIRE(try_chain(true, false).error() == "check");
+    }
+}
+#endif
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <utils/flight_recorder.hxx>
+#include <utils/result.hxx>
+
+// Prints the contents of a flight recorder file, see recorder::FlightRecorder, e.g. the one left behind by a process
+// that died in abort::abort.
+
+using namespace cogle::utils::result;
+namespace recorder = cogle::utils::recorder;
+
+namespace main_return_codes {
+constexpr auto SUCCESS = 0;
+constexpr auto FAILURE = -1;
+}  // namespace main_return_codes
+
+namespace {
+
+struct Mapping {
+    const void* base;
+    std::size_t size;
+};
+
+Result<Mapping, int> map_file(const std::string_view path) {
+    const int fd = open(path.data(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        const auto err = errno;
+        return Err<int>{err};
+    }
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        const auto err = errno;
+        close(fd);
+        return Err<int>{err};
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void* base      = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    const auto err  = errno;
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        return Err<int>{err};
+    }
+
+    return Ok<Mapping>{Mapping{base, size}};
+}
+
+const char* kind_name(const recorder::EntryKind kind) {
+    switch (kind) {
+        case recorder::EntryKind::ERR:
+            return "ERR";
+        case recorder::EntryKind::ASSERT:
+            return "ASSERT";
+    }
+    return "UNKNOWN";
+}
+
+const char* timestamp_unit(const recorder::TimestampSource source) {
+    return source == recorder::TimestampSource::TSC ? "ticks" : "ns";
+}
+
+void print_entry(const recorder::FileHeader& header, const recorder::Entry& entry) {
+    std::cout << "  +" << (entry.timestamp - header.open_timestamp) << " " << timestamp_unit(header.timestamp_source)
+              << "\t" << kind_name(entry.kind) << "\t" << entry.file << ":" << entry.line << ":" << entry.column
+              << "\t" << entry.function;
+
+    const std::size_t payload_size =
+        entry.payload_size < recorder::PAYLOAD_CAPACITY ? entry.payload_size : recorder::PAYLOAD_CAPACITY;
+
+    if (entry.kind == recorder::EntryKind::ASSERT) {
+        std::cout << "\tmessage: "
+                  << std::string_view{reinterpret_cast<const char*>(entry.payload), payload_size};
+    } else if (entry.error_size != 0) {
+        std::cout << "\terror(" << entry.error_size << " bytes): " << std::hex << std::setfill('0');
+        for (std::size_t i = 0; i < payload_size; ++i) {
+            std::cout << std::setw(2) << static_cast<unsigned>(entry.payload[i]);
+        }
+        std::cout << std::dec << std::setfill(' ');
+    }
+
+    std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char const* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <flight recorder file>" << std::endl;
+        return main_return_codes::FAILURE;
+    }
+
+    auto mapping_ret = map_file(argv[1]);
+    if (!mapping_ret) {
+        const auto& ec = mapping_ret.error();
+        std::cerr << "Attempting to map " << argv[1] << " failed with error " << strerror(ec) << "(" << ec << ")"
+                  << std::endl;
+        return main_return_codes::FAILURE;
+    }
+
+    const auto& mapping = mapping_ret.result();
+    const recorder::RecordingView view{mapping.base, mapping.size};
+
+    if (!view.valid()) {
+        std::cerr << argv[1] << " is not a flight recorder file of version " << recorder::VERSION << std::endl;
+        return main_return_codes::FAILURE;
+    }
+
+    const auto& header = view.header();
+    std::cout << "Capacity: " << header.capacity << "\tThreads: " << view.ring_count() << "/" << header.max_threads
+              << "\tOpened: " << header.open_realtime_ns << " ns since epoch" << std::endl;
+
+    for (std::uint32_t i = 0; i < view.ring_count(); ++i) {
+        const auto& ring = view.ring(i);
+        std::cout << "Thread " << ring.thread_id << "\tRecorded: " << ring.head.load() << std::endl;
+        view.for_each_entry(i, [&header](const recorder::Entry& entry) { print_entry(header, entry); });
+    }
+
+    munmap(const_cast<void*>(mapping.base), mapping.size);
+    return main_return_codes::SUCCESS;
+}
\ No newline at end of file